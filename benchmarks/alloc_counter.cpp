@@ -0,0 +1,71 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#include "alloc_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+thread_local extenser::bench::alloc_stats t_stats{};
+
+auto counted_alloc(const std::size_t size) -> void*
+{
+    ++t_stats.count;
+    t_stats.bytes += size;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr)
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+} //namespace
+
+namespace extenser::bench
+{
+auto thread_alloc_stats() noexcept -> alloc_stats
+{
+    return t_stats;
+}
+} //namespace extenser::bench
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+auto operator new(std::size_t size) -> void*
+{
+    return counted_alloc(size);
+}
+
+auto operator new[](std::size_t size) -> void*
+{
+    return counted_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, [[maybe_unused]] std::size_t size) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, [[maybe_unused]] std::size_t size) noexcept
+{
+    std::free(ptr);
+}
+// NOLINTEND(cppcoreguidelines-no-malloc, hicpp-no-malloc)
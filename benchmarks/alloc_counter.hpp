@@ -0,0 +1,27 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_BENCH_ALLOC_COUNTER_HPP
+#define EXTENSER_BENCH_ALLOC_COUNTER_HPP
+
+#include <cstddef>
+
+namespace extenser::bench
+{
+struct alloc_stats
+{
+    std::size_t count{};
+    std::size_t bytes{};
+};
+
+// Totals for the calling thread since program start, fed by the global operator new replacement
+// in alloc_counter.cpp
+auto thread_alloc_stats() noexcept -> alloc_stats;
+} //namespace extenser::bench
+#endif //EXTENSER_BENCH_ALLOC_COUNTER_HPP
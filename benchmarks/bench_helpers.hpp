@@ -0,0 +1,390 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_BENCH_HELPERS_HPP
+#define EXTENSER_BENCH_HELPERS_HPP
+
+#include "alloc_counter.hpp"
+#include "extenser/parallel.hpp"
+#include "test_helpers.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace extenser::bench
+{
+using tests::Fruit;
+using tests::Person;
+using tests::Pet;
+
+// Specialized by each adapter's benchmark TU to report the encoded size of a serial object
+template<typename Adapter>
+struct serial_traits;
+
+struct Message
+{
+    using body_t =
+        std::variant<std::monostate, std::int64_t, double, std::string, std::vector<int>, Pet>;
+
+    std::uint64_t id{};
+    std::uint32_t flags{};
+    body_t body{};
+
+    template<typename S>
+    void serialize(generic_serializer<S>& ser)
+    {
+        ser.as_uint("id", id);
+        ser.as_uint("flags", flags);
+        ser.as_variant("body", body);
+    }
+};
+
+inline constexpr auto wide_row_keys = make_field_keys("i00", "i01", "i02", "i03", "i04", "i05",
+    "i06", "i07", "i08", "i09", "i10", "i11", "i12", "i13", "i14", "i15", "r00", "r01", "r02",
+    "r03", "r04", "r05", "r06", "r07", "r08", "r09", "r10", "r11", "r12", "r13", "r14", "r15");
+
+// A flat record with 32 fields, deserialized with or without its field_keys declared
+template<bool DeclareKeys>
+struct WideRow
+{
+    static constexpr std::size_t half = wide_row_keys.size() / 2;
+
+    std::array<std::int64_t, half> ints{};
+    std::array<double, half> reals{};
+
+    template<typename S>
+    void serialize(generic_serializer<S>& ser)
+    {
+        for (std::size_t i = 0; i < half; ++i)
+        {
+            ser.as_int(wide_row_keys[i], ints[i]);
+            ser.as_float(wide_row_keys[half + i], reals[i]);
+        }
+    }
+};
+} //namespace extenser::bench
+
+template<>
+struct extenser::field_keys<extenser::bench::WideRow<true>>
+{
+    static constexpr auto value = bench::wide_row_keys;
+};
+
+namespace extenser::bench
+{
+// A root person with `count` friends, each carrying a pet, fruit counts and two friends of
+// their own
+struct person_graph
+{
+    using value_type = Person;
+
+    static auto make(const std::size_t count) -> Person
+    {
+        Person root{ 40, "Root Person", {}, Pet{ "Rex", Pet::Species::Dog },
+            { { Fruit::Apple, 3 }, { Fruit::Kiwi, 1 } } };
+
+        root.friends.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto age = static_cast<int>(18 + (i % 60));
+
+            Person person{ age, "Friend #" + std::to_string(i), {},
+                (i % 2 == 0) ? std::optional<Pet>{ Pet{ "Pet #" + std::to_string(i),
+                                   static_cast<Pet::Species>(i % 6) } }
+                             : std::nullopt,
+                { { Fruit::Banana, age }, { Fruit::Grape, age * 2 }, { Fruit::Mango, 1 } } };
+
+            person.friends.push_back(
+                Person{ age + 1, "Nested A", {}, {}, { { Fruit::Orange, 2 } } });
+            person.friends.push_back(Person{ age + 2, "Nested B", {}, {}, {} });
+            root.friends.push_back(std::move(person));
+        }
+
+        return root;
+    }
+};
+
+// A person whose only friend has a friend of their own, `depth` levels down, so each level
+// is one more nested object
+struct friend_chain
+{
+    using value_type = Person;
+
+    static auto make(const std::size_t depth) -> Person
+    {
+        Person root{ 20, "Level 0", {}, {}, { { Fruit::Apple, 1 } } };
+        Person* p_level = &root;
+
+        for (std::size_t i = 1; i < depth; ++i)
+        {
+            p_level->friends.push_back(Person{ static_cast<int>(20 + (i % 60)),
+                "Level " + std::to_string(i), {}, {}, { { Fruit::Apple, 1 } } });
+            p_level = &p_level->friends.back();
+        }
+
+        return root;
+    }
+};
+
+struct large_vector
+{
+    using value_type = std::vector<double>;
+
+    static auto make(const std::size_t count) -> std::vector<double>
+    {
+        std::vector<double> vec(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            vec[i] = static_cast<double>(i) * 0.333;
+        }
+
+        return vec;
+    }
+};
+
+struct deep_map
+{
+    using value_type = std::map<std::string, std::map<int, std::map<std::string, double>>>;
+
+    static auto make(const std::size_t count) -> value_type
+    {
+        value_type outer{};
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& middle = outer["section_" + std::to_string(i)];
+
+            for (int j = 0; j < 8; ++j)
+            {
+                auto& inner = middle[j * 100];
+
+                for (int k = 0; k < 4; ++k)
+                {
+                    inner["metric_" + std::to_string(k)] = static_cast<double>(j * k) * 1.5;
+                }
+            }
+        }
+
+        return outer;
+    }
+};
+
+struct variant_messages
+{
+    using value_type = std::vector<Message>;
+
+    static auto make(const std::size_t count) -> std::vector<Message>
+    {
+        std::vector<Message> messages(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& msg = messages[i];
+            msg.id = i;
+            msg.flags = static_cast<std::uint32_t>(i * 7U);
+
+            switch (i % 6)
+            {
+                case 0:
+                    msg.body = std::monostate{};
+                    break;
+
+                case 1:
+                    msg.body = static_cast<std::int64_t>(i) * -1024;
+                    break;
+
+                case 2:
+                    msg.body = static_cast<double>(i) / 3.0;
+                    break;
+
+                case 3:
+                    msg.body = "message body " + std::to_string(i);
+                    break;
+
+                case 4:
+                    msg.body = std::vector<int>{ 1, 2, 3, static_cast<int>(i) };
+                    break;
+
+                default:
+                    msg.body = Pet{ "Pet #" + std::to_string(i), Pet::Species::Cat };
+                    break;
+            }
+        }
+
+        return messages;
+    }
+};
+
+template<bool DeclareKeys>
+struct wide_rows
+{
+    using value_type = std::vector<WideRow<DeclareKeys>>;
+
+    static auto make(const std::size_t count) -> value_type
+    {
+        value_type rows(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t j = 0; j < WideRow<DeclareKeys>::half; ++j)
+            {
+                rows[i].ints[j] = static_cast<std::int64_t>(i * j);
+                rows[i].reals[j] = static_cast<double>(i + j) * 0.25;
+            }
+        }
+
+        return rows;
+    }
+};
+
+inline void set_counters(benchmark::State& state, const alloc_stats& before,
+    const alloc_stats& after, const std::size_t serial_bytes)
+{
+    state.counters["bytes/op"] = benchmark::Counter(static_cast<double>(serial_bytes));
+    state.counters["allocs/op"] = benchmark::Counter(
+        static_cast<double>(after.count - before.count), benchmark::Counter::kAvgIterations);
+    state.counters["alloc_bytes/op"] = benchmark::Counter(
+        static_cast<double>(after.bytes - before.bytes), benchmark::Counter::kAvgIterations);
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(serial_bytes));
+}
+
+template<typename Adapter, typename Payload>
+void bm_serialize(benchmark::State& state)
+{
+    const auto val = Payload::make(static_cast<std::size_t>(state.range(0)));
+    const auto serial_bytes =
+        serial_traits<Adapter>::size(easy_serializer<Adapter>::quick_serialize(val));
+
+    const auto before = thread_alloc_stats();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto serial = easy_serializer<Adapter>::quick_serialize(val);
+        benchmark::DoNotOptimize(serial);
+    }
+
+    set_counters(state, before, thread_alloc_stats(), serial_bytes);
+}
+
+// Serializes into one caller-owned buffer, as a send path reusing pooled buffers would
+template<typename Adapter, typename Payload>
+void bm_serialize_reuse(benchmark::State& state)
+{
+    const auto val = Payload::make(static_cast<std::size_t>(state.range(0)));
+    typename Adapter::serial_t buffer{};
+
+    {
+        typename Adapter::serializer_t ser{ std::ref(buffer) };
+        ser.serialize_object(val);
+        std::ignore = ser.object();
+    }
+
+    const auto serial_bytes = serial_traits<Adapter>::size(buffer);
+    const auto before = thread_alloc_stats();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        typename Adapter::serializer_t ser{ std::ref(buffer) };
+        ser.serialize_object(val);
+        benchmark::DoNotOptimize(ser.object());
+    }
+
+    set_counters(state, before, thread_alloc_stats(), serial_bytes);
+}
+
+// Splits the payload between range(1) threads, allocations are only counted on the calling
+// thread
+template<typename Adapter, typename Payload>
+void bm_serialize_parallel(benchmark::State& state)
+{
+    const auto val = Payload::make(static_cast<std::size_t>(state.range(0)));
+    const parallel_options options{ static_cast<std::size_t>(state.range(1)), 256 };
+    const auto serial_bytes =
+        serial_traits<Adapter>::size(serialize_parallel<Adapter>(val, options));
+    const auto before = thread_alloc_stats();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto serial = serialize_parallel<Adapter>(val, options);
+        benchmark::DoNotOptimize(serial);
+    }
+
+    set_counters(state, before, thread_alloc_stats(), serial_bytes);
+}
+
+template<typename Adapter, typename Payload>
+void bm_serialized_size(benchmark::State& state)
+{
+    const auto val = Payload::make(static_cast<std::size_t>(state.range(0)));
+    const auto serial_bytes = serialized_size<Adapter>(val);
+    const auto before = thread_alloc_stats();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto size = serialized_size<Adapter>(val);
+        benchmark::DoNotOptimize(size);
+    }
+
+    set_counters(state, before, thread_alloc_stats(), serial_bytes);
+}
+
+template<typename Adapter, typename Payload>
+void bm_deserialize(benchmark::State& state)
+{
+    const auto serial = easy_serializer<Adapter>::quick_serialize(
+        Payload::make(static_cast<std::size_t>(state.range(0))));
+
+    const auto serial_bytes = serial_traits<Adapter>::size(serial);
+    const auto before = thread_alloc_stats();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        typename Payload::value_type val{};
+        easy_serializer<Adapter>::quick_deserialize(serial, val);
+        benchmark::DoNotOptimize(val);
+    }
+
+    set_counters(state, before, thread_alloc_stats(), serial_bytes);
+}
+
+// Splits the payload between range(1) threads, allocations are only counted on the calling
+// thread
+template<typename Adapter, typename Payload>
+void bm_deserialize_parallel(benchmark::State& state)
+{
+    const auto serial = easy_serializer<Adapter>::quick_serialize(
+        Payload::make(static_cast<std::size_t>(state.range(0))));
+
+    const parallel_options options{ static_cast<std::size_t>(state.range(1)), 256 };
+    const auto serial_bytes = serial_traits<Adapter>::size(serial);
+    const auto before = thread_alloc_stats();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        typename Payload::value_type val{};
+        deserialize_parallel<Adapter>(serial, val, options);
+        benchmark::DoNotOptimize(val);
+    }
+
+    set_counters(state, before, thread_alloc_stats(), serial_bytes);
+}
+} //namespace extenser::bench
+#endif //EXTENSER_BENCH_HELPERS_HPP
@@ -0,0 +1,44 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#include "bench_helpers.hpp"
+#include "extenser_bitsery.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace extenser::bench
+{
+template<>
+struct serial_traits<bitsery_adapter>
+{
+    static auto size(const std::vector<std::uint8_t>& bytes) -> std::size_t
+    {
+        return bytes.size();
+    }
+};
+
+// NOTE: container sizes are kept within bitsery_config::max_container_size
+BENCHMARK_TEMPLATE(bm_serialize, bitsery_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_deserialize, bitsery_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_serialize_reuse, bitsery_adapter, person_graph)->Arg(8)->Arg(64);
+
+BENCHMARK_TEMPLATE(bm_serialize, bitsery_adapter, large_vector)->Arg(256)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(bm_deserialize, bitsery_adapter, large_vector)->Arg(256)->Arg(1 << 17);
+
+BENCHMARK_TEMPLATE(bm_serialize, bitsery_adapter, deep_map)->Arg(16)->Arg(128);
+BENCHMARK_TEMPLATE(bm_deserialize, bitsery_adapter, deep_map)->Arg(16)->Arg(128);
+
+BENCHMARK_TEMPLATE(bm_serialize, bitsery_adapter, variant_messages)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(bm_deserialize, bitsery_adapter, variant_messages)->Arg(64)->Arg(256);
+
+BENCHMARK_TEMPLATE(bm_serialized_size, bitsery_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_serialized_size, bitsery_adapter, variant_messages)->Arg(64)->Arg(256);
+} //namespace extenser::bench
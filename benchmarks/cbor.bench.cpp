@@ -0,0 +1,40 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#include "extenser/cbor_adapter/extenser_cbor.hpp"
+#include "bench_helpers.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace extenser::bench
+{
+template<>
+struct serial_traits<cbor_adapter>
+{
+    static auto size(const std::vector<std::uint8_t>& bytes) -> std::size_t
+    {
+        return bytes.size();
+    }
+};
+
+BENCHMARK_TEMPLATE(bm_serialize, cbor_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_deserialize, cbor_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_serialize_reuse, cbor_adapter, person_graph)->Arg(8)->Arg(64);
+
+BENCHMARK_TEMPLATE(bm_serialize, cbor_adapter, large_vector)->Arg(256)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(bm_deserialize, cbor_adapter, large_vector)->Arg(256)->Arg(1 << 17);
+
+BENCHMARK_TEMPLATE(bm_serialize, cbor_adapter, deep_map)->Arg(16)->Arg(128);
+BENCHMARK_TEMPLATE(bm_deserialize, cbor_adapter, deep_map)->Arg(16)->Arg(128);
+
+BENCHMARK_TEMPLATE(bm_serialize, cbor_adapter, variant_messages)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(bm_deserialize, cbor_adapter, variant_messages)->Arg(64)->Arg(256);
+} //namespace extenser::bench
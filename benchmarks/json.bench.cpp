@@ -0,0 +1,70 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#include "extenser/json_adapter/extenser_json.hpp"
+#include "extenser/json_adapter/extenser_json_text.hpp"
+#include "bench_helpers.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace extenser::bench
+{
+template<>
+struct serial_traits<json_adapter>
+{
+    static auto size(const nlohmann::json& obj) -> std::size_t { return obj.dump().size(); }
+};
+
+template<>
+struct serial_traits<json_text_adapter>
+{
+    static auto size(const std::string& text) -> std::size_t { return text.size(); }
+};
+
+BENCHMARK_TEMPLATE(bm_serialize, json_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_deserialize, json_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_deserialize, json_adapter, friend_chain)->Arg(16)->Arg(256);
+
+BENCHMARK_TEMPLATE(bm_serialize, json_adapter, large_vector)->Arg(256)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(bm_deserialize, json_adapter, large_vector)->Arg(256)->Arg(1 << 17);
+
+BENCHMARK_TEMPLATE(bm_serialize, json_adapter, deep_map)->Arg(16)->Arg(128);
+BENCHMARK_TEMPLATE(bm_deserialize, json_adapter, deep_map)->Arg(16)->Arg(128);
+
+BENCHMARK_TEMPLATE(bm_serialize, json_adapter, variant_messages)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(bm_deserialize, json_adapter, variant_messages)->Arg(64)->Arg(256);
+
+BENCHMARK_TEMPLATE(bm_deserialize, json_adapter, wide_rows<false>)->Arg(256);
+BENCHMARK_TEMPLATE(bm_deserialize, json_adapter, wide_rows<true>)->Arg(256);
+
+BENCHMARK_TEMPLATE(bm_serialize_parallel, json_adapter, wide_rows<true>)
+    ->Args({ 1 << 14, 1 })
+    ->Args({ 1 << 14, 4 });
+BENCHMARK_TEMPLATE(bm_deserialize_parallel, json_adapter, wide_rows<true>)
+    ->Args({ 1 << 14, 1 })
+    ->Args({ 1 << 14, 4 });
+
+BENCHMARK_TEMPLATE(bm_serialize, json_text_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_deserialize, json_text_adapter, person_graph)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(bm_serialize_reuse, json_text_adapter, person_graph)->Arg(8)->Arg(64);
+
+BENCHMARK_TEMPLATE(bm_serialize, json_text_adapter, large_vector)->Arg(256)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(bm_deserialize, json_text_adapter, large_vector)->Arg(256)->Arg(1 << 17);
+
+BENCHMARK_TEMPLATE(bm_serialize, json_text_adapter, deep_map)->Arg(16)->Arg(128);
+BENCHMARK_TEMPLATE(bm_deserialize, json_text_adapter, deep_map)->Arg(16)->Arg(128);
+
+BENCHMARK_TEMPLATE(bm_serialize, json_text_adapter, variant_messages)->Arg(64)->Arg(256);
+BENCHMARK_TEMPLATE(bm_deserialize, json_text_adapter, variant_messages)->Arg(64)->Arg(256);
+
+BENCHMARK_TEMPLATE(bm_serialize_parallel, json_text_adapter, wide_rows<true>)
+    ->Args({ 1 << 14, 1 })
+    ->Args({ 1 << 14, 4 });
+} //namespace extenser::bench
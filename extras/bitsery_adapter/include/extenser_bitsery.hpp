@@ -14,6 +14,8 @@
 
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
+#include <bitsery/adapter/measure_size.h>
+#include <bitsery/details/serialization_common.h>
 #include <bitsery/ext/std_map.h>
 #include <bitsery/ext/std_optional.h>
 #include <bitsery/ext/std_set.h>
@@ -26,8 +28,11 @@
 #include <bitsery/traits/string.h>
 #include <bitsery/traits/vector.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iterator>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -37,8 +42,146 @@
 #include <variant>
 #include <vector>
 
+namespace extenser::detail_bitsery
+{
+// Output target for the serializer: either a growable vector (owned or the caller's) or a
+// fixed-capacity span, which throws instead of reallocating when it runs out of room
+class output_buffer
+{
+public:
+    using value_type = std::uint8_t;
+
+    explicit output_buffer(std::vector<std::uint8_t>& bytes) noexcept
+        : m_p_bytes(&bytes), m_p_data(bytes.data()), m_size(bytes.size())
+    {
+    }
+
+    explicit output_buffer(const span<std::uint8_t> bytes) noexcept
+        : m_p_data(bytes.data()), m_size(bytes.size())
+    {
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> std::uint8_t* { return m_p_data; }
+    [[nodiscard]] auto end() const noexcept -> std::uint8_t* { return m_p_data + m_size; }
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+    [[nodiscard]] auto is_fixed() const noexcept -> bool { return m_p_bytes == nullptr; }
+
+    void grow(const std::size_t min_size)
+    {
+        if (m_p_bytes == nullptr)
+        {
+            EXTENSER_THROW(serialization_error{
+                std::string{ "bitsery error: output buffer overflow, " }
+                    .append(std::to_string(min_size))
+                    .append(" bytes needed, capacity is ")
+                    .append(std::to_string(m_size)) });
+        }
+
+        // Same growth policy as bitsery's std::vector traits, but never shrinking below capacity
+        m_p_bytes->resize(std::max({ min_size, m_size + m_size / 2 + 128, m_p_bytes->capacity() }));
+        m_p_data = m_p_bytes->data();
+        m_size = m_p_bytes->size();
+    }
+
+private:
+    std::vector<std::uint8_t>* m_p_bytes{ nullptr };
+    std::uint8_t* m_p_data;
+    std::size_t m_size;
+};
+
+// Input source for the deserializer: either the caller's vector, which may be refilled between
+// calls to deserialize_object(), or a fixed span of bytes (a mapped_file, ...) read in place
+class input_buffer
+{
+public:
+    using value_type = std::uint8_t;
+
+    explicit input_buffer(const std::vector<std::uint8_t>& bytes) noexcept
+        : m_p_bytes(&bytes), m_p_data(bytes.data()), m_size(bytes.size())
+    {
+    }
+
+    explicit input_buffer(const view<std::uint8_t> bytes) noexcept
+        : m_p_data(bytes.data()), m_size(bytes.size())
+    {
+    }
+
+    [[nodiscard]] auto data() const noexcept -> const std::uint8_t* { return m_p_data; }
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+    // Picks up a change to the caller's vector, returning whether there was one
+    auto refresh() noexcept -> bool
+    {
+        if (m_p_bytes == nullptr
+            || (m_p_bytes->data() == m_p_data && m_p_bytes->size() == m_size))
+        {
+            return false;
+        }
+
+        m_p_data = m_p_bytes->data();
+        m_size = m_p_bytes->size();
+        return true;
+    }
+
+private:
+    const std::vector<std::uint8_t>* m_p_bytes{ nullptr };
+    const std::uint8_t* m_p_data;
+    std::size_t m_size;
+};
+} //namespace extenser::detail_bitsery
+
 namespace bitsery::traits
 {
+template<>
+struct ContainerTraits<extenser::detail_bitsery::output_buffer>
+{
+    using TValue = std::uint8_t;
+
+    static constexpr bool isResizable = true;
+    static constexpr bool isContiguous = true;
+
+    static size_t size(const extenser::detail_bitsery::output_buffer& buffer)
+    {
+        return buffer.size();
+    }
+};
+
+template<>
+struct BufferAdapterTraits<extenser::detail_bitsery::output_buffer>
+{
+    using TIterator = std::uint8_t*;
+    using TConstIterator = const std::uint8_t*;
+    using TValue = std::uint8_t;
+
+    static void increaseBufferSize(extenser::detail_bitsery::output_buffer& buffer,
+        [[maybe_unused]] size_t curr_size, size_t min_size)
+    {
+        buffer.grow(min_size);
+    }
+};
+
+template<>
+struct ContainerTraits<extenser::detail_bitsery::input_buffer>
+{
+    using TValue = std::uint8_t;
+
+    static constexpr bool isResizable = false;
+    static constexpr bool isContiguous = true;
+
+    static size_t size(const extenser::detail_bitsery::input_buffer& buffer)
+    {
+        return buffer.size();
+    }
+};
+
+template<>
+struct BufferAdapterTraits<extenser::detail_bitsery::input_buffer>
+{
+    using TIterator = const std::uint8_t*;
+    using TConstIterator = const std::uint8_t*;
+    using TValue = std::uint8_t;
+};
+
 template<typename CharT, typename Traits>
 struct ContainerTraits<std::basic_string_view<CharT, Traits>> :
     StdContainer<std::basic_string_view<CharT, Traits>, false, true>
@@ -71,42 +214,221 @@ namespace extenser
 {
 namespace detail_bitsery
 {
-    class serializer;
+    // Limits on the size prefix of every string and container. Exceeding one when serializing
+    // throws, the deserializer rejects any input that claims to exceed one. bitsery encodes sizes
+    // in 1, 2 or 4 bytes depending on their value, up to a maximum of max_size_prefix
+    struct default_config
+    {
+        static constexpr std::size_t max_string_size = 1U << 20U;
+        static constexpr std::size_t max_container_size = 1U << 20U;
+    };
+
+    inline constexpr std::size_t max_size_prefix = (1U << 30U) - 1U;
+
+    template<typename Config, typename OutputAdapter>
+    class basic_serializer;
+
+    template<typename Config>
     class deserializer;
 
+    template<typename Config>
+    using serializer = basic_serializer<Config, bitsery::OutputBufferAdapter<output_buffer>>;
+
+    // span<const T> over arithmetic T can be deserialized as a view into the input buffer, so
+    // unlike other spans it is written with a size prefix
+    template<typename T>
+    struct is_borrowed_span : std::false_type
+    {
+    };
+
+#if defined(__cpp_lib_span)
+    template<typename T>
+    struct is_borrowed_span<std::span<const T>> : std::is_arithmetic<T>
+    {
+    };
+#else
+    template<typename T>
+    struct is_borrowed_span<span<const T>> : std::is_arithmetic<T>
+    {
+    };
+#endif
+
+    template<typename T>
+    inline constexpr bool is_borrowed_span_v = is_borrowed_span<T>::value;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    inline constexpr bool is_little_endian_host = false;
+#else
+    inline constexpr bool is_little_endian_host = true;
+#endif
+
+    // bitsery already copies contiguous arithmetic containers as a block, but writes enums one at
+    // a time. On a little-endian host their in-memory bytes are the same as bitsery's encoding, so
+    // contiguous containers of enums are copied as a block too
+    template<typename T>
+    inline constexpr bool use_bulk_copy_v = is_little_endian_host
+        && containers::is_bulk_copyable_v<T>
+        && std::is_enum_v<typename containers::traits<T>::value_type>;
+
+    template<typename T>
+    struct is_string_view : std::false_type
+    {
+    };
+
+    template<typename CharT, typename Traits>
+    struct is_string_view<std::basic_string_view<CharT, Traits>> : std::true_type
+    {
+    };
+
+    // Runs the same encoding as serializer, but only counts the bytes it would write
+    template<typename Config>
+    using size_counter = basic_serializer<Config, bitsery::MeasureSize>;
+
+    template<typename Config>
     struct serial_adapter
     {
+        static_assert(Config::max_string_size <= max_size_prefix,
+            "max_string_size is larger than bitsery can encode");
+        static_assert(Config::max_container_size <= max_size_prefix,
+            "max_container_size is larger than bitsery can encode");
+
         using bytes_t = std::vector<std::uint8_t>;
         using serial_t = std::vector<std::uint8_t>;
-        using serializer_t = serializer;
-        using deserializer_t = deserializer;
-
-        struct config
-        {
-            static const std::size_t max_string_size = 256;
-            static const std::size_t max_container_size = 256;
-        };
+        using serializer_t = serializer<Config>;
+        using deserializer_t = deserializer<Config>;
+        using size_counter_t = size_counter<Config>;
+        using config = Config;
 
         template<typename S, typename T, typename Adapter, bool Deserialize>
         static void parse_obj(
             S& ser, detail::serializer_base<Adapter, Deserialize>& fallback, T& val);
+
+        // bitsery only asserts that a size is within its limit when serializing
+        static void check_size(const std::size_t size, const std::size_t max_size)
+        {
+            if (size > max_size)
+            {
+                EXTENSER_THROW(serialization_error{ std::string{ "bitsery error: size " }
+                        .append(std::to_string(size))
+                        .append(" is over the configured limit of ")
+                        .append(std::to_string(max_size)) });
+            }
+        }
     };
 
-    class serializer : public detail::serializer_base<serial_adapter, false>
+    // serializer_base dispatches through Adapter::serializer_t, so the size counter needs an
+    // adapter of its own
+    template<typename Config>
+    struct size_counter_adapter : serial_adapter<Config>
+    {
+        using serializer_t = size_counter<Config>;
+    };
+
+    template<typename Config, typename OutputAdapter>
+    class basic_serializer :
+        public detail::serializer_base<
+            std::conditional_t<std::is_same_v<OutputAdapter, bitsery::MeasureSize>,
+                size_counter_adapter<Config>, serial_adapter<Config>>,
+            false>
     {
     public:
-        serializer() : m_ser(m_bytes) { m_bytes.reserve(64UL); }
+        static constexpr bool is_size_counter = std::is_same_v<OutputAdapter, bitsery::MeasureSize>;
+
+        basic_serializer() : m_buffer(m_bytes), m_ser(make_ser(m_buffer)) {}
 
+        // Writes into the caller's vector, reusing its capacity, object() then refers to it
+        explicit basic_serializer(const std::reference_wrapper<std::vector<std::uint8_t>> out)
+            : m_p_bytes(&out.get()), m_buffer(out.get()), m_ser(make_ser(m_buffer))
+        {
+        }
+
+        // Writes into a fixed-capacity buffer, throwing serialization_error if it would overflow.
+        // There is no object() in this mode, size() reports the number of bytes written
+        explicit basic_serializer(const span<std::uint8_t> out)
+            : m_p_bytes(nullptr), m_buffer(out), m_ser(make_ser(m_buffer))
+        {
+        }
+
+        // m_p_bytes, m_buffer and m_ser refer to this object's own members, which a copy or move
+        // would leave pointing into the original
+        basic_serializer(const basic_serializer&) = delete;
+        basic_serializer(basic_serializer&&) = delete;
+        auto operator=(const basic_serializer&) -> basic_serializer& = delete;
+        auto operator=(basic_serializer&&) -> basic_serializer& = delete;
+        ~basic_serializer() noexcept = default;
+
+        template<bool Enabled = !is_size_counter, std::enable_if_t<Enabled, bool> = true>
         [[nodiscard]] auto object() & -> const std::vector<std::uint8_t>&
         {
+            EXTENSER_PRECONDITION(m_p_bytes != nullptr);
+
             flush();
-            return m_bytes;
+            return *m_p_bytes;
         }
 
+        template<bool Enabled = !is_size_counter, std::enable_if_t<Enabled, bool> = true>
         [[nodiscard]] auto object() && -> std::vector<std::uint8_t>&&
         {
+            EXTENSER_PRECONDITION(m_p_bytes != nullptr);
+
             flush();
-            return std::move(m_bytes);
+            return std::move(*m_p_bytes);
+        }
+
+        // Used by serialize_parallel() and serialize_to(): each chunk of a split array is written
+        // as just its elements, then splice_array() puts the size prefix (if any) in front of the
+        // chunks (serialize_to() writes serialize_array_head(), the chunks and
+        // serialize_array_tail(), each from a new serializer)
+        template<typename It>
+        void serialize_elements(It first, const It last)
+        {
+            using S = bitsery::Serializer<output_adapter>;
+            using value_t = typename std::iterator_traits<It>::value_type;
+
+            for (; first != last; ++first)
+            {
+                m_ser.object(*first,
+                    [this](S& ser, value_t& value) { adapter_t::parse_obj(ser, *this, value); });
+            }
+        }
+
+        template<typename T>
+        void splice_array(const T& val, std::vector<std::vector<std::uint8_t>>& chunks)
+        {
+            serialize_array_head(val);
+
+            for (const auto& chunk : chunks)
+            {
+                if (!chunk.empty())
+                {
+                    m_ser.adapter().template writeBuffer<1>(chunk.data(), chunk.size());
+                }
+            }
+        }
+
+        template<typename T>
+        void serialize_array_head([[maybe_unused]] const T& val)
+        {
+            if constexpr (!containers::traits<T>::has_fixed_size)
+            {
+                const auto size = containers::adapter<T>::size(val);
+                adapter_t::check_size(size, config::max_container_size);
+                bitsery::details::writeSize(m_ser.adapter(), size);
+            }
+        }
+
+        // The array's size is in its prefix (or its type), so nothing marks its end
+        void serialize_array_tail() noexcept {}
+
+        [[nodiscard]] static constexpr auto element_separator() noexcept -> std::string_view
+        {
+            return {};
+        }
+
+        // Number of bytes written (or, for size_counter, that would have been written) so far
+        [[nodiscard]] auto size() -> std::size_t
+        {
+            return m_ser.adapter().writtenBytesCount();
         }
 
         template<typename T>
@@ -119,26 +441,26 @@ namespace detail_bitsery
         void as_float([[maybe_unused]] const std::string_view key, const T& val)
         {
             static_assert(sizeof(T) <= sizeof(double), "long double is not supported");
-            m_ser.value<sizeof(T)>(val);
+            m_ser.template value<sizeof(T)>(val);
         }
 
         template<typename T>
         void as_int([[maybe_unused]] const std::string_view key, const T& val)
         {
-            m_ser.value<sizeof(T)>(val);
+            m_ser.template value<sizeof(T)>(val);
         }
 
         template<typename T>
         void as_uint([[maybe_unused]] const std::string_view key, const T& val)
         {
-            m_ser.value<sizeof(T)>(val);
+            m_ser.template value<sizeof(T)>(val);
         }
 
         template<typename T>
         void as_enum([[maybe_unused]] const std::string_view key, const T val)
         {
             static_assert(std::is_enum_v<T>, "T must be an enum type");
-            m_ser.value<sizeof(T)>(val);
+            m_ser.template value<sizeof(T)>(val);
         }
 
         template<typename T>
@@ -149,11 +471,11 @@ namespace detail_bitsery
             if constexpr (std::is_pointer_v<T>)
             {
                 std::basic_string_view<std::remove_cv_t<std::remove_pointer_t<T>>> tmp{ val };
-                m_ser.text<sizeof(std::remove_pointer_t<T>)>(tmp);
+                m_ser.template text<sizeof(std::remove_pointer_t<T>)>(tmp);
             }
             else if constexpr (std::is_array_v<T>)
             {
-                m_ser.text<sizeof(std::remove_extent_t<T>)>(val);
+                m_ser.template text<sizeof(std::remove_extent_t<T>)>(val);
             }
             else
             {
@@ -161,11 +483,18 @@ namespace detail_bitsery
 
                 if constexpr (traits_t::has_fixed_size)
                 {
-                    m_ser.text<char_sz>(val);
+                    if constexpr (is_string_view<T>::value)
+                    {
+                        adapter_t::check_size(val.size(), config::max_string_size);
+                    }
+
+                    m_ser.template text<char_sz>(val);
                 }
                 else
                 {
-                    m_ser.text<char_sz>(val, config::max_string_size);
+                    adapter_t::check_size(
+                        containers::adapter<T>::size(val), config::max_string_size);
+                    m_ser.template text<char_sz>(val, config::max_string_size);
                 }
             }
         }
@@ -178,40 +507,54 @@ namespace detail_bitsery
             using S = bitsery::Serializer<output_adapter>;
             using traits_t = containers::traits<T>;
 
-            if constexpr (traits_t::is_sequential)
+            if constexpr (use_bulk_copy_v<T>)
+            {
+                write_bulk(val);
+            }
+            else if constexpr (traits_t::is_sequential)
             {
                 if constexpr (traits_t::has_fixed_size)
                 {
-                    if constexpr (std::is_arithmetic_v<typename traits_t::value_type>)
+                    if constexpr (is_borrowed_span_v<T>)
                     {
-                        m_ser.container<sizeof(typename traits_t::value_type)>(val);
+                        adapter_t::check_size(val.size(), config::max_container_size);
+                        bitsery::details::writeSize(m_ser.adapter(), val.size());
+                        m_ser.template container<sizeof(typename traits_t::value_type)>(val);
+                    }
+                    else if constexpr (std::is_arithmetic_v<typename traits_t::value_type>)
+                    {
+                        m_ser.template container<sizeof(typename traits_t::value_type)>(val);
                     }
                     else
                     {
                         m_ser.container(val, [this](S& ser, typename traits_t::value_type& value)
-                            { serial_adapter::parse_obj(ser, *this, value); });
+                            { adapter_t::parse_obj(ser, *this, value); });
                     }
                 }
                 else
                 {
+                    adapter_t::check_size(
+                        containers::adapter<T>::size(val), config::max_container_size);
+
                     if constexpr (std::is_arithmetic_v<typename traits_t::value_type>)
                     {
-                        m_ser.container<sizeof(typename traits_t::value_type)>(
+                        m_ser.template container<sizeof(typename traits_t::value_type)>(
                             val, config::max_container_size);
                     }
                     else
                     {
                         m_ser.container(val, config::max_container_size,
                             [this](S& ser, typename traits_t::value_type& value)
-                            { serial_adapter::parse_obj(ser, *this, value); });
+                            { adapter_t::parse_obj(ser, *this, value); });
                     }
                 }
             }
             else
             {
+                adapter_t::check_size(val.size(), config::max_container_size);
                 m_ser.ext(val, bitsery::ext::StdSet{ config::max_container_size },
                     [this](S& ser, typename traits_t::value_type& value)
-                    { serial_adapter::parse_obj(ser, *this, value); });
+                    { adapter_t::parse_obj(ser, *this, value); });
             }
         }
 
@@ -222,11 +565,12 @@ namespace detail_bitsery
             using key_t = typename T::key_type;
             using val_t = typename T::mapped_type;
 
+            adapter_t::check_size(val.size(), config::max_container_size);
             m_ser.ext(val, bitsery::ext::StdMap{ config::max_container_size },
                 [this](S& ser, key_t& map_key, val_t& map_val)
                 {
-                    serial_adapter::parse_obj(ser, *this, map_key);
-                    serial_adapter::parse_obj(ser, *this, map_val);
+                    adapter_t::parse_obj(ser, *this, map_key);
+                    adapter_t::parse_obj(ser, *this, map_val);
                 });
         }
 
@@ -242,9 +586,9 @@ namespace detail_bitsery
             using S = bitsery::Serializer<output_adapter>;
 
             m_ser.object(val.first,
-                [this](S& ser, T1& value) { serial_adapter::parse_obj(ser, *this, value); });
+                [this](S& ser, T1& value) { adapter_t::parse_obj(ser, *this, value); });
             m_ser.object(val.second,
-                [this](S& ser, T2& value) { serial_adapter::parse_obj(ser, *this, value); });
+                [this](S& ser, T2& value) { adapter_t::parse_obj(ser, *this, value); });
         }
 
         template<typename... Args>
@@ -254,7 +598,7 @@ namespace detail_bitsery
 
             m_ser.ext(val,
                 bitsery::ext::StdTuple{ [this](S& ser, auto& subval)
-                    { serial_adapter::parse_obj(ser, *this, subval); } });
+                    { adapter_t::parse_obj(ser, *this, subval); } });
         }
 
         template<typename T>
@@ -263,18 +607,25 @@ namespace detail_bitsery
             using S = bitsery::Serializer<output_adapter>;
 
             m_ser.ext(val, bitsery::ext::StdOptional{},
-                [this](S& ser, T& subval) { serial_adapter::parse_obj(ser, *this, subval); });
+                [this](S& ser, T& subval) { adapter_t::parse_obj(ser, *this, subval); });
         }
 
         template<typename... Args>
         void as_variant(
             [[maybe_unused]] const std::string_view key, const std::variant<Args...>& val)
         {
-            using S = bitsery::Serializer<output_adapter>;
+            if constexpr (detail::is_tagged_variant_v<std::variant<Args...>>)
+            {
+                adapter_t::parse_obj(m_ser, *this, val);
+            }
+            else
+            {
+                using S = bitsery::Serializer<output_adapter>;
 
-            m_ser.ext(val,
-                bitsery::ext::StdVariant{ [this](S& ser, auto& subval)
-                    { serial_adapter::parse_obj(ser, *this, subval); } });
+                m_ser.ext(val,
+                    bitsery::ext::StdVariant{ [this](S& ser, auto& subval)
+                        { adapter_t::parse_obj(ser, *this, subval); } });
+            }
         }
 
         template<typename T>
@@ -283,7 +634,7 @@ namespace detail_bitsery
             using S = bitsery::Serializer<output_adapter>;
 
             m_ser.object(
-                val, [this](S& ser, T& value) { serial_adapter::parse_obj(ser, *this, value); });
+                val, [this](S& ser, T& value) { adapter_t::parse_obj(ser, *this, value); });
         }
 
         void as_null([[maybe_unused]] const std::string_view key) noexcept
@@ -292,28 +643,106 @@ namespace detail_bitsery
         }
 
     private:
-        using config = serial_adapter::config;
-        using output_adapter = bitsery::OutputBufferAdapter<std::vector<std::uint8_t>>;
+        using adapter_t = serial_adapter<Config>;
+        using config = Config;
+        using output_adapter = OutputAdapter;
+
+        template<typename T>
+        void write_bulk(const T& val)
+        {
+            using value_t = typename containers::traits<T>::value_type;
+
+            const auto values = containers::adapter<T>::bulk_view(val);
+
+            if constexpr (!containers::traits<T>::has_fixed_size)
+            {
+                adapter_t::check_size(values.size(), config::max_container_size);
+                bitsery::details::writeSize(m_ser.adapter(), values.size());
+            }
+
+            if (!values.empty())
+            {
+                m_ser.adapter().template writeBuffer<1>(
+                    reinterpret_cast<const std::uint8_t*>(values.data()),
+                    values.size() * sizeof(value_t));
+            }
+        }
+
+        static auto make_ser([[maybe_unused]] output_buffer& buffer)
+            -> bitsery::Serializer<output_adapter>
+        {
+            if constexpr (is_size_counter)
+            {
+                return bitsery::Serializer<output_adapter>{};
+            }
+            else
+            {
+                return bitsery::Serializer<output_adapter>{ buffer };
+            }
+        }
 
         void flush()
         {
             m_ser.adapter().flush();
-            m_bytes.resize(m_ser.adapter().writtenBytesCount());
+            m_p_bytes->resize(m_ser.adapter().writtenBytesCount());
         }
 
         std::vector<std::uint8_t> m_bytes{};
+        std::vector<std::uint8_t>* m_p_bytes{ &m_bytes };
+        output_buffer m_buffer;
         bitsery::Serializer<output_adapter> m_ser;
     };
 
-    class deserializer : public detail::serializer_base<serial_adapter, true>
+    // std::basic_string_view and span<const T> (for arithmetic T) are deserialized as views into
+    // the input buffer rather than copied out of it, so they are only valid for as long as that
+    // buffer is alive and unmodified
+    template<typename Config>
+    class deserializer : public detail::serializer_base<serial_adapter<Config>, true>
     {
     public:
         explicit deserializer(const std::vector<std::uint8_t>& bytes) noexcept(
             EXTENSER_ASSERT_NOTHROW)
-            : m_bytes(bytes), m_last_size(m_bytes.size()), m_ser(m_bytes.cbegin(), m_last_size)
+            : m_input(bytes), m_ser(m_input.data(), m_input.size())
         {
         }
 
+        // Reads bytes in place (for example a mapped_file's), they must outlive the deserializer
+        // and any views deserialized from them
+        explicit deserializer(const view<std::uint8_t> bytes) noexcept(EXTENSER_ASSERT_NOTHROW)
+            : m_input(bytes), m_ser(m_input.data(), m_input.size())
+        {
+        }
+
+        // bitsery records read errors (including sizes over the configured limits) rather than
+        // throwing, so they are checked once the whole object has been read
+        template<typename T>
+        void deserialize_object(T&& val)
+        {
+            detail::serializer_base<adapter_t, true>::deserialize_object(std::forward<T>(val));
+
+            switch (m_ser.adapter().error())
+            {
+                case bitsery::ReaderError::NoError:
+                    return;
+
+                case bitsery::ReaderError::DataOverflow:
+                    fail(deserialization_errc::end_of_input,
+                        "bitsery error: unexpected end of input");
+
+                    return;
+
+                case bitsery::ReaderError::InvalidData:
+                    fail(deserialization_errc::malformed,
+                        "bitsery error: invalid data, or a size over the configured limit");
+
+                    return;
+
+                default:
+                    fail(deserialization_errc::malformed, "bitsery error: failed to read input");
+                    return;
+            }
+        }
+
         template<typename T>
         void as_bool([[maybe_unused]] const std::string_view key, T& val)
         {
@@ -326,21 +755,21 @@ namespace detail_bitsery
         {
             static_assert(sizeof(T) <= sizeof(double), "long double is not supported");
             update_buffer();
-            m_ser.value<sizeof(T)>(val);
+            m_ser.template value<sizeof(T)>(val);
         }
 
         template<typename T>
         void as_int([[maybe_unused]] const std::string_view key, T& val)
         {
             update_buffer();
-            m_ser.value<sizeof(T)>(val);
+            m_ser.template value<sizeof(T)>(val);
         }
 
         template<typename T>
         void as_uint([[maybe_unused]] const std::string_view key, T& val)
         {
             update_buffer();
-            m_ser.value<sizeof(T)>(val);
+            m_ser.template value<sizeof(T)>(val);
         }
 
         template<typename T>
@@ -349,7 +778,7 @@ namespace detail_bitsery
             static_assert(std::is_enum_v<T>, "T must be an enum type");
 
             update_buffer();
-            m_ser.value<sizeof(T)>(val);
+            m_ser.template value<sizeof(T)>(val);
         }
 
         template<typename T>
@@ -365,13 +794,20 @@ namespace detail_bitsery
             {
                 if constexpr (traits_t::has_fixed_size)
                 {
-                    m_ser.text<char_sz>(val);
+                    m_ser.template text<char_sz>(val);
                 }
                 else
                 {
-                    m_ser.text<char_sz>(val, config::max_string_size);
+                    m_ser.template text<char_sz>(val, config::max_string_size);
                 }
             }
+            else if constexpr (is_string_view<T>::value)
+            {
+                const auto [p_chars, length] =
+                    borrow<typename traits_t::value_type>(config::max_string_size);
+
+                val = T{ p_chars, length };
+            }
         }
 
         template<typename T>
@@ -384,7 +820,11 @@ namespace detail_bitsery
 
             update_buffer();
 
-            if constexpr (traits_t::is_mutable)
+            if constexpr (traits_t::is_mutable && use_bulk_copy_v<T>)
+            {
+                read_bulk(val);
+            }
+            else if constexpr (traits_t::is_mutable)
             {
                 if constexpr (traits_t::is_sequential)
                 {
@@ -392,27 +832,27 @@ namespace detail_bitsery
                     {
                         if constexpr (std::is_arithmetic_v<typename traits_t::value_type>)
                         {
-                            m_ser.container<sizeof(typename traits_t::value_type)>(val);
+                            m_ser.template container<sizeof(typename traits_t::value_type)>(val);
                         }
                         else
                         {
                             m_ser.container(val,
                                 [this](S& ser, typename traits_t::value_type& value)
-                                { serial_adapter::parse_obj(ser, *this, value); });
+                                { adapter_t::parse_obj(ser, *this, value); });
                         }
                     }
                     else
                     {
                         if constexpr (std::is_arithmetic_v<typename traits_t::value_type>)
                         {
-                            m_ser.container<sizeof(typename traits_t::value_type)>(
+                            m_ser.template container<sizeof(typename traits_t::value_type)>(
                                 val, config::max_container_size);
                         }
                         else
                         {
                             m_ser.container(val, config::max_container_size,
                                 [this](S& ser, typename traits_t::value_type& value)
-                                { serial_adapter::parse_obj(ser, *this, value); });
+                                { adapter_t::parse_obj(ser, *this, value); });
                         }
                     }
                 }
@@ -420,9 +860,19 @@ namespace detail_bitsery
                 {
                     m_ser.ext(val, bitsery::ext::StdSet{ config::max_container_size },
                         [this](S& ser, typename traits_t::value_type& value)
-                        { serial_adapter::parse_obj(ser, *this, value); });
+                        { adapter_t::parse_obj(ser, *this, value); });
                 }
             }
+            else if constexpr (is_borrowed_span_v<T>)
+            {
+                const auto [p_values, count] =
+                    borrow<std::remove_const_t<typename T::element_type>>(
+                        config::max_container_size);
+
+                // extenser's pre-C++20 span is not move-assignable
+                const T borrowed{ p_values, count };
+                val = borrowed;
+            }
         }
 
         template<typename T>
@@ -437,8 +887,8 @@ namespace detail_bitsery
             m_ser.ext(val, bitsery::ext::StdMap{ config::max_container_size },
                 [this](S& ser, key_t& map_key, val_t& map_val)
                 {
-                    serial_adapter::parse_obj(ser, *this, map_key);
-                    serial_adapter::parse_obj(ser, *this, map_val);
+                    adapter_t::parse_obj(ser, *this, map_key);
+                    adapter_t::parse_obj(ser, *this, map_val);
                 });
         }
 
@@ -453,8 +903,8 @@ namespace detail_bitsery
         void as_tuple([[maybe_unused]] const std::string_view key, std::pair<T1, T2>& val)
         {
             update_buffer();
-            serial_adapter::parse_obj(m_ser, *this, val.first);
-            serial_adapter::parse_obj(m_ser, *this, val.second);
+            adapter_t::parse_obj(m_ser, *this, val.first);
+            adapter_t::parse_obj(m_ser, *this, val.second);
         }
 
         template<typename... Args>
@@ -465,7 +915,7 @@ namespace detail_bitsery
             update_buffer();
             m_ser.ext(val,
                 bitsery::ext::StdTuple{ [this](S& ser, auto& subval)
-                    { serial_adapter::parse_obj(ser, *this, subval); } });
+                    { adapter_t::parse_obj(ser, *this, subval); } });
         }
 
         template<typename T>
@@ -475,25 +925,33 @@ namespace detail_bitsery
 
             update_buffer();
             m_ser.ext(val, bitsery::ext::StdOptional{},
-                [this](S& ser, T& subval) { serial_adapter::parse_obj(ser, *this, subval); });
+                [this](S& ser, T& subval) { adapter_t::parse_obj(ser, *this, subval); });
         }
 
         template<typename... Args>
         void as_variant([[maybe_unused]] const std::string_view key, std::variant<Args...>& val)
         {
-            using S = bitsery::Deserializer<input_adapter>;
-
             update_buffer();
-            m_ser.ext(val,
-                bitsery::ext::StdVariant{ [this](S& ser, auto& subval)
-                    { serial_adapter::parse_obj(ser, *this, subval); } });
+
+            if constexpr (detail::is_tagged_variant_v<std::variant<Args...>>)
+            {
+                adapter_t::parse_obj(m_ser, *this, val);
+            }
+            else
+            {
+                using S = bitsery::Deserializer<input_adapter>;
+
+                m_ser.ext(val,
+                    bitsery::ext::StdVariant{ [this](S& ser, auto& subval)
+                        { adapter_t::parse_obj(ser, *this, subval); } });
+            }
         }
 
         template<typename T>
         void as_object([[maybe_unused]] const std::string_view key, T& val)
         {
             update_buffer();
-            serial_adapter::parse_obj(m_ser, *this, val);
+            adapter_t::parse_obj(m_ser, *this, val);
         }
 
         void as_null([[maybe_unused]] const std::string_view key)
@@ -502,27 +960,134 @@ namespace detail_bitsery
         }
 
     private:
-        using config = serial_adapter::config;
-        using input_adapter = bitsery::InputBufferAdapter<std::vector<std::uint8_t>>;
+        using adapter_t = serial_adapter<Config>;
+        using config = Config;
+        using input_adapter = bitsery::InputBufferAdapter<input_buffer>;
+
+        // parse_obj() reports unknown variant tags through fail_read()
+        friend adapter_t;
+
+        // Errors are reported through fail(), which throws unless called under
+        // try_deserialize_object(). There, the input is also marked as failed, so bitsery reads
+        // nothing more from it
+        void fail_read(const deserialization_errc code, std::string message)
+        {
+            fail(code, std::move(message));
+            m_ser.adapter().error(code == deserialization_errc::end_of_input
+                    ? bitsery::ReaderError::DataOverflow
+                    : bitsery::ReaderError::InvalidData);
+        }
+
+        [[nodiscard]] auto read_size(const std::size_t max_size) -> std::size_t
+        {
+            std::size_t count{};
+            bitsery::details::readSize(m_ser.adapter(), count, max_size, std::true_type{});
+
+            if (m_ser.adapter().error() != bitsery::ReaderError::NoError)
+            {
+                fail(deserialization_errc::malformed, "bitsery error: invalid container size");
+                return 0;
+            }
+
+            return count;
+        }
+
+        // Skips over count values of type U, returning a pointer to the first of them in the input,
+        // or nullptr after an error
+        template<typename U>
+        [[nodiscard]] auto take(const std::size_t count) -> const std::uint8_t*
+        {
+            const auto pos = m_ser.adapter().currentReadPos();
+
+            if (failed())
+            {
+                return nullptr;
+            }
+
+            if (count > (m_input.size() - pos) / sizeof(U))
+            {
+                fail_read(
+                    deserialization_errc::end_of_input, "bitsery error: unexpected end of input");
+                return nullptr;
+            }
+
+            m_ser.adapter().currentReadPos(pos + count * sizeof(U));
+            return m_input.data() + pos;
+        }
+
+        // Reads a size prefix, then points into the input for that many values of type U
+        template<typename U>
+        [[nodiscard]] auto borrow(const std::size_t max_size) -> std::pair<const U*, std::size_t>
+        {
+            static_assert(std::is_arithmetic_v<U>, "only arithmetic values can be borrowed");
+
+            const auto count = read_size(max_size);
+            const std::uint8_t* const p_first = take<U>(count);
+
+            if (p_first == nullptr)
+            {
+                return { nullptr, 0 };
+            }
+
+            if constexpr (sizeof(U) > 1)
+            {
+                if constexpr (!is_little_endian_host)
+                {
+                    fail_read(deserialization_errc::malformed,
+                        "bitsery error: multi-byte views require a little-endian host");
+
+                    return { nullptr, 0 };
+                }
+
+                if (reinterpret_cast<std::uintptr_t>(p_first) % alignof(U) != 0)
+                {
+                    fail_read(deserialization_errc::malformed,
+                        "bitsery error: view is misaligned in input");
+
+                    return { nullptr, 0 };
+                }
+            }
+
+            return { reinterpret_cast<const U*>(p_first), count };
+        }
+
+        template<typename T>
+        void read_bulk(T& val)
+        {
+            using traits_t = containers::traits<T>;
+
+            std::size_t count = containers::adapter<T>::size(val);
+
+            if constexpr (!traits_t::has_fixed_size)
+            {
+                count = read_size(config::max_container_size);
+            }
+
+            const std::uint8_t* const p_first = take<typename traits_t::value_type>(count);
+
+            if (p_first != nullptr)
+            {
+                containers::adapter<T>::bulk_assign(val, p_first, count);
+            }
+        }
 
         void update_buffer()
         {
-            if (m_last_size != m_bytes.size())
+            if (m_input.refresh())
             {
-                m_last_size = m_bytes.size();
                 const auto curPos = m_ser.adapter().currentReadPos();
-                m_ser = bitsery::Deserializer<input_adapter>(m_bytes.cbegin(), m_last_size);
+                m_ser = bitsery::Deserializer<input_adapter>(m_input.data(), m_input.size());
                 m_ser.adapter().currentReadPos(curPos);
             }
         }
 
-        const std::vector<std::uint8_t>& m_bytes;
-        std::size_t m_last_size;
+        input_buffer m_input;
         bitsery::Deserializer<input_adapter> m_ser;
     };
 
+    template<typename Config>
     template<typename S, typename T, typename Adapter, bool Deserialize>
-    void serial_adapter::parse_obj(
+    void serial_adapter<Config>::parse_obj(
         S& ser, detail::serializer_base<Adapter, Deserialize>& fallback, T& val)
     {
         if constexpr (std::is_arithmetic_v<T>)
@@ -531,6 +1096,12 @@ namespace detail_bitsery
         }
         else if constexpr (detail::is_stringlike_v<T>)
         {
+            if constexpr (!Deserialize)
+            {
+                check_size(bitsery::traits::TextTraits<std::remove_cv_t<T>>::length(val),
+                    config::max_string_size);
+            }
+
             ser.text1b(val, config::max_string_size);
         }
         else if constexpr (detail::is_pair_v<T>)
@@ -550,6 +1121,11 @@ namespace detail_bitsery
             using key_t = typename T::key_type;
             using val_t = typename T::mapped_type;
 
+            if constexpr (!Deserialize)
+            {
+                check_size(val.size(), config::max_container_size);
+            }
+
             ser.ext(val, bitsery::ext::StdMap{ config::max_container_size },
                 [&fallback](S& s_ser, key_t& map_key, val_t& map_val)
                 {
@@ -561,6 +1137,11 @@ namespace detail_bitsery
         {
             using key_t = typename T::key_type;
 
+            if constexpr (!Deserialize)
+            {
+                check_size(val.size(), config::max_container_size);
+            }
+
             ser.ext(val, bitsery::ext::StdSet{ config::max_container_size },
                 [&fallback](S& s_ser, key_t& key_val) { parse_obj(s_ser, fallback, key_val); });
         }
@@ -568,6 +1149,13 @@ namespace detail_bitsery
         {
             using val_t = typename T::value_type;
 
+            if constexpr (!Deserialize
+                && bitsery::traits::ContainerTraits<std::remove_cv_t<T>>::isResizable)
+            {
+                check_size(bitsery::traits::ContainerTraits<std::remove_cv_t<T>>::size(val),
+                    config::max_container_size);
+            }
+
             if constexpr (std::is_arithmetic_v<val_t>)
             {
                 if constexpr (bitsery::traits::ContainerTraits<std::remove_cv_t<T>>::isResizable)
@@ -600,6 +1188,41 @@ namespace detail_bitsery
                 bitsery::ext::StdTuple{
                     [&fallback](S& s_ser, auto& subval) { parse_obj(s_ser, fallback, subval); } });
         }
+        else if constexpr (detail::is_tagged_variant_v<std::remove_cv_t<T>>)
+        {
+            using index_t = detail::variant_tag_index<std::remove_cv_t<T>>;
+
+            if constexpr (Deserialize)
+            {
+                std::uint32_t v_id{};
+                ser.value4b(v_id);
+                const auto v_idx = index_t::find(v_id);
+
+                if (v_idx == index_t::npos)
+                {
+                    static_cast<typename Adapter::deserializer_t&>(fallback).fail_read(
+                        deserialization_errc::invalid_value,
+                        std::string{ "bitsery error: unknown variant tag: " }.append(
+                            std::to_string(v_id)));
+
+                    return;
+                }
+
+                detail::visit_index<T>(v_idx,
+                    [&ser, &fallback, &val](auto idx_constant)
+                    {
+                        static constexpr std::size_t alt_idx = decltype(idx_constant)::value;
+                        parse_obj(ser, fallback, val.template emplace<alt_idx>());
+                    });
+            }
+            else
+            {
+                auto v_id = index_t::tags[val.index()].id;
+                ser.value4b(v_id);
+                std::visit([&ser, &fallback](auto& subval) { parse_obj(ser, fallback, subval); },
+                    val);
+            }
+        }
         else if constexpr (detail::is_variant_v<T>)
         {
             ser.ext(val,
@@ -625,6 +1248,12 @@ namespace detail_bitsery
     }
 } //namespace detail_bitsery
 
-using bitsery_adapter = detail_bitsery::serial_adapter;
+using bitsery_config = detail_bitsery::default_config;
+
+// Use with a Config derived from bitsery_config to change the size limits
+template<typename Config>
+using basic_bitsery_adapter = detail_bitsery::serial_adapter<Config>;
+
+using bitsery_adapter = basic_bitsery_adapter<bitsery_config>;
 } //namespace extenser
 #endif //EXTENSER_BITSERY_HPP
@@ -13,16 +13,28 @@
 
 #include "test_helpers.hpp"
 #include "extenser_bitsery.hpp"
+#include "extenser/mapped_file.hpp"
+#include "extenser/parallel.hpp"
+#include "extenser/stream.hpp"
 
 #define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <limits>
+#include <list>
 #include <optional>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <tuple>
+#include <variant>
 #include <vector>
 
 namespace extenser::tests
@@ -725,6 +737,53 @@ TEST_SUITE("bitsery adapter")
         }
     }
 
+    TEST_CASE("a tagged variant is serialized to bitsery by its tag id")
+    {
+        serializer ser{};
+
+        SUBCASE("a single variant, read back with the alternatives reordered")
+        {
+            const Shape expected_val{ Rect{ 3, 4 } };
+
+            REQUIRE_NOTHROW(ser.as_variant("", expected_val));
+
+            const auto& obj = ser.object();
+            REQUIRE_GE(obj.size(), 4U);
+            CHECK_EQ(obj[0], 0x07U);
+
+            deserializer dser{ obj };
+
+            std::variant<Rect, Circle> test_val{};
+            dser.as_variant("", test_val);
+
+            REQUIRE(std::holds_alternative<Rect>(test_val));
+            CHECK(std::get<Rect>(test_val) == std::get<Rect>(expected_val));
+        }
+
+        SUBCASE("variants in a container")
+        {
+            const std::vector<Shape> expected_val{ Circle{ 1.5 }, Rect{ 3, 4 } };
+
+            REQUIRE_NOTHROW(ser.as_array("", expected_val));
+
+            deserializer dser{ ser.object() };
+
+            std::vector<Shape> test_val{};
+            dser.as_array("", test_val);
+
+            CHECK(test_val == expected_val);
+        }
+
+        SUBCASE("an unknown tag id")
+        {
+            const std::vector<std::uint8_t> bytes{ 0x05U, 0x00U, 0x00U, 0x00U };
+            deserializer dser{ bytes };
+
+            Shape test_val{};
+            CHECK_THROWS_AS(dser.as_variant("", test_val), deserialization_error);
+        }
+    }
+
     TEST_CASE("a user-defined class can be serialized to bitsery")
     {
         serializer ser{};
@@ -779,6 +838,363 @@ TEST_SUITE("bitsery adapter")
         CHECK_EQ(test_val, expected_val);
     }
 
+    TEST_CASE("a bitsery serializer can write into a caller-supplied vector")
+    {
+        const auto test_val = create_test_val<std::list<Person>>();
+        std::vector<std::uint8_t> out{};
+
+        // Warm the vector up, as a pooled buffer would be
+        serializer warm_ser{ std::ref(out) };
+        warm_ser.serialize_object(test_val);
+        std::ignore = warm_ser.object();
+
+        const auto expected = easy_serializer<bitsery_adapter>::quick_serialize(test_val);
+
+        SUBCASE("the vector holds exactly the serialized bytes")
+        {
+            serializer ser{ std::ref(out) };
+            ser.serialize_object(test_val);
+
+            CHECK_EQ(&ser.object(), &out);
+            CHECK_EQ(out, expected);
+        }
+
+        SUBCASE("the vector's storage is reused by the next serializer")
+        {
+            const auto* const p_data = out.data();
+
+            serializer ser{ std::ref(out) };
+            ser.serialize_object(test_val);
+            std::ignore = ser.object();
+
+            CHECK_EQ(out.data(), p_data);
+            CHECK_EQ(easy_serializer<bitsery_adapter>::quick_deserialize<std::list<Person>>(out),
+                test_val);
+        }
+    }
+
+    TEST_CASE("a bitsery serializer can write into a fixed-capacity buffer")
+    {
+        const Pet test_val{ "Sam", Pet::Species::Cat };
+        const auto expected = easy_serializer<bitsery_adapter>::quick_serialize(test_val);
+
+        SUBCASE("a buffer large enough for the object is filled")
+        {
+            std::array<std::uint8_t, 64> buffer{};
+            serializer ser{ span<std::uint8_t>{ buffer } };
+            ser.serialize_object(test_val);
+
+            REQUIRE_EQ(ser.size(), expected.size());
+            CHECK(std::equal(expected.begin(), expected.end(), buffer.begin()));
+        }
+
+        SUBCASE("a buffer too small for the object throws rather than overflowing")
+        {
+            std::array<std::uint8_t, 4> buffer{};
+            serializer ser{ span<std::uint8_t>{ buffer } };
+
+            CHECK_THROWS_AS(ser.serialize_object(test_val), serialization_error);
+        }
+    }
+
+    TEST_CASE("serialized_size matches the number of bytes serialized")
+    {
+        const auto check_size = [](const auto& val)
+        {
+            const auto size = serialized_size<bitsery_adapter>(val);
+            CHECK_EQ(size, easy_serializer<bitsery_adapter>::quick_serialize(val).size());
+        };
+
+        check_size(std::uint64_t{ 22U });
+        check_size(std::string(300, 'x'));
+        check_size(std::vector<int>{ 1, 2, 3, 4 });
+        check_size(std::make_tuple(1, std::string{ "two" }, 3.0));
+        check_size(std::optional<Pet>{ Pet{ "Sam", Pet::Species::Cat } });
+        check_size(std::variant<int, std::string, Pet>{ std::string{ "variant" } });
+        check_size(Bar{ 4 });
+        check_size(create_test_val<std::list<Person>>());
+    }
+
+    TEST_CASE("contiguous containers of enums are copied as one block")
+    {
+        using species_t = Pet::Species;
+        using underlying_t = std::underlying_type_t<species_t>;
+
+        const std::vector<species_t> expected_val{ species_t::Cat, species_t::Dog,
+            species_t::Turtle, species_t::Bird, species_t::Snake };
+
+        std::vector<underlying_t> underlying(expected_val.size());
+        std::transform(expected_val.begin(), expected_val.end(), underlying.begin(),
+            [](const species_t species) { return static_cast<underlying_t>(species); });
+
+        const auto bytes = easy_serializer<bitsery_adapter>::quick_serialize(expected_val);
+
+        // The encoding is unchanged from writing each value separately
+        CHECK_EQ(bytes, easy_serializer<bitsery_adapter>::quick_serialize(underlying));
+
+        const auto test_val =
+            easy_serializer<bitsery_adapter>::quick_deserialize<std::vector<species_t>>(bytes);
+
+        CHECK_EQ(test_val, expected_val);
+
+        using array_t = std::array<species_t, 3>;
+
+        const array_t expected_arr{ species_t::Fish, species_t::Cat, species_t::Dog };
+        const auto arr_bytes = easy_serializer<bitsery_adapter>::quick_serialize(expected_arr);
+        const auto test_arr =
+            easy_serializer<bitsery_adapter>::quick_deserialize<array_t>(arr_bytes);
+
+        CHECK_EQ(arr_bytes.size(), sizeof(expected_arr));
+        CHECK_EQ(test_arr, expected_arr);
+    }
+
+    struct small_config : bitsery_config
+    {
+        static constexpr std::size_t max_string_size = 8;
+        static constexpr std::size_t max_container_size = 4;
+    };
+
+    TEST_CASE("bitsery size limits are taken from the adapter's config")
+    {
+        using small_adapter = basic_bitsery_adapter<small_config>;
+
+        SUBCASE("the default limits allow large payloads")
+        {
+            const std::vector<double> expected_val(100'000, 1.5);
+            const auto bytes = easy_serializer<bitsery_adapter>::quick_serialize(expected_val);
+
+            const auto test_val =
+                easy_serializer<bitsery_adapter>::quick_deserialize<std::vector<double>>(bytes);
+
+            CHECK_EQ(test_val, expected_val);
+        }
+
+        SUBCASE("serializing past a limit throws")
+        {
+            small_adapter::serializer_t ser{};
+
+            CHECK_NOTHROW(ser.serialize_object(std::vector<int>{ 1, 2, 3, 4 }));
+            CHECK_THROWS_AS(
+                ser.serialize_object(std::vector<int>{ 1, 2, 3, 4, 5 }), serialization_error);
+            CHECK_THROWS_AS(
+                ser.serialize_object(std::string{ "Mary had a little lamb" }), serialization_error);
+
+            const std::map<int, std::vector<int>> nested{ { 1, { 1, 2, 3, 4, 5 } } };
+            CHECK_THROWS_AS(ser.serialize_object(nested), serialization_error);
+        }
+
+        SUBCASE("input claiming to exceed a limit is rejected")
+        {
+            const auto bytes = easy_serializer<bitsery_adapter>::quick_serialize(
+                std::vector<int>{ 1, 2, 3, 4, 5 });
+
+            small_adapter::deserializer_t dser{ bytes };
+            std::vector<int> test_val{};
+
+            CHECK_THROWS_AS(dser.deserialize_object(test_val), deserialization_error);
+        }
+    }
+
+    TEST_CASE("large arrays can be serialized to bitsery in parallel")
+    {
+        const parallel_options options{ 4, 100 };
+
+        // Vectors are covered for every adapter in tests/adapters.test.cpp
+        SUBCASE("a fixed-size array is written as on one thread")
+        {
+            const auto people = create_people(400);
+
+            std::array<Person, 400> fixed_people{};
+            std::copy_n(people.begin(), fixed_people.size(), fixed_people.begin());
+
+            CHECK_EQ(serialize_parallel<bitsery_adapter>(fixed_people, options),
+                easy_serializer<bitsery_adapter>::quick_serialize(fixed_people));
+        }
+
+        SUBCASE("an error in any chunk is rethrown")
+        {
+            using small_adapter = basic_bitsery_adapter<small_config>;
+
+            CHECK_THROWS_AS(std::ignore = serialize_parallel<small_adapter>(
+                                std::vector<std::string>(1000, "a long string"), options),
+                serialization_error);
+        }
+    }
+
+    TEST_CASE("values can be written to and read from streams with bitsery")
+    {
+        const auto people = create_people(300);
+        const auto serial = easy_serializer<bitsery_adapter>::quick_serialize(people);
+        const stream_options options{ 64 };
+
+        SUBCASE("an array is written in batches, producing the same bytes")
+        {
+            std::ostringstream out{};
+            serialize_to<bitsery_adapter>(out, people, options);
+
+            const auto str = out.str();
+            CHECK_EQ((std::vector<std::uint8_t>{ str.begin(), str.end() }), serial);
+
+            std::array<Person, 100> fixed_people{};
+            std::copy_n(people.begin(), fixed_people.size(), fixed_people.begin());
+
+            std::ostringstream fixed_out{};
+            serialize_to<bitsery_adapter>(fixed_out, fixed_people, options);
+
+            const auto fixed_str = fixed_out.str();
+            CHECK_EQ((std::vector<std::uint8_t>{ fixed_str.begin(), fixed_str.end() }),
+                easy_serializer<bitsery_adapter>::quick_serialize(fixed_people));
+        }
+
+        SUBCASE("an array round trips through a FILE*")
+        {
+            std::FILE* const p_file = std::tmpfile();
+            REQUIRE(p_file != nullptr);
+
+            serialize_to<bitsery_adapter>(p_file, people, options);
+            std::rewind(p_file);
+
+            std::vector<Person> test_val{};
+            deserialize_from<bitsery_adapter>(p_file, test_val, options);
+            std::fclose(p_file);
+
+            CHECK_EQ(test_val, people);
+        }
+
+        SUBCASE("an error in any batch is thrown")
+        {
+            using small_adapter = basic_bitsery_adapter<small_config>;
+
+            std::ostringstream out{};
+            CHECK_THROWS_AS(serialize_to<small_adapter>(out,
+                                std::vector<std::string>(1000, "a long string"), options),
+                serialization_error);
+        }
+    }
+
+    struct Blob
+    {
+        std::string_view name;
+        span<const std::uint8_t> payload;
+
+        template<typename S>
+        void serialize(extenser::generic_serializer<S>& ser)
+        {
+            ser.as_string("name", name);
+            ser.as_array("payload", payload);
+        }
+    };
+
+    struct Samples
+    {
+        std::uint8_t channel;
+        span<const std::uint16_t> values;
+
+        template<typename S>
+        void serialize(extenser::generic_serializer<S>& ser)
+        {
+            ser.as_uint("channel", channel);
+            ser.as_array("values", values);
+        }
+    };
+
+    TEST_CASE("views are deserialized in place from the input buffer")
+    {
+        const std::vector<std::uint8_t> payload{ 0xDE, 0xAD, 0xBE, 0xEF };
+        const auto bytes = easy_serializer<bitsery_adapter>::quick_serialize(Blob{
+            "Mary had a little lamb", span<const std::uint8_t>{ payload.data(), payload.size() } });
+
+        const auto points_into_bytes = [&bytes](const auto* ptr)
+        {
+            const auto* const p_byte = reinterpret_cast<const std::uint8_t*>(ptr);
+            return p_byte >= bytes.data() && p_byte < bytes.data() + bytes.size();
+        };
+
+        SUBCASE("string_view and span members refer to the input bytes")
+        {
+            const auto test_val = easy_serializer<bitsery_adapter>::quick_deserialize<Blob>(bytes);
+
+            CHECK_EQ(test_val.name, "Mary had a little lamb");
+            REQUIRE_EQ(test_val.payload.size(), payload.size());
+            CHECK(std::equal(payload.begin(), payload.end(), test_val.payload.begin()));
+            CHECK(points_into_bytes(test_val.name.data()));
+            CHECK(points_into_bytes(test_val.payload.data()));
+        }
+
+        SUBCASE("a multi-byte span needs its values to be aligned in the input")
+        {
+            const std::vector<std::uint16_t> expected_val{ 1, 2, 3, 500 };
+
+            // A one byte channel plus a one byte size prefix leaves the values 2-byte aligned
+            const auto aligned_bytes = easy_serializer<bitsery_adapter>::quick_serialize(
+                Samples{ 7U, span<const std::uint16_t>{ expected_val.data(), 4 } });
+            const auto test_val =
+                easy_serializer<bitsery_adapter>::quick_deserialize<Samples>(aligned_bytes);
+
+            REQUIRE_EQ(test_val.values.size(), expected_val.size());
+            CHECK(std::equal(expected_val.begin(), expected_val.end(), test_val.values.begin()));
+
+            // On its own, the size prefix leaves them at an odd address
+            const auto misaligned_bytes =
+                easy_serializer<bitsery_adapter>::quick_serialize(expected_val);
+
+            deserializer dser{ misaligned_bytes };
+            span<const std::uint16_t> misaligned_val{};
+
+            CHECK_THROWS_AS(dser.deserialize_object(misaligned_val), deserialization_error);
+        }
+
+        SUBCASE("a view running past the end of the input throws")
+        {
+            auto truncated = bytes;
+            truncated.resize(8);
+
+            deserializer dser{ truncated };
+            std::string_view test_val{};
+
+            CHECK_THROWS_AS(dser.deserialize_object(test_val), deserialization_error);
+        }
+
+        SUBCASE("a deserializer over a span reads the bytes in place")
+        {
+            deserializer dser{ view<std::uint8_t>{ bytes.data(), bytes.size() } };
+            Blob test_val{};
+            dser.deserialize_object(test_val);
+
+            CHECK_EQ(test_val.name, "Mary had a little lamb");
+            CHECK(points_into_bytes(test_val.name.data()));
+            CHECK(points_into_bytes(test_val.payload.data()));
+
+            deserializer short_dser{ view<std::uint8_t>{ bytes.data(), 8 } };
+            CHECK_THROWS_AS(short_dser.deserialize_object(test_val), deserialization_error);
+        }
+    }
+
+    TEST_CASE("a bitsery deserializer can read a memory-mapped file")
+    {
+        const auto people = create_people(100);
+        const auto path =
+            (std::filesystem::temp_directory_path() / "extenser_bitsery_mapped.bin").string();
+
+        {
+            const auto bytes = easy_serializer<bitsery_adapter>::quick_serialize(people);
+            std::ofstream out{ path, std::ios::binary };
+            out.write(reinterpret_cast<const char*>(bytes.data()),
+                static_cast<std::streamsize>(bytes.size()));
+        }
+
+        {
+            const mapped_file file{ path };
+            deserializer dser{ file.bytes() };
+
+            std::vector<Person> test_val{};
+            dser.deserialize_object(test_val);
+            CHECK_EQ(test_val, people);
+        }
+
+        std::filesystem::remove(path);
+    }
+
     struct NoDefault
     {
         NoDefault() = delete;
@@ -0,0 +1,2715 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_CBOR_HPP
+#define EXTENSER_CBOR_HPP
+
+#include "../extenser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace extenser
+{
+namespace detail_cbor
+{
+    class serializer;
+    class deserializer;
+
+    struct serial_adapter
+    {
+        using bytes_t = std::vector<std::uint8_t>;
+        using serial_t = std::vector<std::uint8_t>;
+        using serializer_t = serializer;
+        using deserializer_t = deserializer;
+        using config = void;
+    };
+
+    // CBOR major types (RFC 8949 3.1), held in the top 3 bits of an item's first byte
+    namespace major
+    {
+        inline constexpr std::uint8_t uint = 0U;
+        inline constexpr std::uint8_t nint = 1U;
+        inline constexpr std::uint8_t bstr = 2U;
+        inline constexpr std::uint8_t tstr = 3U;
+        inline constexpr std::uint8_t array = 4U;
+        inline constexpr std::uint8_t map = 5U;
+        inline constexpr std::uint8_t tag = 6U;
+        inline constexpr std::uint8_t simple = 7U;
+    } //namespace major
+
+    namespace simple
+    {
+        inline constexpr std::uint8_t false_value = 0xF4U;
+        inline constexpr std::uint8_t true_value = 0xF5U;
+        inline constexpr std::uint8_t null = 0xF6U;
+        inline constexpr std::uint8_t float16 = 0xF9U;
+        inline constexpr std::uint8_t float32 = 0xFAU;
+        inline constexpr std::uint8_t float64 = 0xFBU;
+        inline constexpr std::uint8_t break_code = 0xFFU;
+    } //namespace simple
+
+    // Additional information values for lengths that follow the first byte, and for
+    // indefinite-length items
+    inline constexpr std::uint8_t ai_uint8 = 24U;
+    inline constexpr std::uint8_t ai_indefinite = 31U;
+
+    inline constexpr std::uint16_t canonical_nan = 0x7E00U;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    inline constexpr bool is_little_endian_host = false;
+#else
+    inline constexpr bool is_little_endian_host = true;
+#endif
+
+    // RFC 8746 typed array tags are 0b010fsell: f for floats, s for signed integers, e for
+    // little-endian, and ll for the element size
+    template<typename T>
+    [[nodiscard]] constexpr auto typed_array_tag(const bool little_endian) noexcept
+        -> std::uint64_t
+    {
+        static_assert(sizeof(T) <= 8, "element type is too large for a typed array");
+
+        const std::uint64_t size_bits = sizeof(T) == 1 ? 0U
+            : sizeof(T) == 2                           ? 1U
+            : sizeof(T) == 4                           ? 2U
+                                                       : 3U;
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // Floats have no 8-bit form, so their sizes start at 16 bits
+            return 0x50U + (little_endian ? 0x04U : 0U) + size_bits - 1U;
+        }
+        else
+        {
+            // The little-endian bit of an 8-bit integer would mean a clamped array instead
+            return 0x40U + (std::is_signed_v<T> ? 0x08U : 0U)
+                + (little_endian && sizeof(T) != 1 ? 0x04U : 0U) + size_bits;
+        }
+    }
+
+    template<typename T>
+    inline constexpr bool is_byte_type_v = std::is_same_v<std::remove_cv_t<T>, unsigned char>
+        || std::is_same_v<std::remove_cv_t<T>, std::byte>;
+
+    // Contiguous containers of bytes are written as a CBOR byte string, in a single copy
+    template<typename T, typename = void>
+    struct is_byte_container : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_byte_container<T, std::enable_if_t<containers::is_bulk_copyable_v<T>>> :
+        std::bool_constant<is_byte_type_v<typename containers::traits<T>::value_type>>
+    {
+    };
+
+    template<typename T>
+    inline constexpr bool is_byte_container_v = is_byte_container<T>::value;
+
+    // Contiguous containers of other numbers are written as RFC 8746 typed arrays, in a single copy
+    template<typename T, typename = void>
+    struct is_typed_array : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_typed_array<T, std::enable_if_t<containers::is_bulk_copyable_v<T>>> :
+        std::bool_constant<std::is_arithmetic_v<typename containers::traits<T>::value_type>
+            && !is_byte_type_v<typename containers::traits<T>::value_type>
+            && sizeof(typename containers::traits<T>::value_type) <= 8>
+    {
+    };
+
+    template<typename T>
+    inline constexpr bool is_typed_array_v = is_typed_array<T>::value;
+
+    // Views that are deserialized in place, pointing into the input
+    template<typename T>
+    inline constexpr bool is_borrowed_v = std::is_same_v<T, std::string_view>
+        || std::is_same_v<T, view<std::uint8_t>> || std::is_same_v<T, view<std::byte>>;
+
+    template<typename T, typename U>
+    [[nodiscard]] constexpr auto convert(const U num) noexcept -> T
+    {
+        if constexpr (std::is_same_v<T, U>)
+        {
+            return num;
+        }
+        else
+        {
+            return static_cast<T>(num);
+        }
+    }
+
+    // Finds the half-precision encoding of num, if it has one that holds the exact value
+    [[nodiscard]] inline auto to_half(const float num, std::uint16_t& half) noexcept -> bool
+    {
+        std::uint32_t bits{};
+        std::memcpy(&bits, &num, sizeof(bits));
+
+        const auto sign = static_cast<std::uint16_t>((bits >> 16U) & 0x8000U);
+        const auto exponent = static_cast<int>((bits >> 23U) & 0xFFU);
+        const auto mantissa = bits & 0x7FFFFFU;
+
+        // Infinities, as NaN is handled by the caller
+        if (exponent == 0xFF)
+        {
+            half = static_cast<std::uint16_t>(sign | 0x7C00U);
+            return mantissa == 0;
+        }
+
+        if (exponent == 0)
+        {
+            half = sign;
+            return mantissa == 0;
+        }
+
+        const auto unbiased = exponent - 127;
+
+        if (unbiased >= -14 && unbiased <= 15)
+        {
+            half = static_cast<std::uint16_t>(
+                sign | (static_cast<std::uint32_t>(unbiased + 15) << 10U) | (mantissa >> 13U));
+
+            return (mantissa & 0x1FFFU) == 0;
+        }
+
+        if (unbiased >= -24 && unbiased < -14)
+        {
+            // Subnormal halves hold the significand shifted down to a multiple of 2^-24
+            const auto significand = mantissa | 0x800000U;
+            const auto shift = static_cast<std::uint32_t>(-unbiased - 1);
+
+            half = static_cast<std::uint16_t>(sign | (significand >> shift));
+            return (significand & ((1U << shift) - 1U)) == 0;
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] inline auto from_half(const std::uint16_t half) noexcept -> double
+    {
+        const auto exponent = (half >> 10U) & 0x1FU;
+        const auto mantissa = static_cast<double>(half & 0x3FFU);
+
+        double num{};
+
+        if (exponent == 0)
+        {
+            num = std::ldexp(mantissa, -24);
+        }
+        else if (exponent == 0x1FU)
+        {
+            num = mantissa == 0.0 ? std::numeric_limits<double>::infinity()
+                                  : std::numeric_limits<double>::quiet_NaN();
+        }
+        else
+        {
+            num = std::ldexp(mantissa + 1024.0, static_cast<int>(exponent) - 25);
+        }
+
+        return (half & 0x8000U) != 0 ? -num : num;
+    }
+
+    // Writes canonical CBOR (RFC 8949 4.2) directly to a byte vector as values are visited: every
+    // length is definite and in its shortest form, floats use the shortest width that holds their
+    // value, and map entries are sorted by their encoded keys. Objects become maps from field name
+    // to value
+    class serializer : public detail::serializer_base<serial_adapter, false>
+    {
+    public:
+        serializer() noexcept { take_spare(); }
+        explicit serializer(const std::vector<std::uint8_t>& bytes) : m_bytes(bytes)
+        {
+            take_spare();
+        }
+
+        explicit serializer(std::vector<std::uint8_t>&& bytes) noexcept
+            : m_bytes(std::move(bytes))
+        {
+            take_spare();
+        }
+
+        // Writes to the caller's vector instead of an owned one, its capacity is reused between
+        // calls to serialize_object()
+        explicit serializer(const std::reference_wrapper<std::vector<std::uint8_t>> out) noexcept
+            : m_p_out(&out.get())
+        {
+            m_p_out->clear();
+            take_spare();
+        }
+
+        // A copy would write to the same caller's vector, moving hands it over
+        serializer(const serializer&) = delete;
+        serializer(serializer&&) noexcept = default;
+        auto operator=(const serializer&) -> serializer& = delete;
+        auto operator=(serializer&&) noexcept -> serializer& = default;
+        ~serializer() noexcept { give_back_spare(); }
+
+        template<typename T>
+        void serialize_object(const T& val)
+        {
+            buffer().clear();
+            m_entries.clear();
+            m_frame = frame{};
+            m_depth = 0;
+
+            // Fields of a whole object are sorted once, by end_object()
+            m_direct = false;
+            detail::serializer_base<serial_adapter, false>::serialize_object(val);
+            end_object();
+            m_direct = true;
+        }
+
+        [[nodiscard]] auto object() const& noexcept -> const std::vector<std::uint8_t>&
+        {
+            return m_p_out == nullptr ? m_bytes : *m_p_out;
+        }
+
+        [[nodiscard]] auto object() && noexcept -> std::vector<std::uint8_t>&&
+        {
+            return std::move(buffer());
+        }
+
+        // Used by serialize_parallel() and serialize_to(): each chunk of a split array is written
+        // as just its elements, then splice_array() puts the array head in front of the chunks
+        // (serialize_to() writes serialize_array_head(), the chunks and serialize_array_tail())
+        template<typename It>
+        void serialize_elements(It first, const It last)
+        {
+            buffer().clear();
+            m_entries.clear();
+            m_frame = frame{};
+            m_depth = 0;
+
+            for (; first != last; ++first)
+            {
+                push_arg(*first);
+            }
+        }
+
+        template<typename T>
+        void splice_array(const T& val, std::vector<std::vector<std::uint8_t>>& chunks)
+        {
+            serialize_array_head(val);
+
+            buffer().reserve(std::accumulate(chunks.begin(), chunks.end(), buffer().size(),
+                [](const std::size_t size, const std::vector<std::uint8_t>& chunk)
+                { return size + chunk.size(); }));
+
+            for (const auto& chunk : chunks)
+            {
+                put_bytes(chunk.data(), chunk.size());
+            }
+        }
+
+        template<typename T>
+        void serialize_array_head(const T& val)
+        {
+            buffer().clear();
+            m_entries.clear();
+            m_frame = frame{};
+            m_depth = 0;
+
+            put_head(major::array,
+                static_cast<std::uint64_t>(std::distance(std::begin(val), std::end(val))));
+        }
+
+        // The array's length is in its head, so nothing marks its end
+        void serialize_array_tail() { buffer().clear(); }
+
+        [[nodiscard]] static constexpr auto element_separator() noexcept -> std::string_view
+        {
+            return {};
+        }
+
+        void as_bool(const std::string_view key, const bool val)
+        {
+            begin_field(key);
+            push_bool(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_float(const std::string_view key, const T val)
+        {
+            static_assert(!std::is_same_v<T, long double>, "long double is not supported");
+
+            begin_field(key);
+            push_float(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_int(const std::string_view key, const T val)
+        {
+            static_assert(sizeof(T) <= sizeof(std::int64_t), "maximum 64-bit integers supported");
+            static_assert(
+                std::is_integral_v<T> && std::is_signed_v<T>, "only signed integers are supported");
+
+            begin_field(key);
+            push_integer(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_uint(const std::string_view key, const T val)
+        {
+            static_assert(sizeof(T) <= sizeof(std::int64_t), "maximum 64-bit integers supported");
+            static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>,
+                "only unsigned integers are supported");
+
+            begin_field(key);
+            push_integer(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_enum(const std::string_view key, const T val)
+        {
+            static_assert(std::is_enum_v<T>, "T must be an enum type");
+
+            begin_field(key);
+            push_integer(static_cast<std::underlying_type_t<T>>(val));
+            end_field();
+        }
+
+        template<typename T>
+        void as_string(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_string(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_array(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_array(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_map(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_map(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_multimap(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_multimap(val);
+            end_field();
+        }
+
+        template<typename T1, typename T2>
+        void as_tuple(const std::string_view key, const std::pair<T1, T2>& val)
+        {
+            begin_field(key);
+            push_pair(val);
+            end_field();
+        }
+
+        template<typename... Args>
+        void as_tuple(const std::string_view key, const std::tuple<Args...>& val)
+        {
+            begin_field(key);
+            push_tuple(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_optional(const std::string_view key, const std::optional<T>& val)
+        {
+            begin_field(key);
+            push_optional(val);
+            end_field();
+        }
+
+        template<typename... Args>
+        void as_variant(const std::string_view key, const std::variant<Args...>& val)
+        {
+            begin_field(key);
+            push_variant(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_object(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_arg(val);
+            end_field();
+        }
+
+        void as_null(const std::string_view key)
+        {
+            begin_field(key);
+            buffer().push_back(simple::null);
+            end_field();
+        }
+
+    private:
+        // State of the object currently being written: nothing yet, a map of keyed fields, or a
+        // single unkeyed value
+        enum class frame_state : std::uint8_t
+        {
+            empty,
+            keyed,
+            unkeyed,
+        };
+
+        // The offsets of the fields from the end of the map header are held in m_entries from
+        // entries_begin on
+        struct frame
+        {
+            frame_state state{ frame_state::empty };
+            std::size_t header_pos{};
+            std::size_t header_size{};
+            std::size_t entries_begin{};
+        };
+
+        struct entry_span
+        {
+            std::size_t pos{};
+            std::size_t size{};
+        };
+
+        // Capacity of m_entries, m_spans and m_scratch left behind by the last serializer on this
+        // thread, so a serializer made per message doesn't grow its own
+        struct spare_buffers
+        {
+            std::vector<std::size_t> entries{};
+            std::vector<entry_span> spans{};
+            std::vector<std::uint8_t> scratch{};
+        };
+
+        [[nodiscard]] static auto spare() noexcept -> spare_buffers&
+        {
+            static thread_local spare_buffers t_spare{};
+            return t_spare;
+        }
+
+        void take_spare() noexcept
+        {
+            auto& buffers = spare();
+            m_entries.swap(buffers.entries);
+            m_spans.swap(buffers.spans);
+            m_scratch.swap(buffers.scratch);
+        }
+
+        // Keeps the larger of each buffer
+        void give_back_spare() noexcept
+        {
+            auto& buffers = spare();
+
+            if (m_entries.capacity() > buffers.entries.capacity())
+            {
+                m_entries.clear();
+                m_entries.swap(buffers.entries);
+            }
+
+            if (m_spans.capacity() > buffers.spans.capacity())
+            {
+                m_spans.clear();
+                m_spans.swap(buffers.spans);
+            }
+
+            if (m_scratch.capacity() > buffers.scratch.capacity())
+            {
+                m_scratch.clear();
+                m_scratch.swap(buffers.scratch);
+            }
+        }
+
+        [[nodiscard]] auto buffer() noexcept -> std::vector<std::uint8_t>&
+        {
+            return m_p_out == nullptr ? m_bytes : *m_p_out;
+        }
+
+        [[nodiscard]] static auto encode_head(const std::uint8_t major_type,
+            const std::uint64_t arg, std::array<std::uint8_t, 9>& head) noexcept -> std::size_t
+        {
+            const auto type_bits = static_cast<std::uint8_t>(major_type << 5U);
+            std::size_t byte_count{};
+
+            if (arg < ai_uint8)
+            {
+                head[0] = static_cast<std::uint8_t>(type_bits | arg);
+                return 1;
+            }
+
+            if (arg <= std::numeric_limits<std::uint8_t>::max())
+            {
+                head[0] = static_cast<std::uint8_t>(type_bits | ai_uint8);
+                byte_count = 1;
+            }
+            else if (arg <= std::numeric_limits<std::uint16_t>::max())
+            {
+                head[0] = static_cast<std::uint8_t>(type_bits | (ai_uint8 + 1U));
+                byte_count = 2;
+            }
+            else if (arg <= std::numeric_limits<std::uint32_t>::max())
+            {
+                head[0] = static_cast<std::uint8_t>(type_bits | (ai_uint8 + 2U));
+                byte_count = 4;
+            }
+            else
+            {
+                head[0] = static_cast<std::uint8_t>(type_bits | (ai_uint8 + 3U));
+                byte_count = 8;
+            }
+
+            for (std::size_t i = 0; i < byte_count; ++i)
+            {
+                head[byte_count - i] = static_cast<std::uint8_t>(arg >> (8U * i));
+            }
+
+            return byte_count + 1;
+        }
+
+        void put_head(const std::uint8_t major_type, const std::uint64_t arg)
+        {
+            std::array<std::uint8_t, 9> head{};
+            const auto size = encode_head(major_type, arg, head);
+
+            auto& out = buffer();
+            out.insert(out.end(), head.begin(), head.begin() + static_cast<std::ptrdiff_t>(size));
+        }
+
+        void put_bytes(const void* const p_data, const std::size_t size)
+        {
+            auto& out = buffer();
+            const auto* const p_first = static_cast<const std::uint8_t*>(p_data);
+            out.insert(out.end(), p_first, p_first + size);
+        }
+
+        // Writes a float's tag followed by its bits, big-endian
+        template<typename U>
+        void put_float_bits(const std::uint8_t initial, const U bits)
+        {
+            std::array<std::uint8_t, sizeof(U) + 1> bytes{ initial };
+
+            for (std::size_t i = 0; i < sizeof(U); ++i)
+            {
+                bytes[sizeof(U) - i] = static_cast<std::uint8_t>(bits >> (8U * i));
+            }
+
+            auto& out = buffer();
+            out.insert(out.end(), bytes.begin(), bytes.end());
+        }
+
+        // Encoded entries are unique keys followed by a value, and no CBOR item is a prefix of
+        // another, so comparing whole entries orders them by key
+        [[nodiscard]] auto entry_less(const entry_span lhs, const entry_span rhs) const noexcept
+            -> bool
+        {
+            const auto* const p_data = object().data();
+
+            return std::lexicographical_compare(p_data + lhs.pos, p_data + lhs.pos + lhs.size,
+                p_data + rhs.pos, p_data + rhs.pos + rhs.size);
+        }
+
+        void begin_field(const std::string_view key)
+        {
+            auto& out = buffer();
+
+            if (key.empty())
+            {
+                if (m_frame.state != frame_state::empty)
+                {
+                    if (m_depth != 0)
+                    {
+                        EXTENSER_THROW(serialization_error{ "CBOR error: unkeyed value written to "
+                                                            "an object that already has content" });
+                    }
+
+                    // Top-level unkeyed values replace the document, as they do in json_adapter
+                    out.clear();
+                    m_entries.clear();
+                }
+
+                m_frame.state = frame_state::unkeyed;
+                return;
+            }
+
+            switch (m_frame.state)
+            {
+                case frame_state::empty:
+                    m_frame.state = frame_state::keyed;
+                    m_frame.header_pos = out.size();
+                    m_frame.header_size = 1;
+                    m_frame.entries_begin = m_entries.size();
+                    out.push_back(static_cast<std::uint8_t>(major::map << 5U));
+                    break;
+
+                case frame_state::keyed:
+                    break;
+
+                case frame_state::unkeyed:
+                default:
+                    EXTENSER_THROW(serialization_error{
+                        "CBOR error: keyed value written to an object holding an unkeyed value" });
+            }
+
+            m_entries.push_back(out.size() - body_pos());
+            push_string(key);
+        }
+
+        void end_field()
+        {
+            if (m_frame.state != frame_state::keyed)
+            {
+                return;
+            }
+
+            // Fields written directly, outside of serialize_object(), have no end_object() to sort
+            // them, so the top-level map is then kept sorted and complete between fields and
+            // object() is always a valid document. Objects are otherwise sorted once, when they end
+            if (m_depth == 0 && m_direct)
+            {
+                insert_last_field();
+                write_map_head(m_entries.size() - m_frame.entries_begin);
+            }
+        }
+
+        [[nodiscard]] auto body_pos() const noexcept -> std::size_t
+        {
+            return m_frame.header_pos + m_frame.header_size;
+        }
+
+        // Moves the field just written to its place among the (already sorted) earlier fields
+        void insert_last_field()
+        {
+            auto& out = buffer();
+            const auto body = body_pos();
+            const auto first =
+                m_entries.begin() + static_cast<std::ptrdiff_t>(m_frame.entries_begin);
+            const auto last_offset = m_entries.back();
+            const entry_span last_field{ body + last_offset, out.size() - body - last_offset };
+
+            auto it = std::prev(m_entries.end());
+
+            // Fields are usually few, and often already in order, so search from the back
+            while (it != first)
+            {
+                const auto prev = std::prev(it);
+                const entry_span prev_field{ body + *prev, *it - *prev };
+
+                if (!entry_less(last_field, prev_field))
+                {
+                    break;
+                }
+
+                it = prev;
+            }
+
+            if (it == std::prev(m_entries.end()))
+            {
+                return;
+            }
+
+            const auto insert_offset = *it;
+            std::rotate(out.begin() + static_cast<std::ptrdiff_t>(body + insert_offset),
+                out.begin() + static_cast<std::ptrdiff_t>(last_field.pos), out.end());
+
+            m_entries.pop_back();
+
+            for (auto shifted = it; shifted != m_entries.end(); ++shifted)
+            {
+                *shifted += last_field.size;
+            }
+
+            m_entries.insert(it, insert_offset);
+        }
+
+        void write_map_head(const std::size_t field_count)
+        {
+            auto& out = buffer();
+
+            std::array<std::uint8_t, 9> head{};
+            const auto head_size = encode_head(major::map, field_count, head);
+
+            // The header only grows, and it only grows past one byte for objects with more than
+            // 23 fields
+            if (head_size != m_frame.header_size)
+            {
+                out.insert(out.begin() + static_cast<std::ptrdiff_t>(body_pos()),
+                    head_size - m_frame.header_size, std::uint8_t{});
+
+                m_frame.header_size = head_size;
+            }
+
+            std::copy(head.begin(), head.begin() + static_cast<std::ptrdiff_t>(head_size),
+                out.begin() + static_cast<std::ptrdiff_t>(m_frame.header_pos));
+        }
+
+        void end_object()
+        {
+            if (m_frame.state == frame_state::empty)
+            {
+                buffer().push_back(simple::null);
+            }
+            else if (m_frame.state == frame_state::keyed)
+            {
+                // Write the head first, sort_entries() finds the fields from the end of it
+                write_map_head(m_entries.size() - m_frame.entries_begin);
+                sort_entries(body_pos(), m_frame.entries_begin);
+            }
+        }
+
+        // Sorts the entries of the map that was just written, whose offsets from body are held in
+        // m_entries from entries_begin on, then removes those offsets
+        void sort_entries(const std::size_t body, const std::size_t entries_begin)
+        {
+            auto& out = buffer();
+            const auto count = m_entries.size() - entries_begin;
+
+            if (count < 2)
+            {
+                m_entries.resize(entries_begin);
+                return;
+            }
+
+            m_spans.clear();
+
+            for (std::size_t i = entries_begin; i < m_entries.size(); ++i)
+            {
+                const auto end = i + 1 == m_entries.size() ? out.size() - body : m_entries[i + 1];
+                m_spans.push_back({ body + m_entries[i], end - m_entries[i] });
+            }
+
+            m_entries.resize(entries_begin);
+
+            const auto less = [this](const entry_span lhs, const entry_span rhs)
+            { return entry_less(lhs, rhs); };
+
+            if (std::is_sorted(m_spans.begin(), m_spans.end(), less))
+            {
+                return;
+            }
+
+            std::sort(m_spans.begin(), m_spans.end(), less);
+            m_scratch.assign(out.begin() + static_cast<std::ptrdiff_t>(body), out.end());
+
+            auto dest = out.begin() + static_cast<std::ptrdiff_t>(body);
+
+            for (const auto& span : m_spans)
+            {
+                const auto src = m_scratch.begin() + static_cast<std::ptrdiff_t>(span.pos - body);
+                dest = std::copy(src, src + static_cast<std::ptrdiff_t>(span.size), dest);
+            }
+        }
+
+        void push_bool(const bool arg)
+        {
+            buffer().push_back(arg ? simple::true_value : simple::false_value);
+        }
+
+        template<typename T>
+        void push_integer(const T arg)
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (arg < 0)
+                {
+                    // Negative integers hold -1 - n, which is ~n in two's complement
+                    put_head(major::nint, ~static_cast<std::uint64_t>(arg));
+                    return;
+                }
+            }
+
+            put_head(major::uint, static_cast<std::uint64_t>(arg));
+        }
+
+        // Floats are written in the shortest of the half, single and double formats that holds
+        // their exact value, and every NaN is written as the same half
+        template<typename T>
+        void push_float(const T arg)
+        {
+            if (std::isnan(arg))
+            {
+                put_float_bits(simple::float16, canonical_nan);
+                return;
+            }
+
+            if constexpr (std::is_same_v<T, float>)
+            {
+                push_single(arg);
+            }
+            else
+            {
+                const auto dbl = convert<double>(arg);
+
+                if (std::isinf(dbl)
+                    || (std::abs(dbl) <= static_cast<double>(std::numeric_limits<float>::max())
+                        && static_cast<double>(static_cast<float>(dbl)) == dbl))
+                {
+                    push_single(static_cast<float>(dbl));
+                    return;
+                }
+
+                std::uint64_t bits{};
+                std::memcpy(&bits, &dbl, sizeof(bits));
+                put_float_bits(simple::float64, bits);
+            }
+        }
+
+        void push_single(const float arg)
+        {
+            if (std::uint16_t half{}; to_half(arg, half))
+            {
+                put_float_bits(simple::float16, half);
+                return;
+            }
+
+            std::uint32_t bits{};
+            std::memcpy(&bits, &arg, sizeof(bits));
+            put_float_bits(simple::float32, bits);
+        }
+
+        template<typename T>
+        void push_string(const T& arg)
+        {
+            if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                const std::string_view str{ arg };
+                put_head(major::tstr, str.size());
+                put_bytes(str.data(), str.size());
+            }
+            else
+            {
+                // Non-char strings are written as arrays of code units
+                push_array(arg);
+            }
+        }
+
+        template<typename T>
+        void push_array(const T& arg)
+        {
+            if constexpr (is_byte_container_v<T>)
+            {
+                const auto bytes = containers::adapter<T>::bulk_view(arg);
+                put_head(major::bstr, bytes.size());
+                put_bytes(bytes.data(), bytes.size());
+            }
+            else if constexpr (is_typed_array_v<T>)
+            {
+                using value_t = std::remove_cv_t<typename containers::traits<T>::value_type>;
+
+                // Always written little-endian, so the same value has the same bytes on every
+                // host. Little-endian hosts copy the elements as a block
+                const auto elems = containers::adapter<T>::bulk_view(arg);
+                const auto size = elems.size() * sizeof(value_t);
+                put_head(major::tag, typed_array_tag<value_t>(true));
+                put_head(major::bstr, size);
+                put_bytes(elems.data(), size);
+
+                if constexpr (!is_little_endian_host && sizeof(value_t) > 1)
+                {
+                    auto& out = buffer();
+                    auto* const p_elems = out.data() + (out.size() - size);
+
+                    for (std::size_t i = 0; i < elems.size(); ++i)
+                    {
+                        std::reverse(p_elems + i * sizeof(value_t),
+                            p_elems + (i + 1) * sizeof(value_t));
+                    }
+                }
+            }
+            else
+            {
+                put_head(major::array,
+                    static_cast<std::uint64_t>(std::distance(std::begin(arg), std::end(arg))));
+
+                for (const auto& subval : arg)
+                {
+                    push_arg(subval);
+                }
+            }
+        }
+
+        template<typename T>
+        void push_map(const T& arg)
+        {
+            put_head(major::map,
+                static_cast<std::uint64_t>(std::distance(std::begin(arg), std::end(arg))));
+
+            const auto body = buffer().size();
+            const auto entries_begin = m_entries.size();
+
+            for (const auto& [k, v] : arg)
+            {
+                m_entries.push_back(buffer().size() - body);
+                push_arg(k);
+                push_arg(v);
+            }
+
+            sort_entries(body, entries_begin);
+        }
+
+        // Each key is written once followed by the array of its values, as in json_adapter
+        template<typename T>
+        void push_multimap(const T& arg)
+        {
+            std::uint64_t key_count = 0;
+
+            for (auto it = arg.begin(); it != arg.end(); it = arg.equal_range(it->first).second)
+            {
+                ++key_count;
+            }
+
+            put_head(major::map, key_count);
+
+            const auto body = buffer().size();
+            const auto entries_begin = m_entries.size();
+
+            for (auto it = arg.begin(); it != arg.end();)
+            {
+                const auto range = arg.equal_range(it->first);
+
+                m_entries.push_back(buffer().size() - body);
+                push_arg(it->first);
+                put_head(major::array,
+                    static_cast<std::uint64_t>(std::distance(range.first, range.second)));
+
+                for (; it != range.second; ++it)
+                {
+                    push_arg(it->second);
+                }
+            }
+
+            sort_entries(body, entries_begin);
+        }
+
+        template<typename T1, typename T2>
+        void push_pair(const std::pair<T1, T2>& arg)
+        {
+            put_head(major::array, 2);
+            push_arg(arg.first);
+            push_arg(arg.second);
+        }
+
+        template<typename... Args>
+        void push_tuple(const std::tuple<Args...>& arg)
+        {
+            put_head(major::array, sizeof...(Args));
+            detail::for_each_tuple(
+                arg, [this](auto&& elem) { push_arg(std::forward<decltype(elem)>(elem)); });
+        }
+
+        template<typename T>
+        void push_optional(const std::optional<T>& arg)
+        {
+            if (arg.has_value())
+            {
+                push_arg(*arg);
+            }
+            else
+            {
+                buffer().push_back(simple::null);
+            }
+        }
+
+        // Variants are written as [index, value]
+        template<typename... Args>
+        void push_variant(const std::variant<Args...>& arg)
+        {
+            put_head(major::array, 2);
+
+            if constexpr (detail::is_tagged_variant_v<std::variant<Args...>>)
+            {
+                put_head(major::uint,
+                    detail::variant_tag_index<std::variant<Args...>>::tags[arg.index()].id);
+            }
+            else
+            {
+                put_head(major::uint, arg.index());
+            }
+
+            std::visit([this](auto&& l_val) { push_arg(std::forward<decltype(l_val)>(l_val)); },
+                arg);
+        }
+
+        template<typename T>
+        void push_object(const T& arg)
+        {
+            const auto prev_frame = std::exchange(m_frame, frame{});
+            ++m_depth;
+
+            detail::serializer_base<serial_adapter, false>::serialize_object(arg);
+            end_object();
+
+            --m_depth;
+            m_frame = prev_frame;
+        }
+
+        template<typename T>
+        void push_arg(const T& arg)
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+            if constexpr (is_null_serializable<no_ref_t>)
+            {
+                buffer().push_back(simple::null);
+            }
+            else if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                push_bool(arg);
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                static_assert(
+                    !std::is_same_v<no_ref_t, long double>, "long double is not supported");
+                push_float(arg);
+            }
+            else if constexpr (std::is_arithmetic_v<no_ref_t>)
+            {
+                push_integer(arg);
+            }
+            else if constexpr (is_enum_serializable<no_ref_t>)
+            {
+                push_integer(static_cast<std::underlying_type_t<no_ref_t>>(arg));
+            }
+            else if constexpr (is_string_serializable<no_ref_t>)
+            {
+                push_string(arg);
+            }
+            else if constexpr (is_multimap_serializable<no_ref_t>)
+            {
+                push_multimap(arg);
+            }
+            else if constexpr (is_map_serializable<no_ref_t>)
+            {
+                push_map(arg);
+            }
+            else if constexpr (is_array_serializable<no_ref_t>)
+            {
+                push_array(arg);
+            }
+            else if constexpr (is_optional_serializable<no_ref_t>)
+            {
+                push_optional(arg);
+            }
+            else if constexpr (is_tuple_serializable<no_ref_t>)
+            {
+                if constexpr (detail::is_pair_v<no_ref_t>)
+                {
+                    push_pair(arg);
+                }
+                else
+                {
+                    push_tuple(arg);
+                }
+            }
+            else if constexpr (is_variant_serializable<no_ref_t>)
+            {
+                push_variant(arg);
+            }
+            else
+            {
+                push_object(arg);
+            }
+        }
+
+        std::vector<std::uint8_t> m_bytes{};
+        std::vector<std::uint8_t>* m_p_out{ nullptr };
+        frame m_frame{};
+        std::size_t m_depth{};
+        bool m_direct{ true };
+        std::vector<std::size_t> m_entries{};
+        std::vector<entry_span> m_spans{};
+        std::vector<std::uint8_t> m_scratch{};
+    };
+
+    // Reads values straight out of the CBOR bytes as the as_xxx() calls arrive, accepting any
+    // well-formed CBOR rather than only the canonical form the serializer writes: lengths may be
+    // indefinite, tags are skipped, and map members may come in any order. Like json_text_adapter,
+    // members are matched in order, those read out of order are remembered so they are only
+    // scanned once, and unvisited values are skipped without being decoded. std::string_view and
+    // byte views are deserialized as views into the input
+    class deserializer : public detail::serializer_base<serial_adapter, true>
+    {
+    public:
+        // Reads bytes in place, so they must outlive the deserializer
+        explicit deserializer(const std::vector<std::uint8_t>& bytes) noexcept
+            : m_p_bytes(&bytes), m_p_data(bytes.data()), m_size(bytes.size())
+        {
+        }
+
+        explicit deserializer(std::vector<std::uint8_t>&& bytes) = delete;
+
+        explicit deserializer(const view<std::uint8_t> bytes) noexcept
+            : m_p_data(bytes.data()), m_size(bytes.size())
+        {
+        }
+
+        deserializer(const std::uint8_t* const p_data, const std::size_t size) noexcept
+            : m_p_data(p_data), m_size(size)
+        {
+        }
+
+        // Bound to the caller's bytes (and, when given a vector, re-reads it on every
+        // deserialize_object()), so it can be moved but not copied
+        deserializer(const deserializer&) = delete;
+        deserializer(deserializer&&) noexcept = default;
+        auto operator=(const deserializer&) -> deserializer& = delete;
+        auto operator=(deserializer&&) noexcept -> deserializer& = default;
+        ~deserializer() noexcept = default;
+
+        template<typename T>
+        void deserialize_object(T&& val)
+        {
+            if (m_p_bytes != nullptr)
+            {
+                m_p_data = m_p_bytes->data();
+                m_size = m_p_bytes->size();
+            }
+
+            m_skipped.clear();
+            m_joined_keys.clear();
+            m_last_pos = npos;
+            m_frame = frame{ 0 };
+
+            detail::serializer_base<serial_adapter, true>::deserialize_object(std::forward<T>(val));
+
+            if (!failed() && frame_end() != m_size)
+            {
+                fail(deserialization_errc::malformed, "CBOR error: unexpected trailing bytes");
+            }
+        }
+
+        // Used by deserialize_from(), which reads a top-level array a window of the input at a
+        // time, deserializing each element from its own bytes. Returns the position of the first
+        // element and the number of elements, or npos for an indefinite-length array. The count is
+        // not checked against the input's size, as the rest of the array has not been read yet
+        [[nodiscard]] auto scan_array_head() const -> std::pair<std::size_t, std::size_t>
+        {
+            std::size_t pos = 0;
+
+            while (true)
+            {
+                const auto initial = byte_at(pos);
+                const auto major_type = static_cast<std::uint8_t>(initial >> 5U);
+                const auto info = static_cast<std::uint8_t>(initial & 0x1FU);
+                auto body = pos + 1;
+                std::uint64_t arg = info;
+
+                if (info >= ai_uint8 && info < ai_uint8 + 4U)
+                {
+                    const auto byte_count = std::size_t{ 1 } << (info - ai_uint8);
+                    arg = read_be(body, byte_count);
+                    body += byte_count;
+                }
+                else if (info > ai_uint8 + 3U
+                    && !(info == ai_indefinite && major_type == major::array))
+                {
+                    return { fail_malformed(pos), 0 };
+                }
+
+                // Tags in front of the array are skipped, as read_item() does
+                if (major_type == major::tag)
+                {
+                    pos = body;
+                    continue;
+                }
+
+                if (major_type != major::array)
+                {
+                    fail(deserialization_errc::type_mismatch,
+                        std::string{ "CBOR error: expected array, got " }.append(
+                            type_name(read_item(pos).type)));
+
+                    return { m_size, 0 };
+                }
+
+                const item header{ kind::array, body, arg, info == ai_indefinite, no_tag };
+                return { header.body,
+                    header.indefinite ? npos : static_cast<std::size_t>(header.arg) };
+            }
+        }
+
+        // Where the element at pos (the index-th) starts and ends. The break ending an
+        // indefinite-length array gives an empty range
+        [[nodiscard]] auto scan_array_item(
+            const std::size_t pos, [[maybe_unused]] const std::size_t index)
+            -> std::pair<std::size_t, std::size_t>
+        {
+            if (byte_at(pos) == simple::break_code)
+            {
+                return { pos + 1, pos + 1 };
+            }
+
+            return { pos, skip_value(pos) };
+        }
+
+        // Nothing may follow the array
+        [[nodiscard]] static constexpr auto scan_trailing(const std::size_t pos) noexcept
+            -> std::size_t
+        {
+            return pos;
+        }
+
+        void as_bool(const std::string_view key, bool& val) { parse_field(key, val); }
+
+        template<typename T>
+        void as_float(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_int(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_uint(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_enum(const std::string_view key, T& val)
+        {
+            static_assert(std::is_enum_v<T>, "T must be an enum type");
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_string(const std::string_view key, T& val)
+        {
+            if constexpr (std::is_array_v<T>)
+            {
+                span arr{ val };
+                as_string(key, arr);
+            }
+            else
+            {
+                const auto pos = find_field(key);
+
+                if (!failed())
+                {
+                    finish_field(pos, parse_string_like(pos, val));
+                }
+            }
+        }
+
+        template<typename T>
+        void as_array(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_map(const std::string_view key, T& val)
+        {
+            EXTENSER_PRECONDITION(std::size(val) == 0);
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_multimap(const std::string_view key, T& val)
+        {
+            EXTENSER_PRECONDITION(std::size(val) == 0);
+            parse_field(key, val);
+        }
+
+        template<typename T1, typename T2>
+        void as_tuple(const std::string_view key, std::pair<T1, T2>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename... Args>
+        void as_tuple(const std::string_view key, std::tuple<Args...>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_optional(const std::string_view key, std::optional<T>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename... Args>
+        void as_variant(const std::string_view key, std::variant<Args...>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_object(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        void as_null(const std::string_view key)
+        {
+            std::nullptr_t val{};
+            parse_field(key, val);
+        }
+
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+        static constexpr std::uint64_t no_tag = static_cast<std::uint64_t>(-1);
+
+        enum class kind : std::uint8_t
+        {
+            uint,
+            nint,
+            bstr,
+            tstr,
+            array,
+            map,
+            boolean,
+            null,
+            float16,
+            float32,
+            float64,
+            simple,
+            break_code,
+        };
+
+        // A decoded header, after any tags: body is the position just past it. arg holds the
+        // value of a boolean, integer (n for a negative integer -1 - n) or float's bits, the byte
+        // length of a definite string, or the element count of a definite array or map. tag is
+        // the innermost tag on the item, if any
+        struct item
+        {
+            kind type{};
+            std::size_t body{};
+            std::uint64_t arg{};
+            bool indefinite{};
+            std::uint64_t tag{ no_tag };
+        };
+
+        // The value currently being deserialized and, once a key has been looked up, the read
+        // position within its map
+        struct frame
+        {
+            std::size_t value_pos{ npos };
+            std::size_t cursor{ npos };
+            std::uint64_t member_count{};
+            std::uint64_t members_read{};
+            bool indefinite{};
+            std::size_t skipped_begin{};
+            std::size_t joined_keys_begin{};
+        };
+
+        // key points into the input, or into m_chunks if it was split into chunks
+        struct member
+        {
+            std::string_view key{};
+            std::size_t value_pos{};
+            bool borrowed{};
+        };
+
+        // Position of the next element of an array, shared by its element_iterators
+        struct array_cursor
+        {
+            std::size_t first{};
+            std::size_t index{};
+            std::size_t pos{};
+        };
+
+        // Items left to skip in an enclosing container, see skip_value()
+        struct skip_level
+        {
+            std::uint64_t remaining{};
+            bool indefinite{};
+        };
+
+        // The bytes of a string, pointing into the input unless it was split into chunks
+        struct string_bytes
+        {
+            const std::uint8_t* p_data{};
+            std::size_t size{};
+            std::size_t end{};
+            bool borrowed{};
+        };
+
+        // Iterates the element positions of an array. Positions are only found when dereferenced,
+        // so the container adapters can take std::distance() of a range for the cost of a count
+        class element_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::size_t*;
+            using reference = const std::size_t&;
+
+            element_iterator() noexcept = default;
+
+            element_iterator(
+                deserializer& des, array_cursor& cursor, const std::size_t index) noexcept
+                : m_p_des(&des), m_p_cursor(&cursor), m_index(index)
+            {
+            }
+
+            auto operator*() const -> reference
+            {
+                m_pos = m_p_des->element_pos(*m_p_cursor, m_index);
+                return m_pos;
+            }
+
+            auto operator++() noexcept -> element_iterator&
+            {
+                ++m_index;
+                return *this;
+            }
+
+            auto operator++(int) noexcept -> element_iterator
+            {
+                auto tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            friend auto operator==(
+                const element_iterator& lhs, const element_iterator& rhs) noexcept -> bool
+            {
+                return lhs.m_index == rhs.m_index;
+            }
+
+            friend auto operator!=(
+                const element_iterator& lhs, const element_iterator& rhs) noexcept -> bool
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            deserializer* m_p_des{ nullptr };
+            array_cursor* m_p_cursor{ nullptr };
+            std::size_t m_index{};
+            mutable std::size_t m_pos{ npos };
+        };
+
+        // Errors are reported through fail(), which throws unless called under
+        // try_deserialize_object(). There, the parse runs to the end of the input instead: each
+        // read returns m_size once an error is recorded, where every further read stops
+        [[nodiscard]] auto fail_at(const deserialization_errc code, std::string message) const
+            -> std::size_t
+        {
+            fail(code, std::move(message));
+            return m_size;
+        }
+
+        [[nodiscard]] auto fail_end_of_input() const -> std::size_t
+        {
+            return fail_at(deserialization_errc::end_of_input,
+                "CBOR error: unexpected end of input");
+        }
+
+        [[nodiscard]] auto fail_malformed(const std::size_t pos) const -> std::size_t
+        {
+            return fail_at(deserialization_errc::malformed,
+                std::string{ "CBOR error: malformed item at position " }.append(
+                    std::to_string(pos)));
+        }
+
+        // After an error, reads as a break, which ends every indefinite-length item
+        [[nodiscard]] auto byte_at(const std::size_t pos) const -> std::uint8_t
+        {
+            if (pos >= m_size)
+            {
+                std::ignore = fail_end_of_input();
+                return simple::break_code;
+            }
+
+            return failed() ? simple::break_code : m_p_data[pos];
+        }
+
+        // Reads byte_count bytes at pos as a big-endian unsigned integer
+        [[nodiscard]] auto read_be(const std::size_t pos, const std::size_t byte_count) const
+            -> std::uint64_t
+        {
+            if (pos > m_size || byte_count > m_size - pos)
+            {
+                std::ignore = fail_end_of_input();
+                return 0;
+            }
+
+            std::uint64_t num{};
+
+            for (std::size_t i = 0; i < byte_count; ++i)
+            {
+                num = (num << 8U) | m_p_data[pos + i];
+            }
+
+            return num;
+        }
+
+        // After an error, reads as null at the end of the input
+        [[nodiscard]] auto read_item(const std::size_t pos) const -> item
+        {
+            const auto header = decode_item(pos);
+            return failed() ? item{ kind::null, m_size, 0, false, no_tag } : header;
+        }
+
+        [[nodiscard]] auto decode_item(std::size_t pos) const -> item
+        {
+            auto tag = no_tag;
+
+            while (true)
+            {
+                const auto initial = byte_at(pos);
+                const auto major_type = static_cast<std::uint8_t>(initial >> 5U);
+                const auto info = static_cast<std::uint8_t>(initial & 0x1FU);
+                const auto start = pos++;
+
+                std::uint64_t arg = info;
+                bool indefinite = false;
+
+                if (info >= ai_uint8 && info < ai_uint8 + 4U)
+                {
+                    const auto byte_count = std::size_t{ 1 } << (info - ai_uint8);
+                    arg = read_be(pos, byte_count);
+                    pos += byte_count;
+                }
+                else if (info == ai_indefinite)
+                {
+                    if (major_type == major::uint || major_type == major::nint
+                        || major_type == major::tag)
+                    {
+                        return { kind::null, fail_malformed(start), 0, false, no_tag };
+                    }
+
+                    indefinite = true;
+                }
+                else if (info > ai_uint8 + 3U)
+                {
+                    return { kind::null, fail_malformed(start), 0, false, no_tag };
+                }
+
+                switch (major_type)
+                {
+                    case major::uint:
+                        return { kind::uint, pos, arg, false, tag };
+
+                    case major::nint:
+                        return { kind::nint, pos, arg, false, tag };
+
+                    case major::bstr:
+                    case major::tstr:
+                        if (!indefinite && arg > m_size - pos)
+                        {
+                            return { kind::null, fail_end_of_input(), 0, false, no_tag };
+                        }
+
+                        return { major_type == major::bstr ? kind::bstr : kind::tstr, pos, arg,
+                            indefinite, tag };
+
+                    // Every element takes at least one byte, so larger counts are rejected before
+                    // anything is reserved for them
+                    case major::array:
+                        if (!indefinite && arg > m_size - pos)
+                        {
+                            return { kind::null, fail_end_of_input(), 0, false, no_tag };
+                        }
+
+                        return { kind::array, pos, arg, indefinite, tag };
+
+                    case major::map:
+                        if (!indefinite && arg > (m_size - pos) / 2)
+                        {
+                            return { kind::null, fail_end_of_input(), 0, false, no_tag };
+                        }
+
+                        return { kind::map, pos, arg, indefinite, tag };
+
+                    case major::tag:
+                        tag = arg;
+                        continue;
+
+                    case major::simple:
+                    default:
+                        return read_simple(info, pos, arg, tag);
+                }
+            }
+        }
+
+        [[nodiscard]] static auto read_simple(const std::uint8_t info, const std::size_t body,
+            const std::uint64_t arg, const std::uint64_t tag) noexcept -> item
+        {
+            switch (static_cast<std::uint8_t>((major::simple << 5U) | info))
+            {
+                case simple::false_value:
+                    return { kind::boolean, body, 0, false, tag };
+
+                case simple::true_value:
+                    return { kind::boolean, body, 1, false, tag };
+
+                case simple::null:
+                    return { kind::null, body, 0, false, tag };
+
+                case simple::float16:
+                    return { kind::float16, body, arg, false, tag };
+
+                case simple::float32:
+                    return { kind::float32, body, arg, false, tag };
+
+                case simple::float64:
+                    return { kind::float64, body, arg, false, tag };
+
+                case simple::break_code:
+                    return { kind::break_code, body, 0, false, tag };
+
+                default:
+                    return { kind::simple, body, arg, false, tag };
+            }
+        }
+
+        [[nodiscard]] static auto type_name(const kind type) noexcept -> const char*
+        {
+            switch (type)
+            {
+                case kind::uint:
+                case kind::nint:
+                    return "integer";
+
+                case kind::bstr:
+                    return "byte string";
+
+                case kind::tstr:
+                    return "text string";
+
+                case kind::array:
+                    return "array";
+
+                case kind::map:
+                    return "map";
+
+                case kind::boolean:
+                    return "boolean";
+
+                case kind::null:
+                    return "null";
+
+                case kind::float16:
+                case kind::float32:
+                case kind::float64:
+                    return "float";
+
+                case kind::break_code:
+                    return "break";
+
+                case kind::simple:
+                default:
+                    return "simple value";
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto fail_type(const kind type) const -> std::size_t
+        {
+            return fail_at(deserialization_errc::type_mismatch,
+                std::string{ "CBOR error: expected " }
+                    .append(detail::expected_type_name<detail::remove_cvref_t<T>>())
+                    .append(", got ")
+                    .append(type_name(type)));
+        }
+
+        // Definite items inside definite containers are counted in one total, as in
+        // msgpack_adapter. Only indefinite-length items need a level of their own, ended by a break
+        [[nodiscard]] auto skip_value(std::size_t pos) -> std::size_t
+        {
+            skip_level level{ 1, false };
+            m_skip_levels.clear();
+
+            while (true)
+            {
+                if (!level.indefinite && level.remaining == 0)
+                {
+                    if (m_skip_levels.empty())
+                    {
+                        return pos;
+                    }
+
+                    level = m_skip_levels.back();
+                    m_skip_levels.pop_back();
+                    continue;
+                }
+
+                const auto header = read_item(pos);
+                pos = header.body;
+
+                if (failed())
+                {
+                    return m_size;
+                }
+
+                if (header.type == kind::break_code)
+                {
+                    if (!level.indefinite)
+                    {
+                        return fail_at(deserialization_errc::malformed,
+                            "CBOR error: unexpected break");
+                    }
+
+                    level = m_skip_levels.back();
+                    m_skip_levels.pop_back();
+                    continue;
+                }
+
+                if (!level.indefinite)
+                {
+                    --level.remaining;
+                }
+
+                std::uint64_t nested_count = 0;
+
+                switch (header.type)
+                {
+                    case kind::bstr:
+                    case kind::tstr:
+                        if (!header.indefinite)
+                        {
+                            pos += static_cast<std::size_t>(header.arg);
+                            continue;
+                        }
+
+                        break;
+
+                    case kind::array:
+                        nested_count = header.arg;
+                        break;
+
+                    case kind::map:
+                        nested_count = header.arg * 2;
+                        break;
+
+                    default:
+                        continue;
+                }
+
+                if (header.indefinite)
+                {
+                    m_skip_levels.push_back(level);
+                    level = { 0, true };
+                }
+                else if (level.indefinite)
+                {
+                    m_skip_levels.push_back(level);
+                    level = { nested_count, false };
+                }
+                else
+                {
+                    level.remaining += nested_count;
+                }
+            }
+        }
+
+        // End of the value at pos, reusing the result of the last parse when it was that value
+        [[nodiscard]] auto value_end(const std::size_t pos) -> std::size_t
+        {
+            return pos == m_last_pos ? m_last_end : skip_value(pos);
+        }
+
+        [[nodiscard]] auto element_pos(array_cursor& cursor, const std::size_t index)
+            -> std::size_t
+        {
+            if (index < cursor.index)
+            {
+                cursor.index = 0;
+                cursor.pos = cursor.first;
+            }
+
+            for (; cursor.index < index; ++cursor.index)
+            {
+                cursor.pos = value_end(cursor.pos);
+            }
+
+            return cursor.pos;
+        }
+
+        // Indefinite-length arrays are counted up front, so they can be read like definite ones
+        [[nodiscard]] auto element_count(const item& header) -> std::size_t
+        {
+            if (!header.indefinite)
+            {
+                return static_cast<std::size_t>(header.arg);
+            }
+
+            std::size_t count = 0;
+
+            for (auto pos = header.body; byte_at(pos) != simple::break_code; ++count)
+            {
+                pos = value_end(pos);
+            }
+
+            return count;
+        }
+
+        [[nodiscard]] auto array_end(const item& header, array_cursor& cursor,
+            const std::size_t count) -> std::size_t
+        {
+            return element_pos(cursor, count) + (header.indefinite ? 1U : 0U);
+        }
+
+        // Collects a string, joining the chunks of an indefinite-length one in m_chunks
+        [[nodiscard]] auto read_string(const item& header) -> string_bytes
+        {
+            if (!header.indefinite)
+            {
+                const auto size = static_cast<std::size_t>(header.arg);
+                return { m_p_data + header.body, size, header.body + size, true };
+            }
+
+            m_chunks.clear();
+            auto pos = header.body;
+
+            while (byte_at(pos) != simple::break_code)
+            {
+                const auto chunk = read_item(pos);
+
+                if (chunk.type != header.type || chunk.indefinite)
+                {
+                    return { nullptr, 0, fail_malformed(pos), true };
+                }
+
+                const auto* const p_chunk = m_p_data + chunk.body;
+                m_chunks.insert(m_chunks.end(), p_chunk,
+                    p_chunk + static_cast<std::ptrdiff_t>(chunk.arg));
+
+                pos = chunk.body + static_cast<std::size_t>(chunk.arg);
+            }
+
+            if (failed())
+            {
+                return { nullptr, 0, m_size, true };
+            }
+
+            return { m_chunks.data(), m_chunks.size(), pos + 1, false };
+        }
+
+        // Reads the next member of the current map. Keys that are not text strings never match a
+        // field
+        void read_member(member& out)
+        {
+            const auto header = read_item(m_frame.cursor);
+
+            if (header.type == kind::tstr)
+            {
+                const auto str = read_string(header);
+                out.key = { reinterpret_cast<const char*>(str.p_data), str.size };
+                out.value_pos = str.end;
+                out.borrowed = str.borrowed;
+            }
+            else
+            {
+                out.key = {};
+                out.value_pos = skip_value(m_frame.cursor);
+                out.borrowed = true;
+            }
+
+            ++m_frame.members_read;
+            m_frame.cursor = out.value_pos;
+        }
+
+        // True if the current map has members left to read, consuming the break that ends an
+        // indefinite-length map
+        [[nodiscard]] auto has_more_members() -> bool
+        {
+            if (failed())
+            {
+                return false;
+            }
+
+            if (!m_frame.indefinite)
+            {
+                return m_frame.members_read < m_frame.member_count;
+            }
+
+            if (byte_at(m_frame.cursor) != simple::break_code)
+            {
+                return true;
+            }
+
+            ++m_frame.cursor;
+            m_frame.indefinite = false;
+            m_frame.member_count = m_frame.members_read;
+            return false;
+        }
+
+        [[nodiscard]] auto find_field(const std::string_view key) -> std::size_t
+        {
+            if (key.empty())
+            {
+                return m_frame.value_pos;
+            }
+
+            if (m_frame.cursor == npos)
+            {
+                const auto header = read_item(m_frame.value_pos);
+
+                if (header.type != kind::map)
+                {
+                    return fail_at(deserialization_errc::type_mismatch,
+                        std::string{ "CBOR error: cannot look up key '" }
+                            .append(key)
+                            .append("' in a value of type: ")
+                            .append(type_name(header.type)));
+                }
+
+                m_frame.cursor = header.body;
+                m_frame.member_count = header.arg;
+                m_frame.indefinite = header.indefinite;
+            }
+
+            for (auto i = m_frame.skipped_begin; i < m_skipped.size(); ++i)
+            {
+                if (m_skipped[i].key == key)
+                {
+                    return m_skipped[i].value_pos;
+                }
+            }
+
+            member mem{};
+
+            while (has_more_members())
+            {
+                read_member(mem);
+
+                if (mem.key == key)
+                {
+                    return mem.value_pos;
+                }
+
+                m_frame.cursor = skip_value(mem.value_pos);
+
+                // m_chunks is reused by the next string read, so joined keys get their own copy
+                if (!mem.borrowed)
+                {
+                    mem.key = m_joined_keys.emplace_back(mem.key);
+                }
+
+                m_skipped.push_back(mem);
+            }
+
+            return fail_at(deserialization_errc::missing_key,
+                std::string{ "CBOR error: key '" }.append(key).append("' not found"));
+        }
+
+        void finish_field(const std::size_t pos, const std::size_t end) noexcept
+        {
+            // Members read in order move the cursor past their value
+            if (pos == m_frame.cursor)
+            {
+                m_frame.cursor = end;
+            }
+        }
+
+        template<typename T>
+        void parse_field(const std::string_view key, T& val)
+        {
+            const auto pos = find_field(key);
+
+            if (!failed())
+            {
+                finish_field(pos, parse_value(pos, val));
+            }
+        }
+
+        // Skips any members that were not read and returns the end of the current value
+        [[nodiscard]] auto frame_end() -> std::size_t
+        {
+            if (m_frame.cursor == npos)
+            {
+                return value_end(m_frame.value_pos);
+            }
+
+            member mem{};
+
+            while (has_more_members())
+            {
+                read_member(mem);
+                m_frame.cursor = skip_value(mem.value_pos);
+            }
+
+            return failed() ? m_size : m_frame.cursor;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_nested(const std::size_t pos, T& val) -> std::size_t
+        {
+            const auto prev_frame = std::exchange(m_frame, frame{ pos });
+            m_frame.skipped_begin = m_skipped.size();
+            m_frame.joined_keys_begin = m_joined_keys.size();
+
+            detail::serializer_base<serial_adapter, true>::deserialize_object(val);
+
+            const auto end = failed() ? m_size : frame_end();
+
+            m_skipped.resize(m_frame.skipped_begin);
+            m_joined_keys.resize(m_frame.joined_keys_begin);
+            m_frame = prev_frame;
+            return end;
+        }
+
+        template<typename T>
+        auto parse_value(const std::size_t pos, T& val) -> std::size_t
+        {
+            const auto end = parse_value_impl(pos, val);
+            m_last_pos = pos;
+            m_last_end = end;
+            return end;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_value_impl(const std::size_t pos, T& val) -> std::size_t
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+            if constexpr (is_null_serializable<no_ref_t>)
+            {
+                const auto header = read_item(pos);
+
+                if (header.type != kind::null)
+                {
+                    return fail_type<no_ref_t>(header.type);
+                }
+
+                return header.body;
+            }
+            else if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                const auto header = read_item(pos);
+
+                if (header.type != kind::boolean)
+                {
+                    return fail_type<bool>(header.type);
+                }
+
+                val = header.arg != 0;
+                return header.body;
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                return parse_float(pos, val);
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                return parse_integer(pos, val);
+            }
+            else if constexpr (is_enum_serializable<no_ref_t>)
+            {
+                std::underlying_type_t<no_ref_t> num{};
+                const auto end = parse_integer(pos, num);
+
+                if (!failed())
+                {
+                    val = static_cast<no_ref_t>(num);
+                }
+
+                return end;
+            }
+            else if constexpr (is_string_serializable<no_ref_t>)
+            {
+                return parse_string_like(pos, val);
+            }
+            else if constexpr (is_multimap_serializable<no_ref_t>)
+            {
+                return parse_multimap(pos, val);
+            }
+            else if constexpr (is_map_serializable<no_ref_t>)
+            {
+                return parse_map(pos, val);
+            }
+            else if constexpr (is_array_serializable<no_ref_t>)
+            {
+                return parse_array(pos, val);
+            }
+            else if constexpr (is_optional_serializable<no_ref_t>)
+            {
+                if (const auto header = read_item(pos); header.type == kind::null)
+                {
+                    val.reset();
+                    return header.body;
+                }
+
+                return parse_value(pos, val.emplace());
+            }
+            else if constexpr (detail::is_pair_v<no_ref_t>)
+            {
+                const auto header = read_tuple_header<no_ref_t>(pos, 2);
+                auto elem_pos = parse_value(header.body, val.first);
+                elem_pos = parse_value(elem_pos, val.second);
+                return tuple_end(header, elem_pos);
+            }
+            else if constexpr (is_tuple_serializable<no_ref_t>)
+            {
+                const auto header = read_tuple_header<no_ref_t>(pos, std::tuple_size_v<no_ref_t>);
+                auto elem_pos = header.body;
+
+                std::apply([this, &elem_pos](auto&... elems)
+                    { ((elem_pos = parse_value(elem_pos, elems)), ...); },
+                    val);
+
+                return tuple_end(header, elem_pos);
+            }
+            else if constexpr (is_variant_serializable<no_ref_t>)
+            {
+                return parse_variant(pos, val);
+            }
+            else
+            {
+                return parse_nested(pos, val);
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_integer(const std::size_t pos, T& val) const -> std::size_t
+        {
+            const auto header = read_item(pos);
+
+            if (header.type != kind::uint && header.type != kind::nint)
+            {
+                return fail_type<T>(header.type);
+            }
+
+            if (header.arg > static_cast<std::uint64_t>(std::numeric_limits<T>::max()))
+            {
+                return fail_at(deserialization_errc::out_of_range,
+                    "CBOR error: integer out of range");
+            }
+
+            if (header.type == kind::uint)
+            {
+                val = convert<T>(header.arg);
+            }
+            else if constexpr (std::is_unsigned_v<T>)
+            {
+                return fail_at(deserialization_errc::out_of_range,
+                    "CBOR error: integer out of range");
+            }
+            else
+            {
+                // -1 - n is in range for any n up to the maximum of T
+                val = convert<T>(-1 - static_cast<std::int64_t>(header.arg));
+            }
+
+            return header.body;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_float(const std::size_t pos, T& val) const -> std::size_t
+        {
+            static_assert(!std::is_same_v<T, long double>, "long double is not supported");
+
+            const auto header = read_item(pos);
+
+            switch (header.type)
+            {
+                case kind::float16:
+                    val = static_cast<T>(from_half(static_cast<std::uint16_t>(header.arg)));
+                    break;
+
+                case kind::float32:
+                {
+                    const auto bits = static_cast<std::uint32_t>(header.arg);
+                    float num{};
+                    std::memcpy(&num, &bits, sizeof(num));
+                    val = convert<T>(num);
+                    break;
+                }
+
+                case kind::float64:
+                {
+                    double num{};
+                    std::memcpy(&num, &header.arg, sizeof(num));
+                    val = convert<T>(num);
+                    break;
+                }
+
+                case kind::uint:
+                    val = static_cast<T>(header.arg);
+                    break;
+
+                case kind::nint:
+                    val = -static_cast<T>(header.arg) - T{ 1 };
+                    break;
+
+                default:
+                    return fail_type<T>(header.type);
+            }
+
+            return header.body;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_string_like(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+
+            if constexpr (!std::is_same_v<typename traits_t::value_type, char>)
+            {
+                // Non-char strings are arrays of code units
+                return parse_array(pos, val);
+            }
+            else
+            {
+                const auto header = read_item(pos);
+
+                if (header.type != kind::tstr)
+                {
+                    return fail_type<T>(header.type);
+                }
+
+                const auto str = read_string(header);
+
+                if (failed())
+                {
+                    return m_size;
+                }
+
+                const auto* const p_chars = reinterpret_cast<const char*>(str.p_data);
+
+                if constexpr (std::is_same_v<T, std::string>)
+                {
+                    val.assign(p_chars, str.size);
+                }
+                else if constexpr (is_borrowed_v<T>)
+                {
+                    if (!str.borrowed)
+                    {
+                        return fail_at(deserialization_errc::type_mismatch,
+                            "CBOR error: cannot view an indefinite-length string");
+                    }
+
+                    val = T{ p_chars, str.size };
+                }
+                else if constexpr (traits_t::is_mutable)
+                {
+                    if constexpr (traits_t::has_fixed_size)
+                    {
+                        if (str.size > adapter_t::size(val))
+                        {
+                            return fail_at(deserialization_errc::out_of_range,
+                                "CBOR error: array out of bounds");
+                        }
+                    }
+
+                    adapter_t::assign_from_range(
+                        val, p_chars, p_chars + str.size, [](const char c) { return c; });
+                }
+
+                return str.end;
+            }
+        }
+
+        // Reads a byte string, or a typed array of T's elements, into a contiguous container
+        template<typename T>
+        [[nodiscard]] auto parse_block(const item& header, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using value_t = std::remove_cv_t<typename traits_t::value_type>;
+
+            const auto bytes = read_string(header);
+
+            if (failed())
+            {
+                return m_size;
+            }
+
+            if (bytes.size % sizeof(value_t) != 0)
+            {
+                return fail_at(deserialization_errc::malformed,
+                    "CBOR error: typed array has a partial element");
+            }
+
+            const auto count = bytes.size / sizeof(value_t);
+
+            if constexpr (is_borrowed_v<T>)
+            {
+                if (!bytes.borrowed)
+                {
+                    return fail_at(deserialization_errc::type_mismatch,
+                        "CBOR error: cannot view an indefinite-length string");
+                }
+
+                const T borrowed{ reinterpret_cast<const value_t*>(bytes.p_data), count };
+                val = borrowed;
+            }
+            else if constexpr (traits_t::is_mutable)
+            {
+                if constexpr (traits_t::has_fixed_size)
+                {
+                    if (count != adapter_t::size(val))
+                    {
+                        return fail_at(
+                            deserialization_errc::out_of_range, "CBOR error: array out of bounds");
+                    }
+                }
+
+                adapter_t::bulk_assign(val, bytes.p_data, count);
+
+                // Typed arrays in the other byte order are swapped in place after the copy
+                if constexpr (sizeof(value_t) > 1)
+                {
+                    if (header.tag == typed_array_tag<value_t>(!is_little_endian_host))
+                    {
+                        auto* const p_elems = reinterpret_cast<std::uint8_t*>(std::data(val));
+
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            std::reverse(p_elems + i * sizeof(value_t),
+                                p_elems + (i + 1) * sizeof(value_t));
+                        }
+                    }
+                }
+            }
+
+            return bytes.end;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_array(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using value_t = detail::remove_cvref_t<typename traits_t::value_type>;
+
+            const auto header = read_item(pos);
+
+            if constexpr (is_byte_container_v<T>)
+            {
+                if (header.type == kind::bstr)
+                {
+                    return parse_block(header, val);
+                }
+            }
+            else if constexpr (is_typed_array_v<T>)
+            {
+                if (header.type == kind::bstr
+                    && (header.tag == typed_array_tag<value_t>(true)
+                        || header.tag == typed_array_tag<value_t>(false)))
+                {
+                    return parse_block(header, val);
+                }
+            }
+
+            if (header.type != kind::array)
+            {
+                return fail_type<T>(header.type);
+            }
+
+            if constexpr (traits_t::is_mutable)
+            {
+                const auto count = element_count(header);
+
+                if (failed())
+                {
+                    return m_size;
+                }
+
+                if constexpr (traits_t::has_fixed_size)
+                {
+                    if (count != adapter_t::size(val))
+                    {
+                        return fail_at(
+                            deserialization_errc::out_of_range, "CBOR error: array out of bounds");
+                    }
+                }
+
+                array_cursor cursor{ header.body, 0, header.body };
+                const element_iterator first{ *this, cursor, 0 };
+                const element_iterator last{ *this, cursor, count };
+                std::size_t index = 0;
+
+                // After an error, the remaining elements are left unread
+                const auto parse_elem = [this, &index](const std::size_t elem_pos)
+                {
+                    auto elem = detail::make_value<value_t>();
+
+                    if (!failed())
+                    {
+                        const path_guard trace{ *this, index++ };
+                        parse_value(elem_pos, elem);
+                    }
+
+                    return elem;
+                };
+
+                if constexpr (traits_t::is_sequential)
+                {
+                    adapter_t::assign_from_range(val, first, last, parse_elem);
+                }
+                else
+                {
+                    for (auto it = first; it != last; ++it)
+                    {
+                        adapter_t::insert_value(val, *it, parse_elem);
+                    }
+                }
+
+                return failed() ? m_size : array_end(header, cursor, count);
+            }
+            else
+            {
+                std::ignore = val;
+                return skip_value(pos);
+            }
+        }
+
+        // True if the map at header has an entry at pos, consuming the break that ends an
+        // indefinite-length map
+        [[nodiscard]] auto has_entry(const item& header, const std::uint64_t index,
+            std::size_t& pos) const -> bool
+        {
+            if (!header.indefinite)
+            {
+                return index < header.arg;
+            }
+
+            if (byte_at(pos) != simple::break_code)
+            {
+                return true;
+            }
+
+            ++pos;
+            return false;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_map(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using key_t = typename traits_t::key_type;
+            using mapped_t = typename traits_t::mapped_type;
+
+            const auto header = read_item(pos);
+
+            if (header.type != kind::map)
+            {
+                return fail_type<T>(header.type);
+            }
+
+            auto member_pos = header.body;
+
+            for (std::uint64_t i = 0; has_entry(header, i, member_pos); ++i)
+            {
+                auto next_pos = npos;
+
+                adapter_t::insert_value(val, member_pos,
+                    [this, &next_pos](const std::size_t key_pos)
+                    {
+                        std::pair<key_t, mapped_t> kv_pair{ detail::make_value<key_t>(),
+                            detail::make_value<mapped_t>() };
+
+                        next_pos = parse_value(parse_value(key_pos, kv_pair.first), kv_pair.second);
+                        return kv_pair;
+                    });
+
+                if (failed())
+                {
+                    return m_size;
+                }
+
+                member_pos = next_pos != npos ? next_pos : skip_value(skip_value(member_pos));
+            }
+
+            return member_pos;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_multimap(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using key_t = typename traits_t::key_type;
+            using mapped_t = typename traits_t::mapped_type;
+
+            const auto header = read_item(pos);
+
+            if (header.type != kind::map)
+            {
+                return fail_type<T>(header.type);
+            }
+
+            auto member_pos = header.body;
+
+            for (std::uint64_t i = 0; has_entry(header, i, member_pos); ++i)
+            {
+                auto key = detail::make_value<key_t>();
+                const auto values_pos = parse_value(member_pos, key);
+                const auto values = read_item(values_pos);
+
+                if (values.type != kind::array)
+                {
+                    return fail_type<std::vector<mapped_t>>(values.type);
+                }
+
+                const auto count = element_count(values);
+                array_cursor cursor{ values.body, 0, values.body };
+                const element_iterator last{ *this, cursor, count };
+
+                for (element_iterator it{ *this, cursor, 0 }; it != last; ++it)
+                {
+                    adapter_t::insert_value(val, *it,
+                        [this, &key](const std::size_t mapped_pos)
+                        {
+                            std::pair<key_t, mapped_t> kv_pair{ key,
+                                detail::make_value<mapped_t>() };
+
+                            parse_value(mapped_pos, kv_pair.second);
+                            return kv_pair;
+                        });
+
+                    if (failed())
+                    {
+                        return m_size;
+                    }
+                }
+
+                member_pos = array_end(values, cursor, count);
+            }
+
+            return member_pos;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto read_tuple_header(const std::size_t pos, const std::size_t size)
+            -> item
+        {
+            const auto header = read_item(pos);
+
+            if (header.type != kind::array)
+            {
+                return { kind::null, fail_type<T>(header.type), 0, false, no_tag };
+            }
+
+            if (element_count(header) != size)
+            {
+                return { kind::null,
+                    fail_at(deserialization_errc::out_of_range,
+                        "CBOR error: invalid number of args"),
+                    0, false, no_tag };
+            }
+
+            return header;
+        }
+
+        [[nodiscard]] static auto tuple_end(const item& header, const std::size_t pos) noexcept
+            -> std::size_t
+        {
+            // element_count() has already found the break of an indefinite-length tuple
+            return header.indefinite ? pos + 1 : pos;
+        }
+
+        template<typename... Args>
+        [[nodiscard]] auto parse_variant(const std::size_t pos, std::variant<Args...>& val)
+            -> std::size_t
+        {
+            if constexpr (detail::is_tagged_variant_v<std::variant<Args...>>)
+            {
+                using index_t = detail::variant_tag_index<std::variant<Args...>>;
+
+                const auto header = read_tuple_header<std::variant<Args...>>(pos, 2);
+
+                std::uint32_t v_id{};
+                const auto v_pos = parse_integer(header.body, v_id);
+
+                if (failed())
+                {
+                    return m_size;
+                }
+
+                const auto v_idx = index_t::find(v_id);
+
+                if (v_idx == index_t::npos)
+                {
+                    return fail_at(deserialization_errc::invalid_value,
+                        std::string{ "CBOR error: unknown variant tag: " }.append(
+                            std::to_string(v_id)));
+                }
+
+                return tuple_end(header, parse_variant_alt(v_pos, v_idx, val));
+            }
+
+            static constexpr std::size_t arg_sz = sizeof...(Args);
+
+            const auto header = read_tuple_header<std::variant<Args...>>(pos, 2);
+
+            std::size_t v_idx{};
+            const auto v_pos = parse_integer(header.body, v_idx);
+
+            if (failed())
+            {
+                return m_size;
+            }
+
+            if (v_idx >= arg_sz)
+            {
+                return fail_at(deserialization_errc::out_of_range,
+                    std::string{ "CBOR error: variant index exceeded variant size: " }.append(
+                        std::to_string(arg_sz)));
+            }
+
+            return tuple_end(header, parse_variant_alt(v_pos, v_idx, val));
+        }
+
+        template<typename... Args>
+        [[nodiscard]] auto parse_variant_alt(const std::size_t pos, const std::size_t v_idx,
+            std::variant<Args...>& val) -> std::size_t
+        {
+            return detail::visit_index<std::variant<Args...>>(v_idx,
+                [this, pos, &val](auto idx_constant) -> std::size_t
+                {
+                    static constexpr std::size_t alt_idx = decltype(idx_constant)::value;
+                    return parse_value(pos, val.template emplace<alt_idx>());
+                });
+        }
+
+        const std::vector<std::uint8_t>* m_p_bytes{ nullptr };
+        const std::uint8_t* m_p_data{ nullptr };
+        std::size_t m_size{};
+        frame m_frame{};
+        std::vector<member> m_skipped{};
+
+        // Stable copies of the chunked keys in m_skipped
+        std::list<std::string> m_joined_keys{};
+        std::vector<skip_level> m_skip_levels{};
+        std::vector<std::uint8_t> m_chunks{};
+        std::size_t m_last_pos{ npos };
+        std::size_t m_last_end{ npos };
+    };
+} //namespace detail_cbor
+
+using cbor_adapter = detail_cbor::serial_adapter;
+} //namespace extenser
+#endif //EXTENSER_CBOR_HPP
@@ -59,11 +59,11 @@ namespace detail
         ser.as_string("", val);
     }
 
+    // Adapters that can borrow from their input point val into it, the rest leave val unchanged
     template<typename Adapter, typename CharT, typename Traits>
-    void serialize([[maybe_unused]] serializer_base<Adapter, true>& ser,
-        [[maybe_unused]] std::basic_string_view<CharT, Traits>& val)
+    void serialize(serializer_base<Adapter, true>& ser, std::basic_string_view<CharT, Traits>& val)
     {
-        // nop
+        ser.as_string("", val);
     }
 } //namespace detail
 } //namespace extenser
@@ -0,0 +1,298 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_DETAIL_FIELD_TABLE_HPP
+#define EXTENSER_DETAIL_FIELD_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace extenser::detail
+{
+// The splitmix64 finalizer, so that every bit of a hash depends on every bit of its input
+[[nodiscard]] constexpr auto field_mix(std::uint64_t hash) noexcept -> std::uint64_t
+{
+    hash = (hash ^ (hash >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27U)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31U);
+}
+
+[[nodiscard]] constexpr auto hash_bits(const std::uint64_t hash) noexcept -> std::size_t
+{
+#if SIZE_MAX < UINT64_MAX
+    return static_cast<std::size_t>(hash);
+#else
+    return hash;
+#endif
+}
+
+// Seeded FNV-1a, mixed so the bits used for bucket selection see the whole key
+[[nodiscard]] constexpr auto field_hash(
+    const std::string_view key, const std::uint64_t seed) noexcept -> std::uint64_t
+{
+    constexpr std::uint64_t fnv_offset = 14695981039346656037ULL;
+    constexpr std::uint64_t fnv_prime = 1099511628211ULL;
+
+    std::uint64_t hash = fnv_offset ^ seed;
+
+    for (const char c : key)
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= fnv_prime;
+    }
+
+    return field_mix(hash);
+}
+
+// The bucket of a key's hash picks its displacement, which is mixed back into the hash to pick
+// its slot
+[[nodiscard]] constexpr auto field_bucket(const std::uint64_t hash, const std::size_t mask) noexcept
+    -> std::size_t
+{
+    return hash_bits(hash >> 32U) & mask;
+}
+
+[[nodiscard]] constexpr auto field_slot(const std::uint64_t hash,
+    const std::uint16_t displacement, const std::size_t mask) noexcept -> std::size_t
+{
+    return hash_bits(field_mix(hash + (std::uint64_t{ displacement } * 0x9E3779B97F4A7C15ULL)))
+        & mask;
+}
+
+// Type-erased view of a field_table, so adapters can resolve keys without being templated on the
+// field count
+struct field_table_view
+{
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    const std::string_view* p_keys{ nullptr };
+    const std::uint16_t* p_slots{ nullptr };
+    const std::uint16_t* p_displacements{ nullptr };
+    std::size_t slot_mask{};
+    std::size_t bucket_mask{};
+    std::uint64_t seed{};
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return p_slots == nullptr; }
+
+    // Returns the position of key among the declared keys, or npos if it is not one of them
+    [[nodiscard]] constexpr auto find(const std::string_view key) const noexcept -> std::size_t
+    {
+        const auto hash = field_hash(key, seed);
+        const auto entry = p_slots[field_slot(
+            hash, p_displacements[field_bucket(hash, bucket_mask)], slot_mask)];
+
+        return (entry != 0 && p_keys[entry - 1U] == key) ? entry - 1U : npos;
+    }
+};
+
+template<std::size_t N>
+[[nodiscard]] constexpr auto has_empty_key(const std::array<std::string_view, N>& keys) noexcept
+    -> bool
+{
+    for (const auto& key : keys)
+    {
+        if (key.empty())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Keys are compared only when their hashes match, which keeps this cheap enough to evaluate at
+// compile time for large key sets
+template<std::size_t N>
+[[nodiscard]] constexpr auto has_duplicate_key(
+    const std::array<std::string_view, N>& keys) noexcept -> bool
+{
+    std::array<std::uint64_t, N> hashes{};
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        hashes[i] = field_hash(keys[i], 0);
+    }
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        for (std::size_t j = i + 1; j < N; ++j)
+        {
+            if (hashes[i] == hashes[j] && keys[i] == keys[j])
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Collision-free table over a fixed key set, built at compile time. Keys are hashed into about
+// N / 2 buckets, and each bucket, largest first, is given the first displacement that moves its
+// keys to free slots among 2N or more. Slots hold a key's position plus one, or 0 when unused.
+// Keys that are empty, repeated or for which no displacements are found leave the table unbuilt,
+// which its users check with a static_assert
+template<std::size_t N>
+class field_table
+{
+    static_assert(N < 0xFFFFU, "too many keys for a field_table");
+
+public:
+    static constexpr std::uint64_t max_seed_attempts = 16;
+    static constexpr std::uint32_t max_displacement_attempts = 1024;
+
+    explicit constexpr field_table(const std::array<std::string_view, N>& keys) noexcept
+        : m_keys(keys)
+    {
+        if (has_empty_key(keys) || has_duplicate_key(keys))
+        {
+            return;
+        }
+
+        for (m_seed = 0; m_seed < max_seed_attempts; ++m_seed)
+        {
+            if (try_place())
+            {
+                m_built = true;
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr auto built() const noexcept -> bool { return m_built; }
+
+    [[nodiscard]] constexpr auto view() const noexcept -> field_table_view
+    {
+        return { m_keys.data(), m_slots.data(), m_displacements.data(), slot_count - 1,
+            bucket_count - 1, m_seed };
+    }
+
+    [[nodiscard]] constexpr auto find(const std::string_view key) const noexcept -> std::size_t
+    {
+        return view().find(key);
+    }
+
+private:
+    static constexpr auto pow2_at_least(const std::size_t count) noexcept -> std::size_t
+    {
+        std::size_t size = 1;
+
+        while (size < count)
+        {
+            size <<= 1U;
+        }
+
+        return size;
+    }
+
+    // A load factor of at most 1/2, with about two keys per bucket
+    static constexpr std::size_t slot_count = pow2_at_least(2 * N);
+    static constexpr std::size_t bucket_count = pow2_at_least((N + 1) / 2);
+
+    constexpr auto try_place() noexcept -> bool
+    {
+        std::array<std::uint64_t, N> hashes{};
+        std::array<std::size_t, bucket_count + 1> bucket_ends{};
+        std::array<std::uint16_t, N> by_bucket{};
+        std::size_t max_bucket_size = 0;
+
+        // Counting sort of the keys by bucket, bucket b taking [bucket_ends[b], bucket_ends[b + 1])
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            hashes[i] = field_hash(m_keys[i], m_seed);
+            ++bucket_ends[field_bucket(hashes[i], bucket_count - 1) + 1];
+        }
+
+        for (std::size_t b = 0; b < bucket_count; ++b)
+        {
+            if (bucket_ends[b + 1] > max_bucket_size)
+            {
+                max_bucket_size = bucket_ends[b + 1];
+            }
+
+            bucket_ends[b + 1] += bucket_ends[b];
+        }
+
+        std::array<std::size_t, bucket_count + 1> bucket_fill{ bucket_ends };
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            by_bucket[bucket_fill[field_bucket(hashes[i], bucket_count - 1)]++] =
+                static_cast<std::uint16_t>(i);
+        }
+
+        for (auto& slot : m_slots)
+        {
+            slot = 0;
+        }
+
+        for (auto size = max_bucket_size; size != 0; --size)
+        {
+            for (std::size_t b = 0; b < bucket_count; ++b)
+            {
+                if (bucket_ends[b + 1] - bucket_ends[b] == size
+                    && !place_bucket(hashes, by_bucket, bucket_ends[b], bucket_ends[b + 1], b))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    constexpr auto place_bucket(const std::array<std::uint64_t, N>& hashes,
+        const std::array<std::uint16_t, N>& by_bucket, const std::size_t first,
+        const std::size_t last, const std::size_t bucket) noexcept -> bool
+    {
+        for (std::uint32_t attempt = 0; attempt < max_displacement_attempts; ++attempt)
+        {
+            const auto displacement = static_cast<std::uint16_t>(attempt);
+            auto placed = first;
+
+            for (; placed < last; ++placed)
+            {
+                const auto key_pos = by_bucket[placed];
+                auto& slot = m_slots[field_slot(hashes[key_pos], displacement, slot_count - 1)];
+
+                if (slot != 0)
+                {
+                    break;
+                }
+
+                slot = static_cast<std::uint16_t>(key_pos + 1U);
+            }
+
+            if (placed == last)
+            {
+                m_displacements[bucket] = displacement;
+                return true;
+            }
+
+            // Frees the slots taken by this attempt before the next one
+            for (auto i = first; i < placed; ++i)
+            {
+                m_slots[field_slot(hashes[by_bucket[i]], displacement, slot_count - 1)] = 0;
+            }
+        }
+
+        return false;
+    }
+
+    std::array<std::string_view, N> m_keys;
+    std::array<std::uint16_t, slot_count> m_slots{};
+    std::array<std::uint16_t, bucket_count> m_displacements{};
+    std::uint64_t m_seed{};
+    bool m_built{ false };
+};
+} //namespace extenser::detail
+
+#endif //EXTENSER_DETAIL_FIELD_TABLE_HPP
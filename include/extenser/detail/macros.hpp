@@ -58,6 +58,19 @@ inline constexpr bool EXTENSER_ASSERT_NOTHROW = true;
 #define EXTENSER_POSTCONDITION(EXPR) EXTENSER_ASSERTION(EXPR)
 #define EXTENSER_PRECONDITION(EXPR) EXTENSER_ASSERTION(EXPR)
 
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#  define EXTENSER_HAS_EXCEPTIONS
+#endif
+
+// Without exceptions, errors that cannot be reported otherwise abort. The operand is still
+// checked, but not evaluated
+#if defined(EXTENSER_HAS_EXCEPTIONS)
+#  define EXTENSER_THROW(...) throw __VA_ARGS__
+#else
+#  include <cstdlib>
+#  define EXTENSER_THROW(...) (static_cast<void>(sizeof(__VA_ARGS__)), std::abort())
+#endif
+
 #if defined(__GNUC__)
 #  define EXTENSER_INLINE [[gnu::always_inline]]
 #elif defined(_MSC_VER)
@@ -10,13 +10,22 @@
 #ifndef EXTENSER_HPP
 #define EXTENSER_HPP
 
+#include "detail/field_table.hpp"
 #include "detail/macros.hpp"
 #include "detail/type_traits.hpp"
+#include "memory_resource.hpp"
 #include "span.hpp"
+#include "stats.hpp"
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <tuple>
 #include <type_traits>
@@ -36,6 +45,39 @@ namespace detail
         std::apply([f = std::forward<F>(func)](auto&&... args)
             { (f(std::forward<decltype(args)>(args)), ...); }, tuple);
     }
+
+    template<typename R, typename F, std::size_t I>
+    auto visit_index_alt(F&& func) -> R
+    {
+        return std::forward<F>(func)(std::integral_constant<std::size_t, I>{});
+    }
+
+    template<typename F, std::size_t... Is>
+    auto visit_index_impl(const std::size_t idx, F&& func, std::index_sequence<Is...>)
+        -> decltype(auto)
+    {
+        using result_t = decltype(std::forward<F>(func)(std::integral_constant<std::size_t, 0>{}));
+        using alt_fn_t = result_t (*)(F&&);
+
+        static constexpr std::array<alt_fn_t, sizeof...(Is)> table{
+            { &visit_index_alt<result_t, F, Is>... }
+        };
+
+        return table[idx](std::forward<F>(func));
+    }
+
+    // Calls func(std::integral_constant<std::size_t, idx>{}) for a runtime variant index, through a
+    // table of function pointers built at compile time, so dispatch takes constant time however
+    // many alternatives Variant has. idx must be less than std::variant_size_v<Variant>
+    template<typename Variant, typename F>
+    auto visit_index(const std::size_t idx, F&& func) -> decltype(auto)
+    {
+        static constexpr std::size_t alt_count = std::variant_size_v<remove_cvref_t<Variant>>;
+
+        EXTENSER_PRECONDITION(idx < alt_count);
+        return visit_index_impl(
+            idx, std::forward<F>(func), std::make_index_sequence<alt_count>{});
+    }
 } //namespace detail
 
 namespace containers
@@ -133,6 +175,24 @@ namespace containers
         }
     };
 
+    // Contiguous containers of trivially copyable values can be read and written as one block of
+    // memory (bool is excluded, since std::vector<bool> is not contiguous)
+    template<typename Container, typename = void>
+    struct is_bulk_copyable : std::false_type
+    {
+    };
+
+    template<typename Container>
+    struct is_bulk_copyable<Container, std::enable_if_t<traits<Container>::is_sequential>> :
+        std::bool_constant<traits<Container>::is_contiguous
+            && std::is_trivially_copyable_v<typename traits<Container>::value_type>
+            && !std::is_same_v<std::remove_cv_t<typename traits<Container>::value_type>, bool>>
+    {
+    };
+
+    template<typename Container>
+    inline constexpr bool is_bulk_copyable_v = is_bulk_copyable<Container>::value;
+
     template<typename Container>
     class sequential_adapter : public adapter_base<Container>
     {
@@ -152,6 +212,67 @@ namespace containers
             (static_cast<adapter_type*>(this))
                 ->assign_from_range(container, first, last, convert_fn);
         }
+
+        // The container's elements as a single contiguous block
+        static auto bulk_view(const container_type& container)
+            -> span<const typename traits_type::value_type>
+        {
+            static_assert(is_bulk_copyable_v<Container>, "container is not bulk copyable");
+
+            if (std::size(container) == 0)
+            {
+                return {};
+            }
+
+            return { std::data(container), std::size(container) };
+        }
+
+        // Copies count elements' worth of bytes into the container, resizing it if it is not of a
+        // fixed size, in place of an element-by-element assign_from_range. A fixed-size container
+        // must already hold exactly count elements, or those past count would keep stale values
+        static void bulk_assign(
+            container_type& container, const void* const p_bytes, const std::size_t count)
+        {
+            static_assert(is_bulk_copyable_v<Container>, "container is not bulk copyable");
+            static_assert(traits_type::is_mutable, "container is not mutable");
+
+            if constexpr (traits_type::has_fixed_size)
+            {
+                EXTENSER_PRECONDITION(count == std::size(container));
+            }
+            else
+            {
+                container.resize(count);
+            }
+
+            if (count != 0)
+            {
+                std::memcpy(std::data(container), p_bytes,
+                    count * sizeof(typename traits_type::value_type));
+            }
+        }
+
+        // Replaces the container's elements with count default-constructed ones, in place of an
+        // assign_from_range, so that disjoint slices of it can then be assigned from several
+        // threads
+        static void presize(container_type& container, const std::size_t count)
+        {
+            static_assert(!traits_type::has_fixed_size, "container has a fixed size");
+            static_assert(traits_type::is_mutable, "container is not mutable");
+
+            container.clear();
+            container.resize(count);
+        }
+
+        // Adds value to the end of the container, in place of an assign_from_range, for input that
+        // is read an element at a time
+        static void append(container_type& container, typename traits_type::value_type&& value)
+        {
+            static_assert(!traits_type::has_fixed_size, "container has a fixed size");
+            static_assert(traits_type::is_mutable, "container is not mutable");
+
+            container.push_back(std::move(value));
+        }
     };
 
     template<typename Container>
@@ -220,6 +341,254 @@ template<typename T>
 inline constexpr bool is_object_serializable =
     std::disjunction_v<detail::has_serialize_adl<T>, detail::has_serialize_mem<T>>;
 
+namespace detail
+{
+    // The kind of value an adapter expects for T, as named in its type errors. Enums are read as
+    // integers, adapters writing them by name report them as strings themselves
+    template<typename T>
+    [[nodiscard]] constexpr auto expected_type_name() noexcept -> std::string_view
+    {
+        if constexpr (is_optional_v<T>)
+        {
+            return expected_type_name<typename T::value_type>();
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            return "boolean";
+        }
+        else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+        {
+            return "integer";
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            return "float";
+        }
+        else if constexpr (is_stringlike_v<T>)
+        {
+            return "string";
+        }
+        else if constexpr (is_map_v<T>)
+        {
+            return "object";
+        }
+        else if constexpr (is_container_v<T> || is_pair_v<T> || is_tuple_v<T>)
+        {
+            return "array";
+        }
+        else if constexpr (std::is_same_v<T, std::nullptr_t> || std::is_same_v<T, std::monostate>
+            || std::is_same_v<T, std::nullopt_t>)
+        {
+            return "null";
+        }
+        else
+        {
+            return "object";
+        }
+    }
+} //namespace detail
+
+// Lists the keys a type's serialize() function uses, so adapters can resolve fields through a
+// table built at compile time. Types may declare them with EXTENSER_FIELDS, or this may be
+// specialized with a `value` of type std::array<std::string_view, N>
+template<typename T, typename = void>
+struct field_keys
+{
+};
+
+template<typename T>
+struct field_keys<T, std::void_t<decltype(T::extenser_fields)>>
+{
+    static constexpr auto value = T::extenser_fields;
+};
+
+template<typename... Keys>
+[[nodiscard]] constexpr auto make_field_keys(const Keys&... keys) noexcept
+    -> std::array<std::string_view, sizeof...(Keys)>
+{
+    return { std::string_view{ keys }... };
+}
+
+#define EXTENSER_FIELDS(...) \
+    static constexpr auto extenser_fields = ::extenser::make_field_keys(__VA_ARGS__)
+
+namespace detail
+{
+    template<typename T, typename = void>
+    struct has_field_keys : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct has_field_keys<T, std::void_t<decltype(field_keys<T>::value)>> : std::true_type
+    {
+    };
+
+    template<typename T>
+    inline constexpr bool has_field_keys_v = has_field_keys<T>::value;
+
+    template<typename T>
+    struct field_index
+    {
+        static constexpr auto keys = field_keys<T>::value;
+        static_assert(!has_empty_key(keys), "field keys must not be empty");
+        static_assert(!has_duplicate_key(keys), "field keys must be unique");
+
+        static constexpr field_table<keys.size()> table{ keys };
+        static_assert(has_empty_key(keys) || has_duplicate_key(keys) || table.built(),
+            "unable to build a perfect hash for the given field keys");
+    };
+} //namespace detail
+
+// Identifies a type among the alternatives of a variant independently of its position. Binary
+// adapters write the id, the JSON adapters write the name (as the key of a single-member object)
+struct type_tag
+{
+    std::uint32_t id{};
+    std::string_view name{};
+};
+
+// Assigns a type its type_tag. Types may declare one with EXTENSER_VARIANT_TAG, or this may be
+// specialized with a `value` of type type_tag. Variants whose alternatives are all tagged are
+// written with the tag of the held alternative rather than its index, so alternatives can be
+// added or reordered without breaking existing data
+template<typename T, typename = void>
+struct variant_tag
+{
+};
+
+template<typename T>
+struct variant_tag<T, std::void_t<decltype(T::extenser_variant_tag)>>
+{
+    static constexpr type_tag value = T::extenser_variant_tag;
+};
+
+#define EXTENSER_VARIANT_TAG(ID, NAME) \
+    static constexpr ::extenser::type_tag extenser_variant_tag { ID, NAME }
+
+namespace detail
+{
+    template<typename T, typename = void>
+    struct has_variant_tag : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct has_variant_tag<T, std::void_t<decltype(variant_tag<T>::value)>> : std::true_type
+    {
+    };
+
+    template<typename T>
+    struct is_tagged_variant : std::false_type
+    {
+    };
+
+    template<typename... Args>
+    struct is_tagged_variant<std::variant<Args...>> :
+        std::bool_constant<(has_variant_tag<Args>::value && ...)>
+    {
+    };
+
+    template<typename T>
+    inline constexpr bool is_tagged_variant_v = is_tagged_variant<remove_cvref_t<T>>::value;
+
+    struct tag_entry
+    {
+        std::uint32_t id{};
+        std::size_t index{};
+    };
+
+    template<std::size_t N>
+    [[nodiscard]] constexpr auto make_id_index(const std::array<type_tag, N>& tags) noexcept
+        -> std::array<tag_entry, N>
+    {
+        std::array<tag_entry, N> entries{};
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            auto j = i;
+
+            for (; j > 0 && entries[j - 1].id > tags[i].id; --j)
+            {
+                entries[j] = entries[j - 1];
+            }
+
+            entries[j] = { tags[i].id, i };
+        }
+
+        return entries;
+    }
+
+    template<std::size_t N>
+    [[nodiscard]] constexpr auto has_duplicate_id(
+        const std::array<tag_entry, N>& sorted_entries) noexcept -> bool
+    {
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            if (sorted_entries[i - 1].id == sorted_entries[i].id)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Maps the tags of a tagged variant's alternatives back to their indices: ids through a
+    // sorted table, names through a perfect hash, both built at compile time
+    template<typename Variant>
+    struct variant_tag_index;
+
+    template<typename... Args>
+    struct variant_tag_index<std::variant<Args...>>
+    {
+        static constexpr std::size_t npos = field_table_view::npos;
+        static constexpr std::size_t alt_count = sizeof...(Args);
+
+        static constexpr std::array<type_tag, alt_count> tags{ variant_tag<Args>::value... };
+        static constexpr std::array<std::string_view, alt_count> names{
+            variant_tag<Args>::value.name...
+        };
+
+        static constexpr auto by_id = make_id_index(tags);
+        static_assert(!has_duplicate_id(by_id), "variant tag ids must be unique");
+
+        static_assert(!has_empty_key(names), "variant tag names must not be empty");
+        static_assert(!has_duplicate_key(names), "variant tag names must be unique");
+        static constexpr field_table<alt_count> name_table{ names };
+        static_assert(has_empty_key(names) || has_duplicate_key(names) || name_table.built(),
+            "unable to build a perfect hash for the variant tag names");
+
+        [[nodiscard]] static constexpr auto find(const std::uint32_t id) noexcept -> std::size_t
+        {
+            std::size_t first = 0;
+            std::size_t last = alt_count;
+
+            while (first < last)
+            {
+                const auto mid = first + ((last - first) / 2);
+
+                if (by_id[mid].id < id)
+                {
+                    first = mid + 1;
+                }
+                else
+                {
+                    last = mid;
+                }
+            }
+
+            return (first < alt_count && by_id[first].id == id) ? by_id[first].index : npos;
+        }
+
+        [[nodiscard]] static constexpr auto find(const std::string_view name) noexcept
+            -> std::size_t
+        {
+            return name_table.find(name);
+        }
+    };
+} //namespace detail
+
 class extenser_exception : public std::runtime_error
 {
 public:
@@ -238,6 +607,38 @@ public:
     using extenser_exception::extenser_exception;
 };
 
+// The input ended before the value being read did. deserialize_from() reads more of the stream and
+// tries again, while any other deserialization_error fails at once
+class end_of_input_error : public deserialization_error
+{
+public:
+    using deserialization_error::deserialization_error;
+};
+
+enum class deserialization_errc : std::uint8_t
+{
+    ok,
+    type_mismatch, // A value does not have the type being read
+    missing_key, // An object has no member for a field
+    out_of_range, // A size, count or index does not fit the value being read
+    invalid_value, // A value has the right type, but is not one the value being read accepts
+    end_of_input, // The input ended before the value being read did
+    malformed, // The input could not be read, or an adapter reported the error by exception
+};
+
+// Outcome of try_deserialize_object(), path locates the failing value, e.g. "/friends/0/name"
+struct deserialization_result
+{
+    deserialization_errc code{ deserialization_errc::ok };
+    std::string path{};
+    std::string message{};
+
+    [[nodiscard]] explicit operator bool() const noexcept
+    {
+        return code == deserialization_errc::ok;
+    }
+};
+
 template<typename Derived>
 class generic_serializer
 {
@@ -336,14 +737,35 @@ protected:
 
 namespace detail
 {
+    // State of try_deserialize_object(), which only deserializers carry
+    template<bool Deserialize>
+    class soft_error_state
+    {
+    };
+
+    // Points at the result of the try_deserialize_object() call in progress, if any. Errors are
+    // recorded through the pointer, so deserializers with const accessors can report them too
+    template<>
+    class soft_error_state<true>
+    {
+    protected:
+        deserialization_result* m_p_result{ nullptr };
+
+#if defined(EXTENSER_HAS_EXCEPTIONS)
+        // Exceptions already in flight when the call began, those thrown past it are unwinding
+        int m_uncaught{};
+#endif
+    };
+
     template<typename Adapter, bool Deserialize>
-    class serializer_base : public generic_serializer<serializer_base<Adapter, Deserialize>>
+    class serializer_base :
+        public generic_serializer<serializer_base<Adapter, Deserialize>>,
+        private soft_error_state<Deserialize>
     {
     public:
         using serializer_t = std::conditional_t<Deserialize, typename Adapter::deserializer_t,
             typename Adapter::serializer_t>;
 
-        static constexpr std::size_t max_variant_size = 14;
         static constexpr bool is_deserializer = Deserialize;
         static constexpr bool is_serializer = !Deserialize;
 
@@ -356,6 +778,8 @@ namespace detail
             static_assert(!std::is_pointer_v<no_ref_t>,
                 "Cannot serialize a pointer directly, wrap it in a span or view");
 
+            EXTENSER_STATS_CALL();
+
             // Necessary for bi-directional serialization
             if constexpr (has_serialize_mem_v<no_ref_t>)
             {
@@ -378,6 +802,14 @@ namespace detail
             static_assert(!std::is_pointer_v<no_ref_t>,
                 "Cannot serialize a pointer directly, wrap it in a span or view");
 
+            EXTENSER_STATS_CALL();
+
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+            const scoped_resource resource_scope{ (m_p_resource != nullptr)
+                    ? m_p_resource
+                    : detail::current_resource() };
+#endif
+
             if constexpr (has_serialize_mem_v<no_ref_t>)
             {
                 std::forward<T>(val).serialize(*this);
@@ -388,8 +820,62 @@ namespace detail
             }
         }
 
+        // Like deserialize_object(), but reports failure in the result rather than by exception.
+        // Adapters that raise their errors through fail() are unwound without throwing, errors
+        // thrown by other adapters (or by serialize() functions) are caught once, here, with their
+        // path traced on the way
+        template<typename T>
+        [[nodiscard]] auto try_deserialize_object(T&& val) -> deserialization_result
+        {
+            static_assert(Deserialize, "Cannot call try_deserialize_object() on a serializer");
+
+            deserialization_result result{};
+            this->m_p_result = &result;
+
+#if defined(EXTENSER_HAS_EXCEPTIONS)
+            this->m_uncaught = std::uncaught_exceptions();
+
+            try
+            {
+                (static_cast<serializer_t*>(this))->deserialize_object(std::forward<T>(val));
+            }
+            catch (const std::exception& ex)
+            {
+                if (result.code == deserialization_errc::ok)
+                {
+                    result.code = deserialization_errc::malformed;
+                    result.message = ex.what();
+                }
+            }
+            catch (...)
+            {
+                this->m_p_result = nullptr;
+                throw;
+            }
+
+            // An exception an adapter caught itself may have left a path behind
+            if (result.code == deserialization_errc::ok)
+            {
+                result.path.clear();
+            }
+#else
+            (static_cast<serializer_t*>(this))->deserialize_object(std::forward<T>(val));
+#endif
+
+            this->m_p_result = nullptr;
+            return result;
+        }
+
         EXTENSER_INLINE void as_bool(const std::string_view key, bool& val)
         {
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_bool(key, val);
         }
 
@@ -397,6 +883,14 @@ namespace detail
         EXTENSER_INLINE void as_float(const std::string_view key, T& val)
         {
             static_assert(is_float_serializable<T>, "T must be a floating-point type");
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_float(key, val);
         }
 
@@ -404,6 +898,14 @@ namespace detail
         EXTENSER_INLINE void as_int(const std::string_view key, T& val)
         {
             static_assert(is_int_serializable<T>, "T must be a signed integral type");
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_int(key, val);
         }
 
@@ -411,6 +913,14 @@ namespace detail
         EXTENSER_INLINE void as_uint(const std::string_view key, T& val)
         {
             static_assert(is_uint_serializable<T>, "T must be an unsigned integral type");
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_uint(key, val);
         }
 
@@ -418,6 +928,14 @@ namespace detail
         EXTENSER_INLINE void as_enum(const std::string_view key, T& val)
         {
             static_assert(is_enum_serializable<T>, "T must be an enum type");
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_enum(key, val);
         }
 
@@ -425,6 +943,14 @@ namespace detail
         EXTENSER_INLINE void as_string(const std::string_view key, T& val)
         {
             //static_assert(is_string_serializable<T>, "T must be convertible to std::string_view");
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_string(key, val);
         }
 
@@ -433,6 +959,14 @@ namespace detail
         {
             static_assert(is_array_serializable<T>, "T must have begin() and end()");
 
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_array(key, val);
         }
 
@@ -442,6 +976,14 @@ namespace detail
             static_assert(
                 is_map_serializable<T> || is_multimap_serializable<T>, "T must be a map type");
 
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             if constexpr (is_multimap_serializable<T>)
             {
                 (static_cast<serializer_t*>(this))->as_multimap(key, val);
@@ -455,27 +997,56 @@ namespace detail
         template<typename T1, typename T2>
         EXTENSER_INLINE void as_tuple(const std::string_view key, std::pair<T1, T2>& val)
         {
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_tuple(key, val);
         }
 
         template<typename... Args>
         EXTENSER_INLINE void as_tuple(const std::string_view key, std::tuple<Args...>& val)
         {
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_tuple(key, val);
         }
 
         template<typename T>
         EXTENSER_INLINE void as_optional(const std::string_view key, std::optional<T>& val)
         {
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_optional(key, val);
         }
 
         template<typename... Args>
         EXTENSER_INLINE void as_variant(const std::string_view key, std::variant<Args...>& val)
         {
-            static_assert(
-                sizeof...(Args) < max_variant_size, "arg count can't exceed max_variant_size");
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
 
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_variant(key, val);
         }
 
@@ -483,13 +1054,166 @@ namespace detail
         EXTENSER_INLINE void as_object(const std::string_view key, T& val)
         {
             static_assert(is_object_serializable<T>, "serialize function for T could not be found");
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_object(key, val);
         }
 
         EXTENSER_INLINE void as_null(const std::string_view key)
         {
+            EXTENSER_STATS_NODE();
+
+            if (skip_field())
+            {
+                return;
+            }
+
+            const path_guard trace{ *this, key };
             (static_cast<serializer_t*>(this))->as_null(key);
         }
+
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+        // Allocator-aware values created by this deserializer allocate from p_resource, see
+        // scoped_resource. nullptr (the default) defers to any enclosing scoped_resource
+        void set_memory_resource(std::pmr::memory_resource* const p_resource) noexcept
+        {
+            static_assert(Deserialize, "Only a deserializer creates values");
+            m_p_resource = p_resource;
+        }
+
+        [[nodiscard]] auto memory_resource() const noexcept -> std::pmr::memory_resource*
+        {
+            return m_p_resource;
+        }
+
+    private:
+        std::pmr::memory_resource* m_p_resource{ nullptr };
+#endif
+
+    protected:
+        // Throws a deserialization_error (an end_of_input_error for end_of_input), unless called
+        // under try_deserialize_object(), where the first error is recorded instead. The adapter
+        // then returns as it would on success, and every remaining field is skipped. Without
+        // exceptions, an error outside try_deserialize_object() aborts
+        void fail(const deserialization_errc code, std::string message) const
+        {
+            static_assert(Deserialize, "Only a deserializer reports deserialization errors");
+
+            if (this->m_p_result == nullptr)
+            {
+                if (code == deserialization_errc::end_of_input)
+                {
+                    EXTENSER_THROW(end_of_input_error{ message });
+                }
+
+                EXTENSER_THROW(deserialization_error{ message });
+            }
+
+            if (this->m_p_result->code == deserialization_errc::ok)
+            {
+                this->m_p_result->code = code;
+                this->m_p_result->message = std::move(message);
+            }
+        }
+
+        [[nodiscard]] EXTENSER_INLINE auto failed() const noexcept -> bool
+        {
+            if constexpr (Deserialize)
+            {
+                return this->m_p_result != nullptr
+                    && this->m_p_result->code != deserialization_errc::ok;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        // Prefixes the path of an error that leaves its scope with a field's key or an element's
+        // index: recorded by fail(), or thrown under try_deserialize_object()
+        class path_guard
+        {
+        public:
+            EXTENSER_INLINE path_guard(
+                const serializer_base& ser, const std::string_view key) noexcept
+                : m_ser(ser), m_key(key)
+            {
+            }
+
+            EXTENSER_INLINE path_guard(const serializer_base& ser, const std::size_t index) noexcept
+                : m_ser(ser), m_index(index)
+            {
+            }
+
+            path_guard(const path_guard&) = delete;
+            path_guard(path_guard&&) = delete;
+            auto operator=(const path_guard&) -> path_guard& = delete;
+            auto operator=(path_guard&&) -> path_guard& = delete;
+
+            EXTENSER_INLINE ~path_guard() noexcept
+            {
+                if constexpr (Deserialize)
+                {
+                    if (m_ser.m_p_result != nullptr && (m_ser.failed() || m_ser.unwinding()))
+                    {
+                        trace();
+                    }
+                }
+            }
+
+        private:
+            void trace() const noexcept
+            {
+#if defined(EXTENSER_HAS_EXCEPTIONS)
+                try
+                {
+#endif
+                    auto& path = m_ser.m_p_result->path;
+
+                    if (m_index != npos)
+                    {
+                        path.insert(0, std::to_string(m_index)).insert(0, 1, '/');
+                    }
+                    else if (!m_key.empty())
+                    {
+                        path.insert(0, m_key).insert(0, 1, '/');
+                    }
+#if defined(EXTENSER_HAS_EXCEPTIONS)
+                }
+                catch (...)
+                {
+                    // Leaves the path incomplete rather than losing the error
+                }
+#endif
+            }
+
+            static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+            const serializer_base& m_ser;
+            std::string_view m_key{};
+            std::size_t m_index{ npos };
+        };
+
+    private:
+        [[nodiscard]] EXTENSER_INLINE auto skip_field() const noexcept -> bool
+        {
+            return failed();
+        }
+
+        [[nodiscard]] auto unwinding() const noexcept -> bool
+        {
+#if defined(EXTENSER_HAS_EXCEPTIONS)
+            return std::uncaught_exceptions() > this->m_uncaught;
+#else
+            return false;
+#endif
+        }
     };
 
     // Overloads for common types
@@ -653,6 +1377,33 @@ namespace detail
     }
 } //namespace detail
 
+namespace detail
+{
+    template<typename Adapter, typename = void>
+    struct has_size_counter : std::false_type
+    {
+    };
+
+    template<typename Adapter>
+    struct has_size_counter<Adapter, std::void_t<typename Adapter::size_counter_t>> :
+        std::true_type
+    {
+    };
+} //namespace detail
+
+// Computes the exact number of bytes val serializes to, without producing any output. Requires
+// the adapter to provide a size_counter_t serializer
+template<typename Adapter, typename T>
+[[nodiscard]] auto serialized_size(const T& val) -> std::size_t
+{
+    static_assert(detail::has_size_counter<Adapter>::value,
+        "Adapter does not support size precomputation (no size_counter_t)");
+
+    typename Adapter::size_counter_t counter{};
+    counter.serialize_object(val);
+    return counter.size();
+}
+
 template<typename Adapter>
 class easy_serializer
 {
@@ -680,11 +1431,30 @@ public:
     [[nodiscard]] static auto quick_deserialize(const serial_t& serial) -> T
     {
         deserializer_t des{ serial };
-        T t;
+        auto t = detail::make_value<T>();
         des.deserialize_object(t);
         return t;
     }
 
+    template<typename T>
+    [[nodiscard]] static auto try_deserialize(const serial_t& serial, T& val)
+        -> deserialization_result
+    {
+        deserializer_t des{ serial };
+        return des.try_deserialize_object(val);
+    }
+
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+    // Deserializes a T whose allocator-aware parts (including T itself) allocate from p_resource
+    template<typename T, std::enable_if_t<std::is_default_constructible_v<T>, bool> = true>
+    [[nodiscard]] static auto quick_deserialize(
+        const serial_t& serial, std::pmr::memory_resource* const p_resource) -> T
+    {
+        const scoped_resource resource_scope{ p_resource };
+        return quick_deserialize<T>(serial);
+    }
+#endif
+
     easy_serializer() : m_deserializer(m_serializer.object()) {}
 
     explicit easy_serializer(const serial_t& serial)
@@ -707,7 +1477,7 @@ public:
     template<typename T, std::enable_if_t<std::is_default_constructible_v<T>, bool> = true>
     [[nodiscard]] auto deserialize_object() -> T
     {
-        T t;
+        auto t = detail::make_value<T>();
         m_deserializer.deserialize_object(t);
         return t;
     }
@@ -10,33 +10,25 @@
 #ifndef EXTENSER_JSON_HPP
 #define EXTENSER_JSON_HPP
 
-#include <extenser/extenser.hpp>
+#include "extenser_json_common.hpp"
 
-#if defined(EXTENSER_USE_MAGIC_ENUM)
-#  if defined(__GNUC__) && !defined(__clang__)
-#    pragma GCC diagnostic push
-#    pragma GCC diagnostic ignored "-Wconversion"
-#    include <magic_enum/magic_enum.hpp>
-#    pragma GCC diagnostic pop
-#  else
-#    include <magic_enum/magic_enum.hpp>
-#  endif
-#endif
+#include <extenser/extenser.hpp>
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
-
-#ifndef EXTENSER_NO_RTTI
-#  include <typeinfo>
-#endif
+#include <vector>
 
 namespace extenser
 {
@@ -51,6 +43,20 @@ namespace detail
 
 namespace detail_json
 {
+    template<>
+    struct raw_json<nlohmann::json> : std::true_type
+    {
+        static void dump(const nlohmann::json& val, std::string& out)
+        {
+            out.append(val.dump());
+        }
+
+        static void parse(const std::string_view text, nlohmann::json& val)
+        {
+            val = nlohmann::json::parse(text);
+        }
+    };
+
     class serializer;
     class deserializer;
 
@@ -63,6 +69,62 @@ namespace detail_json
         using config = void;
     };
 
+    // Map keys that are integers (or, without magic_enum, enums) are written as '@' followed by
+    // their decimal digits, formatted and parsed directly rather than through nlohmann::json
+    template<typename T, typename = void>
+    struct key_int
+    {
+        using type = T;
+    };
+
+    template<typename T>
+    struct key_int<T, std::enable_if_t<std::is_enum_v<T>>>
+    {
+        using type = std::underlying_type_t<T>;
+    };
+
+    template<typename T>
+    using key_int_t = typename key_int<T>::type;
+
+    template<typename T>
+    inline constexpr bool is_int_key_v =
+#if defined(EXTENSER_USE_MAGIC_ENUM)
+        !std::is_enum_v<T> &&
+#endif
+        std::is_integral_v<key_int_t<T>> && !std::is_same_v<key_int_t<T>, bool>
+        && !std::is_same_v<key_int_t<T>, wchar_t> && !std::is_same_v<key_int_t<T>, char16_t>
+        && !std::is_same_v<key_int_t<T>, char32_t>
+#if defined(__cpp_char8_t)
+        && !std::is_same_v<key_int_t<T>, char8_t>
+#endif
+        ;
+
+    template<typename T>
+    [[nodiscard]] constexpr auto to_key_int(const T key) noexcept -> key_int_t<T>
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            return static_cast<key_int_t<T>>(key);
+        }
+        else
+        {
+            return key;
+        }
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr auto from_key_int(const key_int_t<T> num) noexcept -> T
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            return static_cast<T>(num);
+        }
+        else
+        {
+            return num;
+        }
+    }
+
     class serializer : public detail::serializer_base<serial_adapter, false>
     {
     public:
@@ -83,6 +145,37 @@ namespace detail_json
             return std::move(m_json);
         }
 
+        // Used by serialize_parallel(): each chunk of a split array is built as an array of just
+        // its elements, then splice_array() moves the chunks' elements into one array
+        template<typename It>
+        void serialize_elements(It first, const It last)
+        {
+            m_json = nlohmann::json::array();
+
+            auto& arr = m_json.get_ref<nlohmann::json::array_t&>();
+            arr.reserve(static_cast<std::size_t>(std::distance(first, last)));
+
+            for (; first != last; ++first)
+            {
+                push_arg(*first, arr.emplace_back());
+            }
+        }
+
+        template<typename T>
+        void splice_array(const T& val, std::vector<nlohmann::json>& chunks)
+        {
+            m_json = nlohmann::json::array();
+
+            auto& arr = m_json.get_ref<nlohmann::json::array_t&>();
+            arr.reserve(containers::adapter<T>::size(val));
+
+            for (auto& chunk : chunks)
+            {
+                auto& elems = chunk.get_ref<nlohmann::json::array_t&>();
+                std::move(elems.begin(), elems.end(), std::back_inserter(arr));
+            }
+        }
+
         void as_bool(const std::string_view key, const bool val) noexcept
         {
             push_simple_type(val, subobject(key));
@@ -204,10 +297,10 @@ namespace detail_json
 #if defined(EXTENSER_USE_MAGIC_ENUM)
             if (!magic_enum::enum_contains<no_ref_t>(arg))
             {
-                throw serialization_error{ std::string{ "Invalid enum value: " }
+                EXTENSER_THROW(serialization_error{ std::string{ "Invalid enum value: " }
                         .append(std::to_string(static_cast<std::underlying_type_t<no_ref_t>>(arg)))
                         .append(" for type: ")
-                        .append(magic_enum::enum_type_name<no_ref_t>()) };
+                        .append(magic_enum::enum_type_name<no_ref_t>()) });
             }
 
             push_string(magic_enum::enum_name<no_ref_t>(arg), obj);
@@ -224,14 +317,18 @@ namespace detail_json
         static void push_string(const std::u8string_view arg, nlohmann::json& obj) { obj = arg; }
 #endif
 
+        // Elements are built in place, in an array sized up front
         template<typename T>
         static void push_array(T&& arg, nlohmann::json& obj)
         {
             obj = nlohmann::json::array();
 
+            auto& arr = obj.get_ref<nlohmann::json::array_t&>();
+            arr.reserve(containers::adapter<detail::remove_cvref_t<T>>::size(arg));
+
             for (const auto& subval : std::forward<T>(arg))
             {
-                push_args(subval, obj);
+                push_arg(subval, arr.emplace_back());
             }
         }
 
@@ -249,21 +346,31 @@ namespace detail_json
             }
         }
 
+        // Values sharing a key are contiguous in std::multimap and std::unordered_multimap alike,
+        // so the key is stringized, looked up and its array sized once per group, not per value
         template<typename T>
         static void push_multimap(T&& arg, nlohmann::json& obj)
         {
             obj = nlohmann::json::object();
 
-            for (const auto& [k, v] : std::forward<T>(arg))
+            for (auto it = std::cbegin(arg); it != std::cend(arg);)
             {
-                const std::string key_str = stringize_key(k);
+                const auto [first, last] = arg.equal_range(it->first);
+                nlohmann::json& group =
+                    obj.emplace(stringize_key(it->first), nullptr).first.value();
 
-                if (obj.find(key_str) == end(obj))
+                if (!group.is_array())
                 {
-                    obj[key_str] = nlohmann::json::array();
+                    group = nlohmann::json::array();
                 }
 
-                push_args(v, obj[key_str]);
+                auto& arr = group.get_ref<nlohmann::json::array_t&>();
+                arr.reserve(arr.size() + static_cast<std::size_t>(std::distance(first, last)));
+
+                for (it = first; it != last; ++it)
+                {
+                    push_arg(it->second, arr.emplace_back());
+                }
             }
         }
 
@@ -271,6 +378,7 @@ namespace detail_json
         static void push_pair(const std::pair<T1, T2>& arg, nlohmann::json& obj)
         {
             obj = nlohmann::json::array();
+            obj.get_ref<nlohmann::json::array_t&>().reserve(2);
             push_args(arg.first, obj);
             push_args(arg.second, obj);
         }
@@ -279,6 +387,7 @@ namespace detail_json
         static void push_tuple(const std::tuple<Args...>& arg, nlohmann::json& obj)
         {
             obj = nlohmann::json::array();
+            obj.get_ref<nlohmann::json::array_t&>().reserve(sizeof...(Args));
             detail::for_each_tuple(
                 arg, [&obj](auto&& elem) { push_args(std::forward<decltype(elem)>(elem), obj); });
         }
@@ -299,11 +408,25 @@ namespace detail_json
         template<typename... Args>
         static void push_variant(const std::variant<Args...>& arg, nlohmann::json& obj)
         {
-            obj["v_idx"] = arg.index();
-            auto& var_val = obj["v_val"];
+            using variant_t = std::variant<Args...>;
+
+            if constexpr (detail::is_tagged_variant_v<variant_t>)
+            {
+                const auto& tag = detail::variant_tag_index<variant_t>::tags[arg.index()];
+                obj = nlohmann::json::object();
+                auto& var_val = obj[tag.name];
+
+                std::visit([&var_val](auto&& l_val)
+                    { push_arg(std::forward<decltype(l_val)>(l_val), var_val); }, arg);
+            }
+            else
+            {
+                obj["v_idx"] = arg.index();
+                auto& var_val = obj["v_val"];
 
-            std::visit([&var_val](auto&& l_val)
-                { push_arg(std::forward<decltype(l_val)>(l_val), var_val); }, arg);
+                std::visit([&var_val](auto&& l_val)
+                    { push_arg(std::forward<decltype(l_val)>(l_val), var_val); }, arg);
+            }
         }
 
         template<typename T>
@@ -317,23 +440,35 @@ namespace detail_json
         template<typename T>
         static auto stringize_key(T&& key_arg) -> std::string
         {
-            nlohmann::json key_obj{};
-            push_arg(std::forward<T>(key_arg), key_obj);
-
-            if (!key_obj.is_string())
+            if constexpr (is_int_key_v<detail::remove_cvref_t<T>>)
             {
-                return "@" + key_obj.dump();
+                std::array<char, 24> chars{ '@' };
+                const auto result = std::to_chars(
+                    chars.data() + 1, chars.data() + chars.size(), to_key_int(key_arg));
+
+                EXTENSER_POSTCONDITION(result.ec == std::errc{});
+                return { chars.data(), static_cast<std::size_t>(result.ptr - chars.data()) };
             }
+            else
+            {
+                nlohmann::json key_obj{};
+                push_arg(std::forward<T>(key_arg), key_obj);
 
-            auto key_str = key_obj.get<std::string>();
+                if (!key_obj.is_string())
+                {
+                    return "@" + key_obj.dump();
+                }
 
-            if (!key_str.empty() && key_str.front() == '@')
-            {
-                // Escape '@' at front of string
-                key_str.insert(key_str.begin(), '@');
-            }
+                auto key_str = key_obj.get<std::string>();
 
-            return key_str;
+                if (!key_str.empty() && key_str.front() == '@')
+                {
+                    // Escape '@' at front of string
+                    key_str.insert(key_str.begin(), '@');
+                }
+
+                return key_str;
+            }
         }
 
         template<typename T>
@@ -357,10 +492,6 @@ namespace detail_json
             {
                 push_string(std::forward<T>(arg), obj);
             }
-            else if constexpr (is_array_serializable<no_ref_t>)
-            {
-                push_array(std::forward<T>(arg), obj);
-            }
             else if constexpr (is_multimap_serializable<no_ref_t>)
             {
                 push_multimap(std::forward<T>(arg), obj);
@@ -369,6 +500,10 @@ namespace detail_json
             {
                 push_map(std::forward<T>(arg), obj);
             }
+            else if constexpr (is_array_serializable<no_ref_t>)
+            {
+                push_array(std::forward<T>(arg), obj);
+            }
             else if constexpr (is_optional_serializable<no_ref_t>)
             {
                 push_optional(arg, obj);
@@ -397,9 +532,7 @@ namespace detail_json
         template<typename T>
         static void push_args(T&& arg, nlohmann::json& obj_arr)
         {
-            nlohmann::json tmp{};
-            push_arg(std::forward<T>(arg), tmp);
-            obj_arr.push_back(std::move(tmp));
+            push_arg(std::forward<T>(arg), obj_arr.emplace_back());
         }
 
         nlohmann::json m_json{};
@@ -410,71 +543,53 @@ namespace detail_json
     public:
         explicit deserializer(const nlohmann::json& obj) noexcept : m_p_json(&obj) {}
 
-        void as_bool(const std::string_view key, bool& val) const
+        template<typename T>
+        void deserialize_object(T&& val)
         {
-            try
-            {
-                val = subobject(key).get<bool>();
-            }
-            catch (const deserialization_error&)
-            {
-                throw;
-            }
-            catch (const std::exception& ex)
+            parse_nested(*m_p_json, val);
+        }
+
+        // Used by deserialize_parallel(), the elements of a top-level array are found by index, so
+        // each thread parses a slice of them with its own deserializer
+        [[nodiscard]] auto array_size() const noexcept -> std::size_t
+        {
+            return m_p_json->is_array() ? m_p_json->size() : 0;
+        }
+
+        template<typename It>
+        void deserialize_elements(It first, const It last, std::size_t index) const
+        {
+            using value_t = typename std::iterator_traits<It>::value_type;
+
+            const nlohmann::json& arr = *m_p_json;
+
+            for (; first != last; ++first, ++index)
             {
-                throw deserialization_error{ ex.what() };
+                *first = parse_element<value_t>(arr[index], index);
             }
         }
 
+        void as_bool(const std::string_view key, bool& val) const
+        {
+            parse_scalar(key, val);
+        }
+
         template<typename T>
         void as_float(const std::string_view key, T& val) const
         {
-            try
-            {
-                val = subobject(key).get<T>();
-            }
-            catch (const deserialization_error&)
-            {
-                throw;
-            }
-            catch (const std::exception& ex)
-            {
-                throw deserialization_error{ ex.what() };
-            }
+            parse_scalar(key, val);
         }
 
         template<typename T>
         void as_int(const std::string_view key, T& val) const
         {
-            try
-            {
-                val = subobject(key).get<T>();
-            }
-            catch (const deserialization_error&)
-            {
-                throw;
-            }
-            catch (const std::exception& ex)
-            {
-                throw deserialization_error{ ex.what() };
-            }
+            parse_scalar(key, val);
         }
 
         template<typename T>
         void as_uint(const std::string_view key, T& val) const
         {
-            try
-            {
-                val = subobject(key).get<T>();
-            }
-            catch (const deserialization_error&)
-            {
-                throw;
-            }
-            catch (const std::exception& ex)
-            {
-                throw deserialization_error{ ex.what() };
-            }
+            parse_scalar(key, val);
         }
 
         template<typename T>
@@ -482,39 +597,45 @@ namespace detail_json
         {
             static_assert(std::is_enum_v<T>, "T must be an enum type");
 
-            try
-            {
 #if defined(EXTENSER_USE_MAGIC_ENUM)
-                auto result = magic_enum::enum_cast<T>(subobject(key).get<std::string>());
+            const auto* const p_obj = subobject(key);
 
-                if (!result.has_value())
-                {
-                    throw deserialization_error{ std::string{ "Invalid enum value: \"" }
-                            .append(subobject(key).get<std::string>())
-                            .append("\" for type: ")
-                            .append(magic_enum::enum_type_name<T>()) };
-                }
-
-                val = *result;
-#else
-                val = static_cast<T>(subobject(key).get<std::underlying_type_t<T>>());
-#endif
+            if (p_obj == nullptr)
+            {
+                return;
             }
-            catch (const deserialization_error&)
+
+            if (!p_obj->is_string())
             {
-                throw;
+                fail_type("string", *p_obj);
+                return;
             }
-            catch (const std::exception& ex)
+
+            const auto& name = p_obj->get_ref<const nlohmann::json::string_t&>();
+            const auto result = magic_enum::enum_cast<T>(name);
+
+            if (!result.has_value())
             {
-                throw deserialization_error{ ex.what() };
+                fail(deserialization_errc::invalid_value,
+                    std::string{ "Invalid enum value: \"" }
+                        .append(name)
+                        .append("\" for type: ")
+                        .append(magic_enum::enum_type_name<T>()));
+                return;
             }
+
+            val = *result;
+#else
+            std::underlying_type_t<T> num{};
+            parse_scalar(key, num);
+            val = static_cast<T>(num);
+#endif
         }
 
         template<typename T>
         void as_string(const std::string_view key, T& val) const
         {
             using traits_t = containers::traits<T>;
-            using adapter_t = containers::adapter<T>;
 
             if constexpr (std::is_array_v<T>)
             {
@@ -523,65 +644,32 @@ namespace detail_json
             }
             else if constexpr (std::is_same_v<T, std::string>)
             {
-                try
+                const auto* const p_obj = subobject(key);
+
+                if (p_obj == nullptr)
                 {
-                    val = subobject(key).get<std::string>();
+                    return;
                 }
-                catch (const deserialization_error&)
+
+                if (!p_obj->is_string())
                 {
-                    throw;
+                    fail_type("string", *p_obj);
+                    return;
                 }
-                catch (const std::exception& ex)
+
+                val = p_obj->get_ref<const nlohmann::json::string_t&>();
+            }
+            else if constexpr (traits_t::is_mutable)
+            {
+                if (const auto* const p_obj = subobject(key); p_obj != nullptr)
                 {
-                    throw deserialization_error{ ex.what() };
+                    parse_stringlike(*p_obj, val);
                 }
             }
             else
             {
-                if constexpr (traits_t::is_mutable)
-                {
-                    const auto& sub_obj = subobject(key);
-
-                    if (!sub_obj.is_string() && !sub_obj.is_array())
-                    {
-                        throw deserialization_error{ "JSON error: expected string-like type" };
-                    }
-
-                    if constexpr (std::is_same_v<typename traits_t::value_type, char>)
-                    {
-                        const auto str = sub_obj.get<std::string>();
-
-                        if constexpr (traits_t::has_fixed_size)
-                        {
-                            if (str.size() > adapter_t::size(val))
-                            {
-                                throw deserialization_error{ "JSON error: array out of bounds" };
-                            }
-                        }
-
-                        adapter_t::assign_from_range(val, str.cbegin(), str.cend(), [](const char c)
-                            { return static_cast<typename traits_t::value_type>(c); });
-                    }
-                    else
-                    {
-                        if constexpr (traits_t::has_fixed_size)
-                        {
-                            if (sub_obj.size() > adapter_t::size(val))
-                            {
-                                throw deserialization_error{ "JSON error: array out of bounds" };
-                            }
-                        }
-
-                        adapter_t::assign_from_range(val, sub_obj.begin(), sub_obj.end(),
-                            [](const nlohmann::json& sub_val)
-                            { return sub_val.get<typename traits_t::value_type>(); });
-                    }
-                }
-                else
-                {
-                    std::ignore = key;
-                    std::ignore = val;
-                }
+                std::ignore = key;
+                std::ignore = val;
             }
         }
 
@@ -593,27 +681,41 @@ namespace detail_json
 
             if constexpr (traits_t::is_mutable)
             {
-                const auto& arr = subobject(key);
+                const auto* const p_arr = subobject(key);
+
+                if (p_arr == nullptr)
+                {
+                    return;
+                }
+
+                const auto& arr = *p_arr;
 
                 if constexpr (traits_t::has_fixed_size)
                 {
                     if (arr.size() != adapter_t::size(val))
                     {
-                        throw deserialization_error{ "JSON error: array out of bounds" };
+                        fail(deserialization_errc::out_of_range, "JSON error: array out of bounds");
+                        return;
                     }
                 }
 
+                std::size_t index = 0;
+
                 if constexpr (traits_t::is_sequential)
                 {
-                    adapter_t::assign_from_range(
-                        val, arr.cbegin(), arr.cend(), parse_arg<typename traits_t::value_type>);
+                    adapter_t::assign_from_range(val, arr.cbegin(), arr.cend(),
+                        [this, &index](const nlohmann::json& j_obj)
+                        { return parse_element<typename traits_t::value_type>(j_obj, index++); });
                 }
                 else
                 {
                     for (const auto& j_obj : arr)
                     {
-                        adapter_t::insert_value(
-                            val, j_obj, parse_arg<typename traits_t::value_type>);
+                        adapter_t::insert_value(val, j_obj,
+                            [this, &index](const nlohmann::json& elem) {
+                                return parse_element<typename traits_t::value_type>(
+                                    elem, index++);
+                            });
                     }
                 }
             }
@@ -632,12 +734,28 @@ namespace detail_json
             using traits_t = containers::traits<T>;
             using adapter_t = containers::adapter<T>;
 
-            const auto& obj = subobject(key);
+            const auto* const p_obj = subobject(key);
+
+            if (p_obj == nullptr)
+            {
+                return;
+            }
 
-            for (const auto& [k, v] : obj.items())
+            for (const auto& [k, v] : p_obj->items())
             {
+                const path_guard trace{ *this, k };
+
                 adapter_t::insert_value(val, std::make_pair(k, v),
-                    parse_kv_pair<typename traits_t::key_type, typename traits_t::mapped_type>);
+                    [this](const std::pair<std::string, nlohmann::json>& kv_pair)
+                    {
+                        return parse_kv_pair<typename traits_t::key_type,
+                            typename traits_t::mapped_type>(kv_pair);
+                    });
+
+                if (failed())
+                {
+                    return;
+                }
             }
         }
 
@@ -649,14 +767,30 @@ namespace detail_json
             using traits_t = containers::traits<T>;
             using adapter_t = containers::adapter<T>;
 
-            const auto& obj = subobject(key);
+            const auto* const p_obj = subobject(key);
+
+            if (p_obj == nullptr)
+            {
+                return;
+            }
 
-            for (const auto& [k, v] : obj.items())
+            for (const auto& [k, v] : p_obj->items())
             {
+                const path_guard trace{ *this, k };
+
                 for (const auto& subval : v)
                 {
                     adapter_t::insert_value(val, std::make_pair(k, subval),
-                        parse_kv_pair<typename traits_t::key_type, typename traits_t::mapped_type>);
+                        [this](const std::pair<std::string, nlohmann::json>& kv_pair)
+                        {
+                            return parse_kv_pair<typename traits_t::key_type,
+                                typename traits_t::mapped_type>(kv_pair);
+                        });
+
+                    if (failed())
+                    {
+                        return;
+                    }
                 }
             }
         }
@@ -664,198 +798,339 @@ namespace detail_json
         template<typename T1, typename T2>
         void as_tuple(const std::string_view key, std::pair<T1, T2>& val) const
         {
-            const auto& obj = subobject(key);
-            val = { parse_arg<T1>(obj.at(0)), parse_arg<T2>(obj.at(1)) };
+            const auto* const p_obj = subobject(key);
+
+            if (p_obj == nullptr)
+            {
+                return;
+            }
+
+            if (!p_obj->is_array())
+            {
+                fail_type("array", *p_obj);
+                return;
+            }
+
+            if (p_obj->size() < 2)
+            {
+                fail(deserialization_errc::out_of_range, "JSON error: invalid number of args");
+                return;
+            }
+
+            val = { parse_arg<T1>((*p_obj)[0]), parse_arg<T2>((*p_obj)[1]) };
         }
 
         template<typename... Args>
         void as_tuple(const std::string_view key, std::tuple<Args...>& val) const
         {
-            const auto& obj = subobject(key);
+            const auto* const p_obj = subobject(key);
+
+            if (p_obj == nullptr)
+            {
+                return;
+            }
 
-            if (obj.size() != sizeof...(Args))
+            if (p_obj->size() != sizeof...(Args))
             {
-                throw deserialization_error{ "JSON error: invalid number of args" };
+                fail(deserialization_errc::out_of_range, "JSON error: invalid number of args");
+                return;
             }
 
             [[maybe_unused]] std::size_t arg_counter = 0;
-            val = { parse_args<Args>(obj, arg_counter)... };
+            val = { parse_args<Args>(*p_obj, arg_counter)... };
         }
 
         template<typename T>
         void as_optional(const std::string_view key, std::optional<T>& val) const
         {
-            const auto& obj = subobject(key);
-            val = obj.is_null() ? std::optional<T>{ std::nullopt }
-                                : std::optional<T>{ std::in_place, parse_arg<T>(obj) };
+            const auto* const p_obj = subobject(key);
+
+            if (p_obj == nullptr)
+            {
+                return;
+            }
+
+            val = p_obj->is_null() ? std::optional<T>{ std::nullopt }
+                                   : std::optional<T>{ std::in_place, parse_arg<T>(*p_obj) };
         }
 
         template<typename... Args>
         void as_variant(const std::string_view key, std::variant<Args...>& val) const
         {
+            using variant_t = std::variant<Args...>;
             static constexpr std::size_t arg_sz = sizeof...(Args);
-            static_assert(arg_sz <= max_variant_size, "Variant limit reached");
 
-            const auto& obj = subobject(key);
-            const auto v_idx = obj.at("v_idx").get<std::size_t>();
+            const auto* const p_obj = subobject(key);
 
-            if (v_idx >= arg_sz)
+            if (p_obj == nullptr)
             {
-                throw deserialization_error{
-                    std::string{ "JSON error: variant index exceeded variant size: " }.append(
-                        std::to_string(arg_sz))
-                };
+                return;
             }
 
-            // TODO: Cleanup and move to serial-agnostic code
-            switch (v_idx)
+            const auto& obj = *p_obj;
+            const nlohmann::json* p_v_val = nullptr;
+            std::size_t v_idx = 0;
+
+            if constexpr (detail::is_tagged_variant_v<variant_t>)
             {
-                case 0:
-                    val = parse_arg<decltype(std::get<0>(val))>(obj.at("v_val"));
-                    return;
+                using index_t = detail::variant_tag_index<variant_t>;
 
-                case 1:
-                    if constexpr (arg_sz > 1)
-                    {
-                        val = parse_arg<decltype(std::get<1>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                if (!obj.is_object() || obj.size() != 1)
+                {
+                    fail(deserialization_errc::type_mismatch,
+                        "JSON error: a tagged variant must be an object with a single member");
+                    return;
+                }
 
-                case 2:
-                    if constexpr (arg_sz > 2)
-                    {
-                        val = parse_arg<decltype(std::get<2>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                const auto member = obj.cbegin();
+                v_idx = index_t::find(std::string_view{ member.key() });
 
-                case 3:
-                    if constexpr (arg_sz > 3)
-                    {
-                        val = parse_arg<decltype(std::get<3>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                if (v_idx == index_t::npos)
+                {
+                    fail(deserialization_errc::invalid_value,
+                        std::string{ "JSON error: unknown variant tag: " }.append(member.key()));
+                    return;
+                }
 
-                case 4:
-                    if constexpr (arg_sz > 4)
-                    {
-                        val = parse_arg<decltype(std::get<4>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                p_v_val = &member.value();
+            }
+            else
+            {
+                if (!obj.is_object())
+                {
+                    fail_type("object", obj);
+                    return;
+                }
 
-                case 5:
-                    if constexpr (arg_sz > 5)
-                    {
-                        val = parse_arg<decltype(std::get<5>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                const auto idx_it = obj.find("v_idx");
+                const auto val_it = obj.find("v_val");
 
-                case 6:
-                    if constexpr (arg_sz > 6)
-                    {
-                        val = parse_arg<decltype(std::get<6>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                if (idx_it == obj.cend() || val_it == obj.cend())
+                {
+                    fail(deserialization_errc::missing_key,
+                        std::string{ "JSON error: key '" }
+                            .append(idx_it == obj.cend() ? "v_idx" : "v_val")
+                            .append("' not found"));
+                    return;
+                }
 
-                case 7:
-                    if constexpr (arg_sz > 7)
-                    {
-                        val = parse_arg<decltype(std::get<7>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                if (!is_scalar<std::size_t>(*idx_it))
+                {
+                    fail_type("number", *idx_it);
+                    return;
+                }
 
-                case 8:
-                    if constexpr (arg_sz > 8)
-                    {
-                        val = parse_arg<decltype(std::get<8>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                v_idx = idx_it->get<std::size_t>();
 
-                case 9:
-                    if constexpr (arg_sz > 9)
-                    {
-                        val = parse_arg<decltype(std::get<9>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                if (v_idx >= arg_sz)
+                {
+                    fail(deserialization_errc::out_of_range,
+                        std::string{ "JSON error: variant index exceeded variant size: " }.append(
+                            std::to_string(arg_sz)));
+                    return;
+                }
 
-                case 10:
-                    if constexpr (arg_sz > 10)
-                    {
-                        val = parse_arg<decltype(std::get<10>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+                p_v_val = &*val_it;
+            }
 
-                case 11:
-                    if constexpr (arg_sz > 11)
-                    {
-                        val = parse_arg<decltype(std::get<11>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+            const auto& v_val = *p_v_val;
 
-                case 12:
-                    if constexpr (arg_sz > 12)
-                    {
-                        val = parse_arg<decltype(std::get<12>(val))>(obj.at("v_val"));
-                        return;
-                    }
-                    [[fallthrough]];
+            detail::visit_index<variant_t>(v_idx,
+                [this, &v_val, &val](auto idx_constant)
+                {
+                    static constexpr std::size_t alt_idx = decltype(idx_constant)::value;
+                    val.template emplace<alt_idx>(
+                        parse_arg<std::variant_alternative_t<alt_idx, variant_t>>(v_val));
+                });
+        }
+
+        void as_object(const std::string_view key, nlohmann::json& val) const
+        {
+            if (const auto* const p_obj = subobject(key); p_obj != nullptr)
+            {
+                val = *p_obj;
+            }
+        }
 
-                case 13:
-                    if constexpr (arg_sz > 13)
+        template<typename T>
+        void as_object(const std::string_view key, T& val) const
+        {
+            if (const auto* const p_obj = subobject(key); p_obj != nullptr)
+            {
+                parse_arg_inplace<T>(*p_obj, val);
+            }
+        }
+
+        void as_null([[maybe_unused]] const std::string_view key) const
+        {
+            [[maybe_unused]] const auto* const p_obj = subobject(key);
+            EXTENSER_PRECONDITION(p_obj == nullptr || p_obj->is_null());
+        }
+
+    private:
+        // Errors are reported through fail(), which throws unless called under
+        // try_deserialize_object(). Either way, the nlohmann-json accessors used below are only
+        // reached once the type they require has been checked, so they never throw themselves
+
+        // Returns nullptr once the member is reported missing
+        [[nodiscard]] auto subobject(const std::string_view key) const -> const nlohmann::json*
+        {
+            if (key.empty())
+            {
+                return m_p_json;
+            }
+
+            if (m_p_fields != nullptr)
+            {
+                if (const auto pos = m_p_fields->find(key); pos != detail::field_table_view::npos)
+                {
+                    if (m_p_fields->p_values[pos] == nullptr)
                     {
-                        val = parse_arg<decltype(std::get<13>(val))>(obj.at("v_val"));
-                        return;
+                        fail_missing(key);
                     }
-                    [[fallthrough]];
 
-                default:
-                    EXTENSER_ASSUME(0);
+                    return m_p_fields->p_values[pos];
+                }
+            }
+
+            if (!m_p_json->is_object())
+            {
+                fail_type("object", *m_p_json);
+                return nullptr;
             }
+
+            const auto it = m_p_json->find(key);
+
+            if (it == m_p_json->cend())
+            {
+                fail_missing(key);
+                return nullptr;
+            }
+
+            return &*it;
         }
 
-        void as_object(const std::string_view key, nlohmann::json& val) const
+        void fail_missing(const std::string_view key) const
+        {
+            fail(deserialization_errc::missing_key,
+                std::string{ "JSON error: key '" }.append(key).append("' not found"));
+        }
+
+        void fail_type(const std::string_view expected, const nlohmann::json& arg) const
         {
-            val = subobject(key);
+            fail(deserialization_errc::type_mismatch,
+                std::string{ "JSON error: expected " }
+                    .append(expected)
+                    .append(", got ")
+                    .append(arg.type_name()));
         }
 
+        // nlohmann-json converts any number or boolean to an arithmetic type, but only a boolean
+        // to bool
         template<typename T>
-        void as_object(const std::string_view key, T& val) const
+        [[nodiscard]] static auto is_scalar(const nlohmann::json& arg) noexcept -> bool
         {
-            parse_arg_inplace<T>(subobject(key), val);
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return arg.is_boolean();
+            }
+            else
+            {
+                return arg.is_number() || arg.is_boolean();
+            }
         }
 
-        void as_null([[maybe_unused]] const std::string_view key) const
+        template<typename T>
+        void parse_scalar(const std::string_view key, T& val) const
         {
-            EXTENSER_PRECONDITION(subobject(key).is_null());
+            const auto* const p_obj = subobject(key);
+
+            if (p_obj == nullptr)
+            {
+                return;
+            }
+
+            if (!is_scalar<T>(*p_obj))
+            {
+                fail_type(std::is_same_v<T, bool> ? "boolean" : "number", *p_obj);
+                return;
+            }
+
+            val = p_obj->get<T>();
         }
 
-    private:
-        [[nodiscard]] auto subobject(const std::string_view key) const -> const nlohmann::json&
+        template<typename T>
+        void parse_stringlike(const nlohmann::json& arg, T& val) const
         {
-            EXTENSER_PRECONDITION(key.empty() || m_p_json->is_object());
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using char_t = typename traits_t::value_type;
 
-            try
+            if constexpr (std::is_same_v<char_t, char>)
             {
-                return key.empty() ? *m_p_json : m_p_json->at(key);
+                if (!arg.is_string())
+                {
+                    fail_type("string", arg);
+                    return;
+                }
+
+                const auto& str = arg.get_ref<const nlohmann::json::string_t&>();
+
+                if constexpr (traits_t::has_fixed_size)
+                {
+                    if (str.size() > adapter_t::size(val))
+                    {
+                        fail(deserialization_errc::out_of_range, "JSON error: array out of bounds");
+                        return;
+                    }
+                }
+
+                adapter_t::assign_from_range(val, str.cbegin(), str.cend(),
+                    [](const char c) { return static_cast<char_t>(c); });
             }
-            catch (const deserialization_error&)
+            else
             {
-                throw;
+                if (!arg.is_array())
+                {
+                    fail_type("array", arg);
+                    return;
+                }
+
+                if constexpr (traits_t::has_fixed_size)
+                {
+                    if (arg.size() > adapter_t::size(val))
+                    {
+                        fail(deserialization_errc::out_of_range, "JSON error: array out of bounds");
+                        return;
+                    }
+                }
+
+                adapter_t::assign_from_range(val, arg.cbegin(), arg.cend(),
+                    [this](const nlohmann::json& sub_val)
+                    {
+                        if (!is_scalar<char_t>(sub_val))
+                        {
+                            fail_type("number", sub_val);
+                            return char_t{};
+                        }
+
+                        return sub_val.get<char_t>();
+                    });
             }
-            catch (const std::exception& ex)
+        }
+
+        // Elements after a recorded error are skipped, the failing one adds its index to the path
+        template<typename T>
+        [[nodiscard]] auto parse_element(const nlohmann::json& arg, const std::size_t index) const
+            -> detail::remove_cvref_t<detail::decay_str_t<T>>
+        {
+            if (failed())
             {
-                throw deserialization_error{ ex.what() };
+                return detail::make_value<detail::remove_cvref_t<detail::decay_str_t<T>>>();
             }
+
+            const path_guard trace{ *this, index };
+            return parse_arg<T>(arg);
         }
 
         template<typename T>
@@ -883,7 +1158,8 @@ namespace detail_json
             }
             else if constexpr (std::is_floating_point_v<T>)
             {
-                return arg.is_number_float();
+                // As in parse_scalar(), integers are read into floating-point values
+                return arg.is_number();
             }
             else if constexpr (detail::is_stringlike_v<T>)
             {
@@ -909,13 +1185,43 @@ namespace detail_json
             }
         }
 
-        [[nodiscard]] static auto parse_key_str(std::string_view key_str) -> nlohmann::json
+        // The JSON type validate_arg() expects for T, as reported when it fails
+        template<typename T>
+        [[nodiscard]] static constexpr auto expected_type() noexcept -> std::string_view
+        {
+            if constexpr (detail::is_optional_v<T>)
+            {
+                return expected_type<typename T::value_type>();
+            }
+#if defined(EXTENSER_USE_MAGIC_ENUM)
+            else if constexpr (std::is_enum_v<T>)
+            {
+                return "string";
+            }
+#endif
+            else
+            {
+                return detail::expected_type_name<T>();
+            }
+        }
+
+        [[nodiscard]] auto parse_key_str(std::string_view key_str) const -> nlohmann::json
         {
             if (!key_str.empty() && key_str.front() == '@')
             {
                 if (key_str.size() <= 1 || key_str[1] != '@')
                 {
-                    return nlohmann::json::parse(std::next(key_str.begin()), key_str.end()).front();
+                    const auto key_obj = nlohmann::json::parse(
+                        std::next(key_str.begin()), key_str.end(), nullptr, false);
+
+                    if (key_obj.is_discarded() || key_obj.empty())
+                    {
+                        fail(deserialization_errc::malformed,
+                            std::string{ "JSON error: invalid map key: " }.append(key_str));
+                        return nullptr;
+                    }
+
+                    return key_obj.front();
                 }
 
                 // Escaped '@' in string value
@@ -925,174 +1231,95 @@ namespace detail_json
             return key_str;
         }
 
+        // Keys that are not plain decimal numbers in range of Key (e.g. written by another
+        // encoder) are left to parse_key_str, which reports them as before
+        template<typename Key>
+        [[nodiscard]] static auto parse_int_key(const std::string_view key_str, Key& key) noexcept
+            -> bool
+        {
+            if (key_str.size() < 2 || key_str.front() != '@' || key_str[1] == '@')
+            {
+                return false;
+            }
+
+            key_int_t<Key> num{};
+            const auto* const last = key_str.data() + key_str.size();
+            const auto result = std::from_chars(key_str.data() + 1, last, num);
+
+            if (result.ec != std::errc{} || result.ptr != last)
+            {
+                return false;
+            }
+
+            key = from_key_int<Key>(num);
+            return true;
+        }
+
         template<typename Key, typename Value>
-        [[nodiscard]] static auto parse_kv_pair(
-            const std::pair<std::string, nlohmann::json>& kv_pair) -> std::pair<Key, Value>
+        [[nodiscard]] auto parse_kv_pair(
+            const std::pair<std::string, nlohmann::json>& kv_pair) const -> std::pair<Key, Value>
         {
             const auto& [k, v] = kv_pair;
+
+            if constexpr (is_int_key_v<Key>)
+            {
+                if (auto key = detail::make_value<Key>(); parse_int_key(k, key))
+                {
+                    return { key, parse_arg<Value>(v) };
+                }
+            }
+
             const nlohmann::json key_obj = parse_key_str(k);
 
             return { parse_arg<Key>(key_obj), parse_arg<Value>(v) };
         }
 
         template<typename T>
-        [[nodiscard]] static auto parse_arg(const nlohmann::json& arg)
+        [[nodiscard]] auto parse_arg(const nlohmann::json& arg) const
             -> detail::remove_cvref_t<detail::decay_str_t<T>>
         {
             using no_ref_t = detail::remove_cvref_t<detail::decay_str_t<T>>;
 
             if (!validate_arg<no_ref_t>(arg))
             {
-#if defined(EXTENSER_NO_RTTI)
-                throw deserialization_error{
-                    std::string{ "JSON error: expected type: {NO-RTTI}, got type: " }.append(
-                        arg.type_name())
-                };
-#else
-                throw deserialization_error{ std::string{ "JSON error: expected type: " }
-                        .append(typeid(no_ref_t).name())
-                        .append(", got type: ")
-                        .append(arg.type_name()) };
-#endif
+                fail_type(expected_type<no_ref_t>(), arg);
+                return detail::make_value<no_ref_t>();
             }
 
             if constexpr (std::is_same_v<no_ref_t, bool> || std::is_arithmetic_v<no_ref_t>)
             {
-                try
-                {
-                    return arg.get<no_ref_t>();
-                }
-                catch (const deserialization_error&)
-                {
-                    throw;
-                }
-                catch (const std::exception& ex)
-                {
-                    throw deserialization_error{ ex.what() };
-                }
+                return arg.get<no_ref_t>();
             }
             else if constexpr (std::is_same_v<no_ref_t, std::string>)
             {
-                try
-                {
-                    return arg.get<std::string>();
-                }
-                catch (const deserialization_error&)
-                {
-                    throw;
-                }
-                catch (const std::exception& ex)
-                {
-                    throw deserialization_error{ ex.what() };
-                }
+                return arg.get<std::string>();
             }
             else if constexpr (detail::is_stringlike_v<no_ref_t>)
             {
-                no_ref_t out_val;
-
-                try
-                {
-                    using traits_t = containers::traits<T>;
-                    using adapter_t = containers::adapter<T>;
-
-                    if constexpr (std::is_same_v<typename traits_t::value_type, char>)
-                    {
-                        const auto str = arg.get<std::string>();
-
-                        if constexpr (traits_t::has_fixed_size)
-                        {
-                            if (str.size() > adapter_t::size(out_val))
-                            {
-                                throw deserialization_error{ "JSON error: array out of bounds" };
-                            }
-                        }
-
-                        adapter_t::assign_from_range(out_val, str.cbegin(), str.cend(),
-                            [](const char c)
-                            { return static_cast<typename traits_t::value_type>(c); });
-                    }
-                    else
-                    {
-                        if constexpr (traits_t::has_fixed_size)
-                        {
-                            if (arg.size() > adapter_t::size(out_val))
-                            {
-                                throw deserialization_error{ "JSON error: array out of bounds" };
-                            }
-                        }
-
-                        adapter_t::assign_from_range(out_val, arg.begin(), arg.end(),
-                            [](const nlohmann::json& sub_val)
-                            { return sub_val.get<typename traits_t::value_type>(); });
-                    }
-                }
-                catch (const deserialization_error&)
-                {
-                    throw;
-                }
-                catch (const std::exception& ex)
-                {
-                    throw deserialization_error{ ex.what() };
-                }
-
+                auto out_val = detail::make_value<no_ref_t>();
+                parse_stringlike(arg, out_val);
                 return out_val;
             }
             else
             {
-                no_ref_t out_val;
-                deserializer ser{ arg };
-
-                try
-                {
-                    ser.deserialize_object(out_val);
-                }
-                catch (const deserialization_error&)
-                {
-                    throw;
-                }
-                catch (const std::exception& ex)
-                {
-                    throw deserialization_error{ ex.what() };
-                }
-
+                auto out_val = detail::make_value<no_ref_t>();
+                parse_nested(arg, out_val);
                 return out_val;
             }
         }
 
         template<typename T>
-        static void parse_arg_inplace(const nlohmann::json& arg, T& val)
+        void parse_arg_inplace(const nlohmann::json& arg, T& val) const
         {
             using no_ref_t = detail::remove_cvref_t<detail::decay_str_t<T>>;
 
             if (!validate_arg<no_ref_t>(arg))
             {
-#if defined(EXTENSER_NO_RTTI)
-                throw deserialization_error{
-                    std::string{ "JSON error: expected type: {NO-RTTI}, got type: " }.append(
-                        arg.type_name())
-                };
-#else
-                throw deserialization_error{ std::string{ "JSON error: expected type: " }
-                        .append(typeid(no_ref_t).name())
-                        .append(", got type: ")
-                        .append(arg.type_name()) };
-#endif
+                fail_type(expected_type<no_ref_t>(), arg);
+                return;
             }
 
-            deserializer ser{ arg };
-
-            try
-            {
-                ser.deserialize_object(val);
-            }
-            catch (const deserialization_error&)
-            {
-                throw;
-            }
-            catch (const std::exception& ex)
-            {
-                throw deserialization_error{ ex.what() };
-            }
+            parse_nested(arg, val);
         }
 
         [[nodiscard]] static auto get_next_arg(
@@ -1110,19 +1337,33 @@ namespace detail_json
         }
 
         template<typename T>
-        [[nodiscard]] static auto parse_args(const nlohmann::json& arg_arr, std::size_t& index)
+        [[nodiscard]] auto parse_args(const nlohmann::json& arg_arr, std::size_t& index) const
             -> detail::remove_cvref_t<detail::decay_str_t<T>>
         {
             if (index >= arg_arr.size())
             {
-                throw deserialization_error{ "JSON error: argument count mismatch" };
+                fail(deserialization_errc::out_of_range, "JSON error: argument count mismatch");
+                return detail::make_value<detail::remove_cvref_t<detail::decay_str_t<T>>>();
             }
 
-            const auto& next_obj = get_next_arg(arg_arr, index);
+            return parse_arg<T>(get_next_arg(arg_arr, index));
+        }
+
+        // Only the outermost level translates other exceptions (e.g. from a type's serialize
+        // function), nested levels let them pass through
+        template<typename T>
+        void parse_nested(const nlohmann::json& arg, T& val) const
+        {
+#if defined(EXTENSER_HAS_EXCEPTIONS)
+            if (m_nested)
+            {
+                parse_object(arg, val);
+                return;
+            }
 
             try
             {
-                return parse_arg<T>(next_obj);
+                parse_object(arg, val);
             }
             catch (const deserialization_error&)
             {
@@ -1132,9 +1373,100 @@ namespace detail_json
             {
                 throw deserialization_error{ ex.what() };
             }
+#else
+            parse_object(arg, val);
+#endif
+        }
+
+        // Types declaring their field_keys have their members resolved once up front, through a
+        // perfect hash, rather than with one object lookup per field. Each member's key is hashed
+        // there only, subobject() then finds fields by their declared position
+        template<typename T>
+        void parse_object(const nlohmann::json& arg, T& val) const
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+            if constexpr (detail::has_field_keys_v<no_ref_t>)
+            {
+                using index_t = detail::field_index<no_ref_t>;
+
+                constexpr auto& table = index_t::table;
+                std::array<const nlohmann::json*, index_t::keys.size()> values{};
+                field_cursor fields{ index_t::keys.size(), table.view(), values.data() };
+
+                if (!arg.is_object())
+                {
+                    // Left to subobject() to report
+                    deserializer{ *this, arg, nullptr }.parse_fields(val);
+                    return;
+                }
+
+                for (auto it = arg.cbegin(); it != arg.cend(); ++it)
+                {
+                    if (const auto pos = table.find(it.key());
+                        pos != detail::field_table_view::npos)
+                    {
+                        values[pos] = &it.value();
+                    }
+                }
+
+                deserializer{ *this, arg, &fields }.parse_fields(val);
+            }
+            else
+            {
+                deserializer{ *this, arg, nullptr }.parse_fields(val);
+            }
+        }
+
+        template<typename T>
+        void parse_fields(T& val)
+        {
+            detail::serializer_base<serial_adapter, true>::deserialize_object(val);
+        }
+
+        // The members of an object whose type declares its field_keys, by the position of their
+        // key in its declaration
+        struct field_cursor
+        {
+            std::size_t count;
+            detail::field_table_view table;
+            const nlohmann::json* const* p_values;
+            std::size_t next{};
+
+            // serialize() functions usually ask for their fields in declaration order, so the
+            // next key is compared first and only fields asked for out of order are hashed
+            [[nodiscard]] auto find(const std::string_view key) noexcept -> std::size_t
+            {
+                if (next < count && table.p_keys[next] == key)
+                {
+                    return next++;
+                }
+
+                const auto pos = table.find(key);
+
+                if (pos != detail::field_table_view::npos)
+                {
+                    next = pos + 1;
+                }
+
+                return pos;
+            }
+        };
+
+        // Nested values are deserialized by a deserializer of their own, built on the stack by
+        // parse_object(). It only holds the cursor into the tree and shares the error state and
+        // memory resource of the enclosing deserializer, so descending a level costs no allocation
+        // or exception frame
+        deserializer(const deserializer& parent, const nlohmann::json& obj,
+            field_cursor* const p_fields) noexcept
+            : detail::serializer_base<serial_adapter, true>(parent), m_p_json(&obj),
+              m_p_fields(p_fields), m_nested(true)
+        {
         }
 
         const nlohmann::json* m_p_json;
+        field_cursor* m_p_fields{ nullptr };
+        bool m_nested{ false };
     };
 } //namespace detail_json
 
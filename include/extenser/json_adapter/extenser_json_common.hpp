@@ -0,0 +1,48 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+// Shared by json_adapter and json_text_adapter, without depending on nlohmann-json
+
+#ifndef EXTENSER_JSON_COMMON_HPP
+#define EXTENSER_JSON_COMMON_HPP
+
+#include <extenser/extenser.hpp>
+
+#if defined(EXTENSER_USE_MAGIC_ENUM)
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wconversion"
+#    include <magic_enum/magic_enum.hpp>
+#    pragma GCC diagnostic pop
+#  else
+#    include <magic_enum/magic_enum.hpp>
+#  endif
+#endif
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace extenser::detail_json
+{
+// Types holding a JSON document of their own, which the text adapter writes and reads as raw
+// JSON text. Specializations provide:
+//   static void dump(const T& val, std::string& out), which appends val's text to out
+//   static void parse(std::string_view text, T& val)
+// extenser_json.hpp specializes it for nlohmann::json
+template<typename T, typename = void>
+struct raw_json : std::false_type
+{
+};
+
+template<typename T>
+inline constexpr bool is_raw_json_v = raw_json<T>::value;
+} //namespace extenser::detail_json
+
+#endif //EXTENSER_JSON_COMMON_HPP
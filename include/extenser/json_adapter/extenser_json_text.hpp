@@ -0,0 +1,2586 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_JSON_TEXT_HPP
+#define EXTENSER_JSON_TEXT_HPP
+
+#include "extenser_json_common.hpp"
+
+#include <extenser/extenser.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if !defined(__cpp_lib_to_chars)
+#  include <cstdio>
+#  include <cstdlib>
+#endif
+
+namespace extenser
+{
+namespace detail_json_text
+{
+    class serializer;
+    class deserializer;
+
+    struct serial_adapter
+    {
+        using bytes_t = std::string;
+        using serial_t = std::string;
+        using serializer_t = serializer;
+        using deserializer_t = deserializer;
+        using config = void;
+    };
+
+    // Writes JSON text directly to a string as values are visited, producing the same document as
+    // json_adapter (modulo object key order) without building an intermediate nlohmann::json
+    class serializer : public detail::serializer_base<serial_adapter, false>
+    {
+    public:
+        serializer() noexcept = default;
+        explicit serializer(const std::string& text) : m_text(text) {}
+        explicit serializer(std::string&& text) noexcept : m_text(std::move(text)) {}
+
+        // Writes to the caller's string instead of an owned one, its capacity is reused between
+        // calls to serialize_object()
+        explicit serializer(const std::reference_wrapper<std::string> out) noexcept
+            : m_p_out(&out.get())
+        {
+            m_p_out->clear();
+        }
+
+        // A copy would write to the same caller's string, moving hands it over
+        serializer(const serializer&) = delete;
+        serializer(serializer&&) noexcept = default;
+        auto operator=(const serializer&) -> serializer& = delete;
+        auto operator=(serializer&&) noexcept -> serializer& = default;
+        ~serializer() noexcept = default;
+
+        template<typename T>
+        void serialize_object(const T& val)
+        {
+            buffer().clear();
+            m_frame = frame_state::empty;
+            m_depth = 0;
+
+            detail::serializer_base<serial_adapter, false>::serialize_object(val);
+
+            if (m_frame == frame_state::empty)
+            {
+                buffer().append("null");
+            }
+        }
+
+        [[nodiscard]] auto object() const& noexcept -> const std::string&
+        {
+            return m_p_out == nullptr ? m_text : *m_p_out;
+        }
+
+        [[nodiscard]] auto object() && noexcept -> std::string&&
+        {
+            return std::move(buffer());
+        }
+
+        // Used by serialize_parallel() and serialize_to(): each chunk of a split array is written
+        // as just its comma-separated elements, then splice_array() joins the chunks inside the
+        // brackets (serialize_to() writes serialize_array_head(), the chunks separated by
+        // element_separator() and serialize_array_tail())
+        template<typename It>
+        void serialize_elements(It first, const It last)
+        {
+            buffer().clear();
+            m_frame = frame_state::empty;
+            m_depth = 0;
+
+            for (auto it = first; it != last; ++it)
+            {
+                if (it != first)
+                {
+                    buffer().push_back(',');
+                }
+
+                push_arg(*it);
+            }
+        }
+
+        template<typename T>
+        void splice_array(const T& val, std::vector<std::string>& chunks)
+        {
+            serialize_array_head(val);
+
+            // Brackets and one comma between each pair of chunks
+            auto& out = buffer();
+            out.reserve(std::accumulate(chunks.begin(), chunks.end(), chunks.size() + 1,
+                [](const std::size_t size, const std::string& chunk)
+                { return size + chunk.size(); }));
+
+            for (const auto& chunk : chunks)
+            {
+                if (&chunk != &chunks.front())
+                {
+                    out.append(element_separator());
+                }
+
+                out.append(chunk);
+            }
+
+            out.push_back(']');
+        }
+
+        template<typename T>
+        void serialize_array_head([[maybe_unused]] const T& val)
+        {
+            buffer().assign(1, '[');
+            m_frame = frame_state::unkeyed;
+            m_depth = 0;
+        }
+
+        void serialize_array_tail()
+        {
+            buffer().assign(1, ']');
+            m_frame = frame_state::unkeyed;
+            m_depth = 0;
+        }
+
+        [[nodiscard]] static constexpr auto element_separator() noexcept -> std::string_view
+        {
+            return ",";
+        }
+
+        void as_bool(const std::string_view key, const bool val)
+        {
+            begin_field(key);
+            push_bool(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_float(const std::string_view key, const T val)
+        {
+            static_assert(!std::is_same_v<T, long double>, "long double is not supported");
+
+            begin_field(key);
+            push_float(static_cast<double>(val));
+            end_field();
+        }
+
+        template<typename T>
+        void as_int(const std::string_view key, const T val)
+        {
+            static_assert(sizeof(T) <= sizeof(std::int64_t), "maximum 64-bit integers supported");
+            static_assert(
+                std::is_integral_v<T> && std::is_signed_v<T>, "only signed integers are supported");
+
+            begin_field(key);
+            push_integer(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_uint(const std::string_view key, const T val)
+        {
+            static_assert(sizeof(T) <= sizeof(std::int64_t), "maximum 64-bit integers supported");
+            static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>,
+                "only unsigned integers are supported");
+
+            begin_field(key);
+            push_integer(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_enum(const std::string_view key, const T val)
+        {
+            static_assert(std::is_enum_v<T>, "T must be an enum type");
+
+            begin_field(key);
+            push_enum(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_string(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_string(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_array(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_array(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_map(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_map(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_multimap(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_multimap(val);
+            end_field();
+        }
+
+        template<typename T1, typename T2>
+        void as_tuple(const std::string_view key, const std::pair<T1, T2>& val)
+        {
+            begin_field(key);
+            push_pair(val);
+            end_field();
+        }
+
+        template<typename... Args>
+        void as_tuple(const std::string_view key, const std::tuple<Args...>& val)
+        {
+            begin_field(key);
+            push_tuple(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_optional(const std::string_view key, const std::optional<T>& val)
+        {
+            begin_field(key);
+            push_optional(val);
+            end_field();
+        }
+
+        template<typename... Args>
+        void as_variant(const std::string_view key, const std::variant<Args...>& val)
+        {
+            begin_field(key);
+            push_variant(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_object(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_arg(val);
+            end_field();
+        }
+
+        void as_null(const std::string_view key)
+        {
+            begin_field(key);
+            buffer().append("null");
+            end_field();
+        }
+
+    private:
+        // State of the object currently being written: nothing yet, a JSON object of keyed
+        // fields, or a single unkeyed value
+        enum class frame_state : std::uint8_t
+        {
+            empty,
+            keyed,
+            unkeyed,
+        };
+
+        [[nodiscard]] auto buffer() noexcept -> std::string&
+        {
+            return m_p_out == nullptr ? m_text : *m_p_out;
+        }
+
+        void begin_field(const std::string_view key)
+        {
+            auto& out = buffer();
+
+            if (key.empty())
+            {
+                if (m_frame != frame_state::empty)
+                {
+                    if (m_depth != 0)
+                    {
+                        EXTENSER_THROW(serialization_error{
+                            "JSON error: unkeyed value written to an object that already has "
+                            "content" });
+                    }
+
+                    // Top-level unkeyed values replace the document, as they do in json_adapter
+                    out.clear();
+                }
+
+                m_frame = frame_state::unkeyed;
+                return;
+            }
+
+            switch (m_frame)
+            {
+                case frame_state::empty:
+                    out.push_back('{');
+                    break;
+
+                case frame_state::keyed:
+                    // The top-level object is kept closed between fields so object() is always
+                    // a complete document
+                    if (m_depth == 0)
+                    {
+                        out.back() = ',';
+                    }
+                    else
+                    {
+                        out.push_back(',');
+                    }
+                    break;
+
+                case frame_state::unkeyed:
+                default:
+                    EXTENSER_THROW(serialization_error{
+                        "JSON error: keyed value written to an object holding an unkeyed value" });
+            }
+
+            m_frame = frame_state::keyed;
+            push_string(key);
+            out.push_back(':');
+        }
+
+        void end_field()
+        {
+            if (m_depth == 0 && m_frame == frame_state::keyed)
+            {
+                buffer().push_back('}');
+            }
+        }
+
+        void push_bool(const bool arg) { buffer().append(arg ? "true" : "false"); }
+
+        template<typename T>
+        void push_integer(const T arg)
+        {
+            std::array<char, 24> chars{};
+            const auto result = std::to_chars(chars.data(), chars.data() + chars.size(), arg);
+
+            EXTENSER_POSTCONDITION(result.ec == std::errc{});
+            buffer().append(chars.data(), static_cast<std::size_t>(result.ptr - chars.data()));
+        }
+
+        void push_float(const double arg)
+        {
+            auto& out = buffer();
+
+            // Matches nlohmann::json, which dumps non-finite values as null
+            if (!std::isfinite(arg))
+            {
+                out.append("null");
+                return;
+            }
+
+            std::array<char, 32> chars{};
+
+#if defined(__cpp_lib_to_chars)
+            const auto result = std::to_chars(chars.data(), chars.data() + chars.size(), arg);
+            EXTENSER_POSTCONDITION(result.ec == std::errc{});
+
+            const std::string_view num_str{ chars.data(),
+                static_cast<std::size_t>(result.ptr - chars.data()) };
+#else
+            const int len = std::snprintf(chars.data(), chars.size(), "%.17g", arg);
+            EXTENSER_POSTCONDITION(len > 0 && static_cast<std::size_t>(len) < chars.size());
+
+            const std::string_view num_str{ chars.data(), static_cast<std::size_t>(len) };
+#endif
+
+            out.append(num_str);
+
+            // Keep integral values typed as floats when read back
+            if (num_str.find_first_of(".e") == std::string_view::npos)
+            {
+                out.append(".0");
+            }
+        }
+
+        template<typename T>
+        void push_enum(const T arg)
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+#if defined(EXTENSER_USE_MAGIC_ENUM)
+            if (!magic_enum::enum_contains<no_ref_t>(arg))
+            {
+                EXTENSER_THROW(serialization_error{ std::string{ "Invalid enum value: " }
+                        .append(std::to_string(static_cast<std::underlying_type_t<no_ref_t>>(arg)))
+                        .append(" for type: ")
+                        .append(magic_enum::enum_type_name<no_ref_t>()) });
+            }
+
+            push_string(magic_enum::enum_name<no_ref_t>(arg));
+#else
+            push_integer(static_cast<std::underlying_type_t<no_ref_t>>(arg));
+#endif
+        }
+
+        void push_string(const std::string_view arg)
+        {
+            auto& out = buffer();
+            out.push_back('"');
+            append_escaped(out, arg);
+            out.push_back('"');
+        }
+
+        // Non-char strings are written as arrays of code units, as nlohmann::json does
+        void push_string(const std::wstring_view arg) { push_array(arg); }
+        void push_string(const std::u16string_view arg) { push_array(arg); }
+        void push_string(const std::u32string_view arg) { push_array(arg); }
+#if defined(__cpp_char8_t)
+        void push_string(const std::u8string_view arg) { push_array(arg); }
+#endif
+
+        static void append_escaped(std::string& out, const std::string_view str)
+        {
+            static constexpr std::string_view hex_digits = "0123456789abcdef";
+
+            std::size_t run_start = 0;
+
+            for (std::size_t i = 0; i < str.size(); ++i)
+            {
+                const auto c = static_cast<unsigned char>(str[i]);
+
+                if (c >= 0x20 && c != '"' && c != '\\')
+                {
+                    continue;
+                }
+
+                out.append(str.substr(run_start, i - run_start));
+                run_start = i + 1;
+
+                switch (c)
+                {
+                    case '"':
+                        out.append("\\\"");
+                        break;
+
+                    case '\\':
+                        out.append("\\\\");
+                        break;
+
+                    case '\b':
+                        out.append("\\b");
+                        break;
+
+                    case '\f':
+                        out.append("\\f");
+                        break;
+
+                    case '\n':
+                        out.append("\\n");
+                        break;
+
+                    case '\r':
+                        out.append("\\r");
+                        break;
+
+                    case '\t':
+                        out.append("\\t");
+                        break;
+
+                    default:
+                        out.append("\\u00");
+                        out.push_back(hex_digits[static_cast<std::size_t>(c) >> 4U]);
+                        out.push_back(hex_digits[static_cast<std::size_t>(c) & 0x0FU]);
+                        break;
+                }
+            }
+
+            out.append(str.substr(run_start));
+        }
+
+        template<typename T>
+        void push_array(const T& arg)
+        {
+            auto& out = buffer();
+            out.push_back('[');
+
+            bool first = true;
+
+            for (const auto& subval : arg)
+            {
+                if (!std::exchange(first, false))
+                {
+                    out.push_back(',');
+                }
+
+                push_arg(subval);
+            }
+
+            out.push_back(']');
+        }
+
+        template<typename T>
+        void push_map(const T& arg)
+        {
+            auto& out = buffer();
+            out.push_back('{');
+
+            bool first = true;
+
+            for (const auto& [k, v] : arg)
+            {
+                if (!std::exchange(first, false))
+                {
+                    out.push_back(',');
+                }
+
+                push_key(k);
+                out.push_back(':');
+                push_arg(v);
+            }
+
+            out.push_back('}');
+        }
+
+        template<typename T>
+        void push_multimap(const T& arg)
+        {
+            auto& out = buffer();
+            out.push_back('{');
+
+            // Equivalent keys are adjacent in both ordered and unordered multimaps, so each key
+            // is written once followed by the array of its values
+            for (auto it = arg.begin(); it != arg.end();)
+            {
+                if (it != arg.begin())
+                {
+                    out.push_back(',');
+                }
+
+                const auto range_end = arg.equal_range(it->first).second;
+
+                push_key(it->first);
+                out.append(":[");
+                push_arg(it->second);
+
+                for (++it; it != range_end; ++it)
+                {
+                    out.push_back(',');
+                    push_arg(it->second);
+                }
+
+                out.push_back(']');
+            }
+
+            out.push_back('}');
+        }
+
+        template<typename T1, typename T2>
+        void push_pair(const std::pair<T1, T2>& arg)
+        {
+            auto& out = buffer();
+            out.push_back('[');
+            push_arg(arg.first);
+            out.push_back(',');
+            push_arg(arg.second);
+            out.push_back(']');
+        }
+
+        template<typename... Args>
+        void push_tuple(const std::tuple<Args...>& arg)
+        {
+            auto& out = buffer();
+            out.push_back('[');
+
+            bool first = true;
+
+            detail::for_each_tuple(arg,
+                [this, &out, &first](auto&& elem)
+                {
+                    if (!std::exchange(first, false))
+                    {
+                        out.push_back(',');
+                    }
+
+                    push_arg(std::forward<decltype(elem)>(elem));
+                });
+
+            out.push_back(']');
+        }
+
+        template<typename T>
+        void push_optional(const std::optional<T>& arg)
+        {
+            if (arg.has_value())
+            {
+                push_arg(*arg);
+            }
+            else
+            {
+                buffer().append("null");
+            }
+        }
+
+        template<typename... Args>
+        void push_variant(const std::variant<Args...>& arg)
+        {
+            using variant_t = std::variant<Args...>;
+
+            auto& out = buffer();
+
+            if constexpr (detail::is_tagged_variant_v<variant_t>)
+            {
+                out.append(R"({")");
+                append_escaped(out, detail::variant_tag_index<variant_t>::tags[arg.index()].name);
+                out.append(R"(":)");
+            }
+            else
+            {
+                out.append(R"({"v_idx":)");
+                push_integer(arg.index());
+                out.append(R"(,"v_val":)");
+            }
+
+            std::visit([this](auto&& l_val) { push_arg(std::forward<decltype(l_val)>(l_val)); },
+                arg);
+
+            out.push_back('}');
+        }
+
+        template<typename T>
+        void push_object(const T& arg)
+        {
+            const auto prev_frame = std::exchange(m_frame, frame_state::empty);
+            ++m_depth;
+
+            detail::serializer_base<serial_adapter, false>::serialize_object(arg);
+
+            if (m_frame == frame_state::keyed)
+            {
+                buffer().push_back('}');
+            }
+            else if (m_frame == frame_state::empty)
+            {
+                buffer().append("null");
+            }
+
+            --m_depth;
+            m_frame = prev_frame;
+        }
+
+        // Keys follow the json_adapter convention: strings are written as-is (with a leading '@'
+        // escaped as "@@"), anything else is written as '@' followed by its JSON text
+        template<typename T>
+        void push_key(const T& key_arg)
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+            auto& out = buffer();
+
+            if constexpr (is_string_serializable<no_ref_t>)
+            {
+                const std::string_view key_str{ key_arg };
+
+                out.push_back('"');
+
+                if (!key_str.empty() && key_str.front() == '@')
+                {
+                    out.push_back('@');
+                }
+
+                append_escaped(out, key_str);
+                out.push_back('"');
+            }
+            else if constexpr (std::is_arithmetic_v<no_ref_t>)
+            {
+                out.append("\"@");
+                push_arg(key_arg);
+                out.push_back('"');
+            }
+            else
+            {
+                serializer key_ser{};
+                key_ser.push_arg(key_arg);
+
+                const std::string_view key_json = key_ser.object();
+
+                if (!key_json.empty() && key_json.front() == '"')
+                {
+                    // Already a JSON string (e.g. an enum name), only the '@' escape is needed
+                    out.push_back('"');
+
+                    if (key_json.size() > 1 && key_json[1] == '@')
+                    {
+                        out.push_back('@');
+                    }
+
+                    out.append(key_json.substr(1));
+                }
+                else
+                {
+                    out.append("\"@");
+                    append_escaped(out, key_json);
+                    out.push_back('"');
+                }
+            }
+        }
+
+        template<typename T>
+        void push_arg(const T& arg)
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+            if constexpr (detail_json::is_raw_json_v<no_ref_t>)
+            {
+                detail_json::raw_json<no_ref_t>::dump(arg, buffer());
+            }
+            else if constexpr (is_null_serializable<no_ref_t>)
+            {
+                buffer().append("null");
+            }
+            else if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                push_bool(arg);
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                static_assert(
+                    !std::is_same_v<no_ref_t, long double>, "long double is not supported");
+                push_float(static_cast<double>(arg));
+            }
+            else if constexpr (std::is_arithmetic_v<no_ref_t>)
+            {
+                push_integer(arg);
+            }
+            else if constexpr (is_enum_serializable<no_ref_t>)
+            {
+                push_enum(arg);
+            }
+            else if constexpr (is_string_serializable<no_ref_t>)
+            {
+                push_string(arg);
+            }
+            else if constexpr (is_multimap_serializable<no_ref_t>)
+            {
+                push_multimap(arg);
+            }
+            else if constexpr (is_map_serializable<no_ref_t>)
+            {
+                push_map(arg);
+            }
+            else if constexpr (is_array_serializable<no_ref_t>)
+            {
+                push_array(arg);
+            }
+            else if constexpr (is_optional_serializable<no_ref_t>)
+            {
+                push_optional(arg);
+            }
+            else if constexpr (is_tuple_serializable<no_ref_t>)
+            {
+                if constexpr (detail::is_pair_v<no_ref_t>)
+                {
+                    push_pair(arg);
+                }
+                else
+                {
+                    push_tuple(arg);
+                }
+            }
+            else if constexpr (is_variant_serializable<no_ref_t>)
+            {
+                push_variant(arg);
+            }
+            else
+            {
+                push_object(arg);
+            }
+        }
+
+        std::string m_text{};
+        std::string* m_p_out{ nullptr };
+        frame_state m_frame{ frame_state::empty };
+        std::size_t m_depth{};
+    };
+
+    // Pulls values straight out of the JSON text as the as_xxx() calls arrive. Object members are
+    // matched in document order, members read out of order are remembered so they are only
+    // scanned once, and unvisited values are skipped without being parsed
+    class deserializer : public detail::serializer_base<serial_adapter, true>
+    {
+    public:
+        // Reads text in place, so it must outlive the deserializer
+        explicit deserializer(const std::string& text) noexcept
+            : m_p_text(&text), m_text(text), m_frame{ skip_ws(0) }
+        {
+        }
+
+        explicit deserializer(std::string&& text) = delete;
+
+        explicit deserializer(const std::string_view text) noexcept
+            : m_text(text), m_frame{ skip_ws(0) }
+        {
+        }
+
+        explicit deserializer(const char* text) noexcept
+            : deserializer(std::string_view{ text })
+        {
+        }
+
+        deserializer(const char* const text, const std::size_t size) noexcept
+            : deserializer(std::string_view{ text, size })
+        {
+        }
+
+        // Bound to the caller's text (and, when given a std::string, re-reads it on every
+        // deserialize_object()), so it can be moved but not copied
+        deserializer(const deserializer&) = delete;
+        deserializer(deserializer&&) noexcept = default;
+        auto operator=(const deserializer&) -> deserializer& = delete;
+        auto operator=(deserializer&&) noexcept -> deserializer& = default;
+        ~deserializer() noexcept = default;
+
+        template<typename T>
+        void deserialize_object(T&& val)
+        {
+            if (m_p_text != nullptr)
+            {
+                m_text = *m_p_text;
+            }
+
+            m_skipped.clear();
+            m_last_pos = npos;
+            m_frame = frame{ skip_ws(0) };
+            m_frame.skipped_begin = 0;
+
+            detail::serializer_base<serial_adapter, true>::deserialize_object(std::forward<T>(val));
+
+            if (!failed() && skip_ws(frame_end()) != m_text.size())
+            {
+                fail(deserialization_errc::malformed, "JSON error: unexpected trailing characters");
+            }
+        }
+
+        // Used by deserialize_from(), which reads a top-level array a window of the text at a
+        // time, deserializing each element from its own text. Returns the position of the first
+        // element, the count is npos as the closing bracket ends the array
+        [[nodiscard]] auto scan_array_head() const -> std::pair<std::size_t, std::size_t>
+        {
+            const auto pos = skip_ws(0);
+
+            if (!expect(pos, '['))
+            {
+                return { m_text.size(), npos };
+            }
+
+            return { pos + 1, npos };
+        }
+
+        // Where the element after pos (the index-th) starts and ends. The closing bracket gives an
+        // empty range
+        [[nodiscard]] auto scan_array_item(std::size_t pos, const std::size_t index) const
+            -> std::pair<std::size_t, std::size_t>
+        {
+            pos = skip_ws(pos);
+
+            if (peek(pos) == ']')
+            {
+                return { pos + 1, pos + 1 };
+            }
+
+            if (index != 0)
+            {
+                if (!expect(pos, ','))
+                {
+                    return { m_text.size(), m_text.size() };
+                }
+
+                pos = skip_ws(pos + 1);
+            }
+
+            return { pos, skip_value(pos) };
+        }
+
+        // Only whitespace may follow the array
+        [[nodiscard]] auto scan_trailing(const std::size_t pos) const noexcept -> std::size_t
+        {
+            return skip_ws(pos);
+        }
+
+        void as_bool(const std::string_view key, bool& val) { parse_field(key, val); }
+
+        template<typename T>
+        void as_float(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_int(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_uint(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_enum(const std::string_view key, T& val)
+        {
+            static_assert(std::is_enum_v<T>, "T must be an enum type");
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_string(const std::string_view key, T& val)
+        {
+            if constexpr (std::is_array_v<T>)
+            {
+                span arr{ val };
+                as_string(key, arr);
+            }
+            else
+            {
+                const auto pos = find_field(key);
+
+                if (!failed())
+                {
+                    finish_field(pos, parse_string_like(pos, val));
+                }
+            }
+        }
+
+        template<typename T>
+        void as_array(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_map(const std::string_view key, T& val)
+        {
+            EXTENSER_PRECONDITION(std::size(val) == 0);
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_multimap(const std::string_view key, T& val)
+        {
+            EXTENSER_PRECONDITION(std::size(val) == 0);
+            parse_field(key, val);
+        }
+
+        template<typename T1, typename T2>
+        void as_tuple(const std::string_view key, std::pair<T1, T2>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename... Args>
+        void as_tuple(const std::string_view key, std::tuple<Args...>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_optional(const std::string_view key, std::optional<T>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename... Args>
+        void as_variant(const std::string_view key, std::variant<Args...>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_object(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        void as_null(const std::string_view key)
+        {
+            std::nullptr_t val{};
+            parse_field(key, val);
+        }
+
+    private:
+        static constexpr std::size_t npos = std::string_view::npos;
+
+        // The value currently being deserialized and, once a key has been looked up, the read
+        // position within it
+        struct frame
+        {
+            std::size_t value_pos{ npos };
+            std::size_t first_member{ npos };
+            std::size_t cursor{ npos };
+            std::size_t end{ npos };
+            std::size_t skipped_begin{};
+        };
+
+        struct member
+        {
+            std::string_view raw_key{};
+            std::size_t value_pos{};
+        };
+
+        // Iterates the element positions of a JSON array, without parsing them, so arrays can be
+        // handed to the container adapters
+        class element_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::size_t*;
+            using reference = const std::size_t&;
+
+            element_iterator() noexcept = default;
+
+            element_iterator(deserializer& des, const std::size_t array_pos)
+                : m_p_des(&des), m_array_pos(array_pos), m_pos(des.first_element(array_pos))
+            {
+            }
+
+            auto operator*() const noexcept -> reference { return m_pos; }
+
+            auto operator++() -> element_iterator&
+            {
+                m_pos = m_p_des->next_element(m_array_pos, m_p_des->value_end(m_pos));
+                return *this;
+            }
+
+            auto operator++(int) -> element_iterator
+            {
+                auto tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            friend auto operator==(
+                const element_iterator& lhs, const element_iterator& rhs) noexcept -> bool
+            {
+                return lhs.m_pos == rhs.m_pos;
+            }
+
+            friend auto operator!=(
+                const element_iterator& lhs, const element_iterator& rhs) noexcept -> bool
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            deserializer* m_p_des{ nullptr };
+            std::size_t m_array_pos{ npos };
+            std::size_t m_pos{ npos };
+        };
+
+        [[nodiscard]] auto peek(const std::size_t pos) const noexcept -> char
+        {
+            return pos < m_text.size() ? m_text[pos] : '\0';
+        }
+
+        [[nodiscard]] auto skip_ws(std::size_t pos) const noexcept -> std::size_t
+        {
+            while (pos < m_text.size()
+                && (m_text[pos] == ' ' || m_text[pos] == '\n' || m_text[pos] == '\r'
+                    || m_text[pos] == '\t'))
+            {
+                ++pos;
+            }
+
+            return pos;
+        }
+
+        // Errors are reported through fail(), which throws unless called under
+        // try_deserialize_object(). There, the parse runs to the end of the text instead: each
+        // scan returns m_text.size() once an error is recorded, where every further scan stops
+        [[nodiscard]] auto fail_at(const deserialization_errc code, std::string message) const
+            -> std::size_t
+        {
+            fail(code, std::move(message));
+            return m_text.size();
+        }
+
+        [[nodiscard]] auto fail_end_of_input() const -> std::size_t
+        {
+            return fail_at(deserialization_errc::end_of_input,
+                "JSON error: unexpected end of input");
+        }
+
+        [[nodiscard]] auto expect(const std::size_t pos, const char c) const -> bool
+        {
+            if (peek(pos) == c)
+            {
+                return true;
+            }
+
+            if (pos >= m_text.size())
+            {
+                std::ignore = fail_end_of_input();
+                return false;
+            }
+
+            fail(deserialization_errc::malformed,
+                std::string{ "JSON error: expected '" }
+                    .append(1, c)
+                    .append("' at position ")
+                    .append(std::to_string(pos)));
+
+            return false;
+        }
+
+        [[nodiscard]] auto type_name_at(const std::size_t pos) const noexcept -> const char*
+        {
+            switch (peek(pos))
+            {
+                case '{':
+                    return "object";
+
+                case '[':
+                    return "array";
+
+                case '"':
+                    return "string";
+
+                case 't':
+                case 'f':
+                    return "boolean";
+
+                case 'n':
+                    return "null";
+
+                case '\0':
+                    return "end of input";
+
+                default:
+                    return "number";
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto fail_type(const std::size_t pos) const -> std::size_t
+        {
+            return fail_at(deserialization_errc::type_mismatch,
+                std::string{ "JSON error: expected " }
+                    .append(detail::expected_type_name<detail::remove_cvref_t<T>>())
+                    .append(", got ")
+                    .append(type_name_at(pos)));
+        }
+
+        [[nodiscard]] auto skip_literal(const std::size_t pos, const std::string_view literal) const
+            -> std::size_t
+        {
+            if (m_text.substr(pos, literal.size()) != literal)
+            {
+                // A literal cut short by the end of the text may still be valid
+                if (pos + literal.size() > m_text.size()
+                    && literal.substr(0, m_text.size() - pos) == m_text.substr(pos))
+                {
+                    return fail_end_of_input();
+                }
+
+                return fail_at(deserialization_errc::malformed,
+                    std::string{ "JSON error: invalid literal at position " }.append(
+                        std::to_string(pos)));
+            }
+
+            return pos + literal.size();
+        }
+
+        // Returns the position just past the closing quote of the string starting at pos
+        [[nodiscard]] auto scan_string(std::size_t pos, bool& has_escape) const -> std::size_t
+        {
+            has_escape = false;
+
+            for (++pos; pos < m_text.size(); ++pos)
+            {
+                if (m_text[pos] == '"')
+                {
+                    return pos + 1;
+                }
+
+                if (m_text[pos] == '\\')
+                {
+                    has_escape = true;
+                    ++pos;
+
+                    switch (peek(pos))
+                    {
+                        case '"':
+                        case '\\':
+                        case '/':
+                        case 'b':
+                        case 'f':
+                        case 'n':
+                        case 'r':
+                        case 't':
+                            break;
+
+                        case 'u':
+                            std::ignore = parse_hex4(pos + 1);
+
+                            if (failed())
+                            {
+                                return m_text.size();
+                            }
+
+                            pos += 4;
+                            break;
+
+                        default:
+                            if (pos >= m_text.size())
+                            {
+                                return fail_end_of_input();
+                            }
+
+                            return fail_at(deserialization_errc::malformed,
+                                "JSON error: invalid escape sequence");
+                    }
+                }
+            }
+
+            return fail_at(deserialization_errc::end_of_input, "JSON error: unterminated string");
+        }
+
+        [[nodiscard]] static constexpr auto is_number_char(const char c) noexcept -> bool
+        {
+            return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e'
+                || c == 'E';
+        }
+
+        [[nodiscard]] auto skip_digits(std::size_t pos) const noexcept -> std::size_t
+        {
+            while (pos < m_text.size() && m_text[pos] >= '0' && m_text[pos] <= '9')
+            {
+                ++pos;
+            }
+
+            return pos;
+        }
+
+        [[nodiscard]] auto fail_unexpected(const std::size_t pos) const -> std::size_t
+        {
+            if (pos >= m_text.size())
+            {
+                return fail_end_of_input();
+            }
+
+            return fail_at(deserialization_errc::malformed,
+                std::string{ "JSON error: unexpected character at position " }.append(
+                    std::to_string(pos)));
+        }
+
+        // Returns the position just past the number starting at pos, which must follow the JSON
+        // grammar: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+        [[nodiscard]] auto skip_number(const std::size_t pos) const -> std::size_t
+        {
+            auto num_end = peek(pos) == '-' ? pos + 1 : pos;
+
+            if (peek(num_end) == '0')
+            {
+                ++num_end;
+            }
+            else
+            {
+                const auto int_end = skip_digits(num_end);
+
+                if (int_end == num_end)
+                {
+                    return fail_unexpected(num_end);
+                }
+
+                num_end = int_end;
+            }
+
+            if (peek(num_end) == '.')
+            {
+                const auto frac_end = skip_digits(num_end + 1);
+
+                if (frac_end == num_end + 1)
+                {
+                    return fail_unexpected(frac_end);
+                }
+
+                num_end = frac_end;
+            }
+
+            if (peek(num_end) == 'e' || peek(num_end) == 'E')
+            {
+                ++num_end;
+
+                if (peek(num_end) == '+' || peek(num_end) == '-')
+                {
+                    ++num_end;
+                }
+
+                const auto exp_end = skip_digits(num_end);
+
+                if (exp_end == num_end)
+                {
+                    return fail_unexpected(exp_end);
+                }
+
+                num_end = exp_end;
+            }
+
+            return num_end;
+        }
+
+        // Skips past the key of the object member at pos and the colon after it, returning the
+        // position of its value
+        [[nodiscard]] auto skip_member_key(const std::size_t pos) const -> std::size_t
+        {
+            bool has_escape = false;
+
+            if (peek(pos) != '"')
+            {
+                return fail_unexpected(pos);
+            }
+
+            const auto colon_pos = skip_ws(scan_string(pos, has_escape));
+            return expect(colon_pos, ':') ? skip_ws(colon_pos + 1) : m_text.size();
+        }
+
+        // Returns the position just past the object or array starting at pos, checking its
+        // structure as it goes: every closer must match the innermost open bracket, and members
+        // and elements must be well-formed values separated by commas. The open brackets are kept
+        // in a stack rather than recursing, so deeply nested input cannot exhaust the call stack
+        [[nodiscard]] auto skip_container(std::size_t pos) const -> std::size_t
+        {
+            std::string closers{};
+
+            while (true)
+            {
+                const auto c = peek(pos);
+
+                if (c == '{' || c == '[')
+                {
+                    closers.push_back(c == '{' ? '}' : ']');
+                    pos = skip_ws(pos + 1);
+
+                    if (peek(pos) != closers.back())
+                    {
+                        pos = closers.back() == '}' ? skip_member_key(pos) : pos;
+                        continue;
+                    }
+
+                    closers.pop_back();
+                    ++pos;
+                }
+                else
+                {
+                    pos = skip_value(pos);
+                }
+
+                // After a value: close every container it ends, until a comma starts the next one
+                while (!closers.empty())
+                {
+                    pos = skip_ws(pos);
+
+                    if (peek(pos) == ',')
+                    {
+                        pos = skip_ws(pos + 1);
+                        pos = closers.back() == '}' ? skip_member_key(pos) : pos;
+                        break;
+                    }
+
+                    if (peek(pos) != closers.back())
+                    {
+                        return fail_unexpected(pos);
+                    }
+
+                    closers.pop_back();
+                    ++pos;
+                }
+
+                if (closers.empty())
+                {
+                    return pos;
+                }
+            }
+        }
+
+        [[nodiscard]] auto skip_value(std::size_t pos) const -> std::size_t
+        {
+            bool has_escape = false;
+
+            switch (peek(pos))
+            {
+                case '"':
+                    return scan_string(pos, has_escape);
+
+                case '{':
+                case '[':
+                    return skip_container(pos);
+
+                case 't':
+                    return skip_literal(pos, "true");
+
+                case 'f':
+                    return skip_literal(pos, "false");
+
+                case 'n':
+                    return skip_literal(pos, "null");
+
+                case '\0':
+                    return fail_unexpected(pos);
+
+                default:
+                    return skip_number(pos);
+            }
+        }
+
+        // End of the value at pos, reusing the result of the last parse when it was that value
+        [[nodiscard]] auto value_end(const std::size_t pos) const -> std::size_t
+        {
+            return pos == m_last_pos ? m_last_end : skip_value(pos);
+        }
+
+        [[nodiscard]] auto first_element(const std::size_t array_pos) -> std::size_t
+        {
+            const auto pos = skip_ws(array_pos + 1);
+
+            if (peek(pos) == ']')
+            {
+                m_last_pos = array_pos;
+                m_last_end = pos + 1;
+                return npos;
+            }
+
+            return pos;
+        }
+
+        [[nodiscard]] auto next_element(const std::size_t array_pos, const std::size_t prev_end)
+            -> std::size_t
+        {
+            const auto pos = skip_ws(prev_end);
+
+            if (peek(pos) == ']')
+            {
+                m_last_pos = array_pos;
+                m_last_end = pos + 1;
+                return npos;
+            }
+
+            // A missing comma ends the iteration, its error already recorded
+            return expect(pos, ',') ? skip_ws(pos + 1) : npos;
+        }
+
+        // Reads the next member of the current object, returns false once the closing brace is
+        // reached
+        [[nodiscard]] auto read_member(member& out) -> bool
+        {
+            auto pos = skip_ws(m_frame.cursor);
+
+            if (peek(pos) == '}')
+            {
+                m_frame.end = pos + 1;
+                return false;
+            }
+
+            if (pos != m_frame.first_member)
+            {
+                if (!expect(pos, ','))
+                {
+                    return end_frame();
+                }
+
+                pos = skip_ws(pos + 1);
+            }
+
+            if (!expect(pos, '"'))
+            {
+                return end_frame();
+            }
+
+            bool has_escape = false;
+            const auto key_end = scan_string(pos, has_escape);
+
+            if (failed())
+            {
+                return end_frame();
+            }
+
+            out.raw_key = m_text.substr(pos, key_end - pos);
+            pos = skip_ws(key_end);
+
+            if (!expect(pos, ':'))
+            {
+                return end_frame();
+            }
+
+            out.value_pos = skip_ws(pos + 1);
+            m_frame.cursor = out.value_pos;
+            return true;
+        }
+
+        // Ends the current object at the end of the text, after an error was recorded
+        [[nodiscard]] auto end_frame() noexcept -> bool
+        {
+            m_frame.end = m_text.size();
+            return false;
+        }
+
+        [[nodiscard]] auto key_equals(const std::string_view raw_key, const std::string_view key)
+            const -> bool
+        {
+            const auto inner = raw_key.substr(1, raw_key.size() - 2);
+
+            if (inner.find('\\') == npos)
+            {
+                return inner == key;
+            }
+
+            std::string unescaped{};
+            std::ignore = parse_string(
+                static_cast<std::size_t>(raw_key.data() - m_text.data()), unescaped);
+
+            return unescaped == key;
+        }
+
+        [[nodiscard]] auto find_field(const std::string_view key) -> std::size_t
+        {
+            if (key.empty())
+            {
+                return m_frame.value_pos;
+            }
+
+            if (m_frame.cursor == npos)
+            {
+                if (peek(m_frame.value_pos) != '{')
+                {
+                    return fail_at(deserialization_errc::type_mismatch,
+                        std::string{ "JSON error: cannot look up key '" }
+                            .append(key)
+                            .append("' in a value of type: ")
+                            .append(type_name_at(m_frame.value_pos)));
+                }
+
+                m_frame.first_member = skip_ws(m_frame.value_pos + 1);
+                m_frame.cursor = m_frame.first_member;
+            }
+
+            for (auto i = m_frame.skipped_begin; i < m_skipped.size(); ++i)
+            {
+                if (key_equals(m_skipped[i].raw_key, key))
+                {
+                    return m_skipped[i].value_pos;
+                }
+            }
+
+            member mem{};
+
+            while (m_frame.end == npos && read_member(mem))
+            {
+                if (key_equals(mem.raw_key, key))
+                {
+                    return mem.value_pos;
+                }
+
+                m_frame.cursor = skip_value(mem.value_pos);
+                m_skipped.push_back(mem);
+            }
+
+            return fail_at(deserialization_errc::missing_key,
+                std::string{ "JSON error: key '" }.append(key).append("' not found"));
+        }
+
+        void finish_field(const std::size_t pos, const std::size_t end) noexcept
+        {
+            // Members read in document order move the cursor past their value
+            if (pos == m_frame.cursor)
+            {
+                m_frame.cursor = end;
+            }
+        }
+
+        template<typename T>
+        void parse_field(const std::string_view key, T& val)
+        {
+            const auto pos = find_field(key);
+
+            if (!failed())
+            {
+                finish_field(pos, parse_value(pos, val));
+            }
+        }
+
+        // Scans any members that were not read and returns the end of the current value
+        [[nodiscard]] auto frame_end() -> std::size_t
+        {
+            if (m_frame.cursor == npos)
+            {
+                return value_end(m_frame.value_pos);
+            }
+
+            member mem{};
+
+            while (m_frame.end == npos && read_member(mem))
+            {
+                m_frame.cursor = skip_value(mem.value_pos);
+            }
+
+            return m_frame.end;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_nested(const std::size_t pos, T& val) -> std::size_t
+        {
+            const auto prev_frame = std::exchange(m_frame, frame{ pos });
+            m_frame.skipped_begin = m_skipped.size();
+
+            if constexpr (is_variant_serializable<T>)
+            {
+                parse_variant(val);
+            }
+            else
+            {
+                detail::serializer_base<serial_adapter, true>::deserialize_object(val);
+            }
+
+            const auto end = failed() ? m_text.size() : frame_end();
+
+            m_skipped.resize(m_frame.skipped_begin);
+            m_frame = prev_frame;
+            return end;
+        }
+
+        template<typename T>
+        auto parse_value(const std::size_t pos, T& val) -> std::size_t
+        {
+            const auto end = parse_value_impl(pos, val);
+            m_last_pos = pos;
+            m_last_end = end;
+            return end;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_value_impl(const std::size_t pos, T& val) -> std::size_t
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+            if constexpr (detail_json::is_raw_json_v<no_ref_t>)
+            {
+                const auto end = skip_value(pos);
+
+                if (failed())
+                {
+                    return end;
+                }
+
+#if defined(EXTENSER_HAS_EXCEPTIONS)
+                try
+                {
+                    detail_json::raw_json<no_ref_t>::parse(m_text.substr(pos, end - pos), val);
+                }
+                catch (const std::exception& ex)
+                {
+                    return fail_at(deserialization_errc::malformed, ex.what());
+                }
+#else
+                detail_json::raw_json<no_ref_t>::parse(m_text.substr(pos, end - pos), val);
+#endif
+
+                return end;
+            }
+            else if constexpr (is_null_serializable<no_ref_t>)
+            {
+                if (peek(pos) != 'n')
+                {
+                    return fail_type<no_ref_t>(pos);
+                }
+
+                return skip_literal(pos, "null");
+            }
+            else if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                switch (peek(pos))
+                {
+                    case 't':
+                        val = true;
+                        return skip_literal(pos, "true");
+
+                    case 'f':
+                        val = false;
+                        return skip_literal(pos, "false");
+
+                    default:
+                        return fail_type<bool>(pos);
+                }
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                return parse_float(pos, val);
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                return parse_integer(pos, val);
+            }
+            else if constexpr (is_enum_serializable<no_ref_t>)
+            {
+                return parse_enum(pos, val);
+            }
+            else if constexpr (is_string_serializable<no_ref_t>)
+            {
+                return parse_string_like(pos, val);
+            }
+            else if constexpr (is_multimap_serializable<no_ref_t>)
+            {
+                return parse_multimap(pos, val);
+            }
+            else if constexpr (is_map_serializable<no_ref_t>)
+            {
+                return parse_map(pos, val);
+            }
+            else if constexpr (is_array_serializable<no_ref_t>)
+            {
+                return parse_array(pos, val);
+            }
+            else if constexpr (is_optional_serializable<no_ref_t>)
+            {
+                if (peek(pos) == 'n')
+                {
+                    val.reset();
+                    return skip_literal(pos, "null");
+                }
+
+                return parse_value(pos, val.emplace());
+            }
+            else if constexpr (detail::is_pair_v<no_ref_t>)
+            {
+                auto elem_pos = skip_ws(pos + 1);
+
+                if (peek(pos) != '[')
+                {
+                    return fail_type<no_ref_t>(pos);
+                }
+
+                elem_pos = skip_ws(parse_value(elem_pos, val.first));
+
+                if (!expect(elem_pos, ','))
+                {
+                    return m_text.size();
+                }
+
+                elem_pos = skip_ws(parse_value(skip_ws(elem_pos + 1), val.second));
+                return expect(elem_pos, ']') ? elem_pos + 1 : m_text.size();
+            }
+            else if constexpr (is_tuple_serializable<no_ref_t>)
+            {
+                return parse_tuple(pos, val);
+            }
+            else if constexpr (is_variant_serializable<no_ref_t>)
+            {
+                if (peek(pos) != '{')
+                {
+                    return fail_type<no_ref_t>(pos);
+                }
+
+                return parse_nested(pos, val);
+            }
+            else
+            {
+                return parse_nested(pos, val);
+            }
+        }
+
+        // Returns the end of the number token at pos, checked against the JSON grammar first, as
+        // from_chars also accepts leading zeros and, for floats, forms like "1.", ".5" and "inf"
+        template<typename T>
+        [[nodiscard]] auto number_end(const std::size_t pos) const -> std::size_t
+        {
+            if (const auto c = peek(pos); c != '-' && (c < '0' || c > '9'))
+            {
+                return fail_type<T>(pos);
+            }
+
+            const auto end = skip_number(pos);
+
+            if (is_number_char(peek(end)))
+            {
+                return fail_at(deserialization_errc::malformed, "JSON error: invalid number");
+            }
+
+            return end;
+        }
+
+        // A fraction or exponent makes a float, which is not read into integral values. Integers
+        // are read into floating-point values, as with json_adapter
+        [[nodiscard]] auto is_float_token(const std::size_t pos, const std::size_t end) const
+            -> bool
+        {
+            return m_text.substr(pos, end - pos).find_first_of(".eE") != std::string_view::npos;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_integer(const std::size_t pos, T& val) const -> std::size_t
+        {
+            using wide_t = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+
+            const auto end = number_end<T>(pos);
+
+            if (failed())
+            {
+                return end;
+            }
+
+            if (is_float_token(pos, end))
+            {
+                return fail_type<T>(pos);
+            }
+
+            wide_t num{};
+            const auto* const first = m_text.data() + pos;
+            const auto result = std::from_chars(first, m_text.data() + end, num);
+
+            // Only a negative number read into an unsigned type is not matched
+            if (result.ec == std::errc::invalid_argument)
+            {
+                return fail_type<T>(pos);
+            }
+
+            if constexpr (std::is_same_v<T, wide_t>)
+            {
+                if (result.ec == std::errc::result_out_of_range)
+                {
+                    return fail_at(
+                        deserialization_errc::out_of_range, "JSON error: integer out of range");
+                }
+
+                val = num;
+            }
+            else
+            {
+                if (result.ec == std::errc::result_out_of_range
+                    || num < static_cast<wide_t>(std::numeric_limits<T>::min())
+                    || num > static_cast<wide_t>(std::numeric_limits<T>::max()))
+                {
+                    return fail_at(
+                        deserialization_errc::out_of_range, "JSON error: integer out of range");
+                }
+
+                val = static_cast<T>(num);
+            }
+
+            return end;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_float(const std::size_t pos, T& val) const -> std::size_t
+        {
+            static_assert(!std::is_same_v<T, long double>, "long double is not supported");
+
+            // json_text_adapter's serializer writes non-finite values as null
+            if (peek(pos) == 'n')
+            {
+                val = std::numeric_limits<T>::quiet_NaN();
+                return skip_literal(pos, "null");
+            }
+
+            const auto end = number_end<T>(pos);
+
+            if (failed())
+            {
+                return end;
+            }
+
+#if defined(__cpp_lib_to_chars)
+            const auto* const last = m_text.data() + end;
+            const auto result = std::from_chars(m_text.data() + pos, last, val);
+
+            if (result.ec != std::errc{} || result.ptr != last)
+            {
+                return fail_at(result.ec == std::errc::result_out_of_range
+                        ? deserialization_errc::out_of_range
+                        : deserialization_errc::malformed,
+                    "JSON error: invalid number");
+            }
+#else
+            std::array<char, 64> chars{};
+
+            if (end - pos >= chars.size())
+            {
+                return fail_at(deserialization_errc::malformed, "JSON error: invalid number");
+            }
+
+            m_text.copy(chars.data(), end - pos, pos);
+
+            char* p_end = nullptr;
+            const double num = std::strtod(chars.data(), &p_end);
+
+            if (p_end != chars.data() + (end - pos))
+            {
+                return fail_at(deserialization_errc::malformed, "JSON error: invalid number");
+            }
+
+            val = static_cast<T>(num);
+#endif
+
+            return end;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_enum(const std::size_t pos, T& val) -> std::size_t
+        {
+#if defined(EXTENSER_USE_MAGIC_ENUM)
+            std::string name{};
+            const auto end = parse_string(pos, name);
+
+            if (failed())
+            {
+                return end;
+            }
+
+            const auto result = magic_enum::enum_cast<T>(name);
+
+            if (!result.has_value())
+            {
+                return fail_at(deserialization_errc::invalid_value,
+                    std::string{ "Invalid enum value: \"" }
+                        .append(name)
+                        .append("\" for type: ")
+                        .append(magic_enum::enum_type_name<T>()));
+            }
+
+            val = *result;
+            return end;
+#else
+            std::underlying_type_t<T> num{};
+            const auto end = parse_integer(pos, num);
+
+            if (!failed())
+            {
+                val = static_cast<T>(num);
+            }
+
+            return end;
+#endif
+        }
+
+        static void append_utf8(std::string& out, const std::uint32_t code_point)
+        {
+            if (code_point < 0x80U)
+            {
+                out.push_back(static_cast<char>(code_point));
+            }
+            else if (code_point < 0x800U)
+            {
+                out.push_back(static_cast<char>(0xC0U | (code_point >> 6U)));
+                out.push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+            }
+            else if (code_point < 0x10000U)
+            {
+                out.push_back(static_cast<char>(0xE0U | (code_point >> 12U)));
+                out.push_back(static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU)));
+                out.push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+            }
+            else
+            {
+                out.push_back(static_cast<char>(0xF0U | (code_point >> 18U)));
+                out.push_back(static_cast<char>(0x80U | ((code_point >> 12U) & 0x3FU)));
+                out.push_back(static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU)));
+                out.push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+            }
+        }
+
+        [[nodiscard]] auto parse_hex4(const std::size_t pos) const -> std::uint32_t
+        {
+            if (pos > m_text.size() || m_text.size() - pos < 4)
+            {
+                std::ignore = fail_end_of_input();
+                return 0;
+            }
+
+            std::uint32_t code_unit{};
+            const auto* const first = m_text.data() + pos;
+            const auto result = std::from_chars(first, first + 4, code_unit, 16);
+
+            if (result.ec != std::errc{} || result.ptr != first + 4)
+            {
+                fail(deserialization_errc::malformed, "JSON error: invalid \\u escape");
+                return 0;
+            }
+
+            return code_unit;
+        }
+
+        [[nodiscard]] auto parse_string(std::size_t pos, std::string& out) const -> std::size_t
+        {
+            if (peek(pos) != '"')
+            {
+                return fail_type<std::string>(pos);
+            }
+
+            const auto start = ++pos;
+
+            while (pos < m_text.size() && m_text[pos] != '"' && m_text[pos] != '\\')
+            {
+                ++pos;
+            }
+
+            out.assign(m_text.substr(start, pos - start));
+
+            while (pos < m_text.size())
+            {
+                const auto c = m_text[pos];
+
+                if (c == '"')
+                {
+                    return pos + 1;
+                }
+
+                if (c != '\\')
+                {
+                    out.push_back(c);
+                    ++pos;
+                    continue;
+                }
+
+                switch (peek(pos + 1))
+                {
+                    case '"':
+                    case '\\':
+                    case '/':
+                        out.push_back(m_text[pos + 1]);
+                        break;
+
+                    case 'b':
+                        out.push_back('\b');
+                        break;
+
+                    case 'f':
+                        out.push_back('\f');
+                        break;
+
+                    case 'n':
+                        out.push_back('\n');
+                        break;
+
+                    case 'r':
+                        out.push_back('\r');
+                        break;
+
+                    case 't':
+                        out.push_back('\t');
+                        break;
+
+                    case 'u':
+                    {
+                        auto code_point = parse_hex4(pos + 2);
+
+                        if (failed())
+                        {
+                            return m_text.size();
+                        }
+
+                        if (code_point >= 0xD800U && code_point <= 0xDBFFU)
+                        {
+                            if (peek(pos + 6) != '\\' || peek(pos + 7) != 'u')
+                            {
+                                return fail_at(deserialization_errc::malformed,
+                                    "JSON error: invalid \\u escape");
+                            }
+
+                            const auto low = parse_hex4(pos + 8);
+
+                            if (failed())
+                            {
+                                return m_text.size();
+                            }
+
+                            if (low < 0xDC00U || low > 0xDFFFU)
+                            {
+                                return fail_at(deserialization_errc::malformed,
+                                    "JSON error: invalid \\u escape");
+                            }
+
+                            code_point = 0x10000U + ((code_point - 0xD800U) << 10U)
+                                + (low - 0xDC00U);
+                            pos += 6;
+                        }
+
+                        append_utf8(out, code_point);
+                        pos += 4;
+                        break;
+                    }
+
+                    default:
+                        return fail_at(
+                            deserialization_errc::malformed, "JSON error: invalid escape sequence");
+                }
+
+                pos += 2;
+            }
+
+            return fail_at(deserialization_errc::end_of_input, "JSON error: unterminated string");
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_string_like(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                return parse_string(pos, val);
+            }
+            else if constexpr (!traits_t::is_mutable)
+            {
+                std::ignore = val;
+                return skip_value(pos);
+            }
+            else if constexpr (std::is_same_v<typename traits_t::value_type, char>)
+            {
+                std::string str{};
+                const auto end = parse_string(pos, str);
+
+                if (failed())
+                {
+                    return end;
+                }
+
+                if constexpr (traits_t::has_fixed_size)
+                {
+                    if (str.size() > adapter_t::size(val))
+                    {
+                        return fail_at(
+                            deserialization_errc::out_of_range, "JSON error: array out of bounds");
+                    }
+                }
+
+                adapter_t::assign_from_range(
+                    val, str.cbegin(), str.cend(), [](const char c) { return c; });
+
+                return end;
+            }
+            else
+            {
+                // Non-char strings are arrays of code units
+                return parse_array(pos, val);
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_array(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using value_t = detail::remove_cvref_t<typename traits_t::value_type>;
+
+            if (peek(pos) != '[')
+            {
+                return fail_type<T>(pos);
+            }
+
+            if constexpr (traits_t::is_mutable)
+            {
+                // After an error, the iterator ends at the element that raised it
+                const element_iterator first{ *this, pos };
+                const element_iterator last{};
+
+                if constexpr (traits_t::has_fixed_size)
+                {
+                    if (static_cast<std::size_t>(std::distance(first, last))
+                        != adapter_t::size(val))
+                    {
+                        return fail_at(
+                            deserialization_errc::out_of_range, "JSON error: array out of bounds");
+                    }
+                }
+
+                std::size_t index = 0;
+
+                const auto parse_elem = [this, &index](const std::size_t elem_pos)
+                {
+                    auto elem = detail::make_value<value_t>();
+                    const path_guard trace{ *this, index++ };
+                    parse_value(elem_pos, elem);
+                    return elem;
+                };
+
+                if constexpr (traits_t::is_sequential)
+                {
+                    adapter_t::assign_from_range(val, first, last, parse_elem);
+                }
+                else
+                {
+                    for (auto it = first; it != last; ++it)
+                    {
+                        adapter_t::insert_value(val, *it, parse_elem);
+                    }
+                }
+            }
+            else
+            {
+                std::ignore = val;
+            }
+
+            return failed() ? m_text.size() : value_end(pos);
+        }
+
+        // Map keys follow json_adapter's convention, see serializer::push_key()
+        template<typename Key>
+        [[nodiscard]] auto parse_key(const std::size_t key_pos) -> Key
+        {
+            std::string key_str{};
+            std::ignore = parse_string(key_pos, key_str);
+
+            if (!key_str.empty() && key_str.front() == '@')
+            {
+                if (key_str.size() <= 1 || key_str[1] != '@')
+                {
+                    deserializer key_des{ std::string_view{ key_str }.substr(1) };
+                    auto key = detail::make_value<Key>();
+                    auto result = key_des.try_deserialize_object(key);
+
+                    // The key's text is complete, so its end is not the end of the input
+                    if (!result)
+                    {
+                        fail(result.code == deserialization_errc::end_of_input
+                                ? deserialization_errc::malformed
+                                : result.code,
+                            std::move(result.message));
+                    }
+
+                    return key;
+                }
+
+                // Escaped '@' in string value
+                key_str.erase(0, 1);
+            }
+
+            if constexpr (std::is_same_v<Key, std::string>)
+            {
+                return key_str;
+            }
+            else
+            {
+                auto key = detail::make_value<Key>();
+                parse_value(key_pos, key);
+                return key;
+            }
+        }
+
+        // Calls on_member(key_pos, value_pos) for each member of the object at pos and returns the
+        // end of the object
+        template<typename F>
+        [[nodiscard]] auto for_each_member(std::size_t pos, F&& on_member) -> std::size_t
+        {
+            pos = skip_ws(pos + 1);
+
+            if (peek(pos) == '}')
+            {
+                return pos + 1;
+            }
+
+            while (true)
+            {
+                if (!expect(pos, '"'))
+                {
+                    return m_text.size();
+                }
+
+                bool has_escape = false;
+                const auto key_pos = pos;
+                const auto key_end = scan_string(pos, has_escape);
+                pos = skip_ws(key_end);
+
+                if (!expect(pos, ':'))
+                {
+                    return m_text.size();
+                }
+
+                const auto value_pos = skip_ws(pos + 1);
+
+                {
+                    const path_guard trace{ *this,
+                        m_text.substr(key_pos + 1, key_end - key_pos - 2) };
+
+                    on_member(key_pos, value_pos);
+                }
+
+                if (failed())
+                {
+                    return m_text.size();
+                }
+
+                pos = skip_ws(value_end(value_pos));
+
+                if (peek(pos) == '}')
+                {
+                    return pos + 1;
+                }
+
+                if (!expect(pos, ','))
+                {
+                    return m_text.size();
+                }
+
+                pos = skip_ws(pos + 1);
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_map(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using key_t = typename traits_t::key_type;
+            using mapped_t = typename traits_t::mapped_type;
+
+            if (peek(pos) != '{')
+            {
+                return fail_type<T>(pos);
+            }
+
+            return for_each_member(pos,
+                [this, &val](const std::size_t key_pos, const std::size_t value_pos)
+                {
+                    adapter_t::insert_value(val, value_pos,
+                        [this, key_pos](const std::size_t mapped_pos)
+                        {
+                            std::pair<key_t, mapped_t> kv_pair{ parse_key<key_t>(key_pos),
+                                detail::make_value<mapped_t>() };
+                            parse_value(mapped_pos, kv_pair.second);
+                            return kv_pair;
+                        });
+                });
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_multimap(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using key_t = typename traits_t::key_type;
+            using mapped_t = typename traits_t::mapped_type;
+
+            if (peek(pos) != '{')
+            {
+                return fail_type<T>(pos);
+            }
+
+            return for_each_member(pos,
+                [this, &val](const std::size_t key_pos, const std::size_t value_pos)
+                {
+                    if (peek(value_pos) != '[')
+                    {
+                        std::ignore = fail_type<std::vector<mapped_t>>(value_pos);
+                        return;
+                    }
+
+                    const auto key = parse_key<key_t>(key_pos);
+
+                    for (element_iterator it{ *this, value_pos }; it != element_iterator{}; ++it)
+                    {
+                        adapter_t::insert_value(val, *it,
+                            [this, &key](const std::size_t mapped_pos)
+                            {
+                                std::pair<key_t, mapped_t> kv_pair{ key,
+                                    detail::make_value<mapped_t>() };
+                                parse_value(mapped_pos, kv_pair.second);
+                                return kv_pair;
+                            });
+                    }
+                });
+        }
+
+        template<typename... Args>
+        [[nodiscard]] auto parse_tuple(const std::size_t pos, std::tuple<Args...>& val)
+            -> std::size_t
+        {
+            if (peek(pos) != '[')
+            {
+                return fail_type<std::tuple<Args...>>(pos);
+            }
+
+            auto elem_pos = skip_ws(pos + 1);
+            bool first = true;
+
+            std::apply(
+                [this, &elem_pos, &first](auto&... elems)
+                {
+                    const auto parse_elem = [this, &elem_pos, &first](auto& elem)
+                    {
+                        if (failed())
+                        {
+                            return;
+                        }
+
+                        if (!std::exchange(first, false))
+                        {
+                            if (peek(elem_pos) != ',')
+                            {
+                                elem_pos = fail_at(deserialization_errc::out_of_range,
+                                    "JSON error: invalid number of args");
+
+                                return;
+                            }
+
+                            elem_pos = skip_ws(elem_pos + 1);
+                        }
+
+                        if (peek(elem_pos) == ']')
+                        {
+                            elem_pos = fail_at(deserialization_errc::out_of_range,
+                                "JSON error: invalid number of args");
+
+                            return;
+                        }
+
+                        elem_pos = skip_ws(parse_value(elem_pos, elem));
+                    };
+
+                    (parse_elem(elems), ...);
+                },
+                val);
+
+            if (failed())
+            {
+                return m_text.size();
+            }
+
+            if (peek(elem_pos) != ']')
+            {
+                return fail_at(
+                    deserialization_errc::out_of_range, "JSON error: invalid number of args");
+            }
+
+            return elem_pos + 1;
+        }
+
+        template<typename... Args>
+        void parse_variant(std::variant<Args...>& val)
+        {
+            if constexpr (detail::is_tagged_variant_v<std::variant<Args...>>)
+            {
+                parse_tagged_variant(val);
+                return;
+            }
+
+            static constexpr std::size_t arg_sz = sizeof...(Args);
+
+            std::size_t v_idx{};
+            parse_field("v_idx", v_idx);
+
+            if (failed())
+            {
+                return;
+            }
+
+            if (v_idx >= arg_sz)
+            {
+                fail(deserialization_errc::out_of_range,
+                    std::string{ "JSON error: variant index exceeded variant size: " }.append(
+                        std::to_string(arg_sz)));
+
+                return;
+            }
+
+            const auto v_pos = find_field("v_val");
+
+            if (!failed())
+            {
+                finish_field(v_pos, parse_variant_alt(v_pos, v_idx, val));
+            }
+        }
+
+        // A tagged variant is an object whose only member is keyed by the held alternative's tag
+        template<typename... Args>
+        void parse_tagged_variant(std::variant<Args...>& val)
+        {
+            using index_t = detail::variant_tag_index<std::variant<Args...>>;
+
+            m_frame.first_member = skip_ws(m_frame.value_pos + 1);
+            m_frame.cursor = m_frame.first_member;
+
+            member mem{};
+
+            if (!read_member(mem))
+            {
+                fail(deserialization_errc::type_mismatch,
+                    "JSON error: a tagged variant must be an object with a single member");
+
+                return;
+            }
+
+            std::string unescaped{};
+            std::string_view name = mem.raw_key.substr(1, mem.raw_key.size() - 2);
+
+            if (name.find('\\') != npos)
+            {
+                std::ignore = parse_string(
+                    static_cast<std::size_t>(mem.raw_key.data() - m_text.data()), unescaped);
+                name = unescaped;
+            }
+
+            const auto v_idx = index_t::find(name);
+
+            if (v_idx == index_t::npos)
+            {
+                fail(deserialization_errc::invalid_value,
+                    std::string{ "JSON error: unknown variant tag: " }.append(name));
+
+                return;
+            }
+
+            finish_field(mem.value_pos, parse_variant_alt(mem.value_pos, v_idx, val));
+
+            if (!failed() && read_member(mem))
+            {
+                fail(deserialization_errc::type_mismatch,
+                    "JSON error: a tagged variant must be an object with a single member");
+            }
+        }
+
+        template<typename... Args>
+        [[nodiscard]] auto parse_variant_alt(const std::size_t pos, const std::size_t v_idx,
+            std::variant<Args...>& val) -> std::size_t
+        {
+            return detail::visit_index<std::variant<Args...>>(v_idx,
+                [this, pos, &val](auto idx_constant) -> std::size_t
+                {
+                    static constexpr std::size_t alt_idx = decltype(idx_constant)::value;
+                    return parse_value(pos, val.template emplace<alt_idx>());
+                });
+        }
+
+        const std::string* m_p_text{ nullptr };
+        std::string_view m_text{};
+        frame m_frame{};
+        std::vector<member> m_skipped{};
+        std::size_t m_last_pos{ npos };
+        std::size_t m_last_end{ npos };
+    };
+} //namespace detail_json_text
+
+using json_text_adapter = detail_json_text::serial_adapter;
+} //namespace extenser
+#endif //EXTENSER_JSON_TEXT_HPP
@@ -0,0 +1,202 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_MAPPED_FILE_HPP
+#define EXTENSER_MAPPED_FILE_HPP
+
+#include "extenser.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#  if !defined(NOMINMAX)
+#    define NOMINMAX
+#  endif
+#  if !defined(WIN32_LEAN_AND_MEAN)
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace extenser
+{
+// A whole file mapped read-only into memory, so deserializers taking a view<std::uint8_t> (or, for
+// json_text_adapter, a std::string_view) read it in place and its pages are only loaded as they
+// are touched. The file must not be modified while mapped, and views deserialized from it point
+// into the mapping, so it must outlive them
+class mapped_file
+{
+public:
+    // Throws deserialization_error if the file cannot be opened or mapped
+    explicit mapped_file(const std::string& path)
+    {
+#if defined(_WIN32)
+        const HANDLE h_file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (h_file == INVALID_HANDLE_VALUE)
+        {
+            throw_error("failed to open", path, static_cast<int>(::GetLastError()));
+        }
+
+        LARGE_INTEGER file_size{};
+
+        if (::GetFileSizeEx(h_file, &file_size) == 0)
+        {
+            const auto error = static_cast<int>(::GetLastError());
+            ::CloseHandle(h_file);
+            throw_error("failed to read the size of", path, error);
+        }
+
+        m_size = static_cast<std::size_t>(file_size.QuadPart);
+
+        // An empty file cannot be mapped, it is read as no bytes
+        if (m_size != 0)
+        {
+            const HANDLE h_mapping =
+                ::CreateFileMappingA(h_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (h_mapping != nullptr)
+            {
+                m_p_data = static_cast<const std::uint8_t*>(
+                    ::MapViewOfFile(h_mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+
+            const auto error = static_cast<int>(::GetLastError());
+
+            // The view keeps the file mapped once both handles are closed
+            if (h_mapping != nullptr)
+            {
+                ::CloseHandle(h_mapping);
+            }
+
+            if (m_p_data == nullptr)
+            {
+                ::CloseHandle(h_file);
+                throw_error("failed to map", path, error);
+            }
+        }
+
+        ::CloseHandle(h_file);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd == -1)
+        {
+            throw_error("failed to open", path, errno);
+        }
+
+        struct stat file_stat{};
+
+        if (::fstat(fd, &file_stat) == -1)
+        {
+            const auto error = errno;
+            ::close(fd);
+            throw_error("failed to read the size of", path, error);
+        }
+
+        m_size = static_cast<std::size_t>(file_stat.st_size);
+
+        // An empty file cannot be mapped, it is read as no bytes
+        if (m_size != 0)
+        {
+            void* const p_map = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (p_map == MAP_FAILED)
+            {
+                const auto error = errno;
+                ::close(fd);
+                throw_error("failed to map", path, error);
+            }
+
+            m_p_data = static_cast<const std::uint8_t*>(p_map);
+        }
+
+        // The mapping stays valid once the descriptor is closed
+        ::close(fd);
+#endif
+    }
+
+    mapped_file(mapped_file&& other) noexcept
+        : m_p_data(std::exchange(other.m_p_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    auto operator=(mapped_file&& other) noexcept -> mapped_file&
+    {
+        if (this != &other)
+        {
+            unmap();
+            m_p_data = std::exchange(other.m_p_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+
+        return *this;
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    auto operator=(const mapped_file&) -> mapped_file& = delete;
+
+    ~mapped_file() noexcept { unmap(); }
+
+    [[nodiscard]] auto data() const noexcept -> const std::uint8_t* { return m_p_data; }
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+    [[nodiscard]] auto bytes() const noexcept -> view<std::uint8_t>
+    {
+        return m_size == 0 ? view<std::uint8_t>{} : view<std::uint8_t>{ m_p_data, m_size };
+    }
+
+    [[nodiscard]] auto text() const noexcept -> std::string_view
+    {
+        return m_size == 0 ? std::string_view{}
+                           : std::string_view{ reinterpret_cast<const char*>(m_p_data), m_size };
+    }
+
+private:
+    [[noreturn]] static void throw_error(
+        const char* const action, const std::string& path, const int error)
+    {
+        throw deserialization_error{ std::string{ "mapped_file error: " }
+                .append(action)
+                .append(" '")
+                .append(path)
+                .append("': ")
+                .append(std::system_category().message(error)) };
+    }
+
+    void unmap() noexcept
+    {
+        if (m_p_data != nullptr)
+        {
+#if defined(_WIN32)
+            ::UnmapViewOfFile(m_p_data);
+#else
+            ::munmap(const_cast<std::uint8_t*>(m_p_data), m_size);
+#endif
+            m_p_data = nullptr;
+        }
+    }
+
+    const std::uint8_t* m_p_data{ nullptr };
+    std::size_t m_size{};
+};
+} //namespace extenser
+#endif //EXTENSER_MAPPED_FILE_HPP
@@ -0,0 +1,94 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_MEMORY_RESOURCE_HPP
+#define EXTENSER_MEMORY_RESOURCE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<memory_resource>)
+#  include <memory_resource>
+#endif
+
+#if defined(__cpp_lib_memory_resource)
+#  define EXTENSER_HAS_MEMORY_RESOURCE
+#endif
+
+namespace extenser
+{
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+namespace detail
+{
+    // The resource deserializers on this thread build new values with, nullptr for the default
+    // construction of each type
+    inline auto current_resource() noexcept -> std::pmr::memory_resource*&
+    {
+        static thread_local std::pmr::memory_resource* t_p_resource{ nullptr };
+        return t_p_resource;
+    }
+} //namespace detail
+
+// Makes every value deserialized on this thread, while in scope, that is allocator-aware (such as
+// std::pmr containers, or a user type with an allocator_type) allocate from p_resource. Values
+// that are not allocator-aware are unaffected. Scopes nest, and a nullptr restores the default
+// behavior
+class scoped_resource
+{
+public:
+    explicit scoped_resource(std::pmr::memory_resource* const p_resource) noexcept
+        : m_p_previous(std::exchange(detail::current_resource(), p_resource))
+    {
+    }
+
+    ~scoped_resource() noexcept { detail::current_resource() = m_p_previous; }
+
+    scoped_resource(const scoped_resource&) = delete;
+    scoped_resource(scoped_resource&&) = delete;
+    auto operator=(const scoped_resource&) -> scoped_resource& = delete;
+    auto operator=(scoped_resource&&) -> scoped_resource& = delete;
+
+private:
+    std::pmr::memory_resource* m_p_previous;
+};
+#endif
+
+namespace detail
+{
+    // Creates the value a deserializer fills in, using the current resource when T can take one
+    template<typename T>
+    [[nodiscard]] auto make_value() -> T
+    {
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+        using allocator_t = std::pmr::polymorphic_allocator<std::byte>;
+
+        if constexpr (std::uses_allocator_v<T, allocator_t>)
+        {
+            if (const auto p_resource = current_resource(); p_resource != nullptr)
+            {
+                if constexpr (std::is_constructible_v<T, std::allocator_arg_t, const allocator_t&>)
+                {
+                    return T(std::allocator_arg, allocator_t{ p_resource });
+                }
+                else
+                {
+                    return T(allocator_t{ p_resource });
+                }
+            }
+        }
+#endif
+
+        return T{};
+    }
+} //namespace detail
+} //namespace extenser
+
+#endif //EXTENSER_MEMORY_RESOURCE_HPP
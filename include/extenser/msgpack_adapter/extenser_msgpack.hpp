@@ -0,0 +1,2153 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_MSGPACK_HPP
+#define EXTENSER_MSGPACK_HPP
+
+#include "../extenser.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace extenser
+{
+namespace detail_msgpack
+{
+    class serializer;
+    class deserializer;
+
+    struct serial_adapter
+    {
+        using bytes_t = std::vector<std::uint8_t>;
+        using serial_t = std::vector<std::uint8_t>;
+        using serializer_t = serializer;
+        using deserializer_t = deserializer;
+        using config = void;
+    };
+
+    // First bytes of the MessagePack formats, the fix* formats carry their value or length in the
+    // low bits of a range of first bytes
+    namespace tag
+    {
+        inline constexpr std::uint8_t positive_fixint_max = 0x7FU;
+        inline constexpr std::uint8_t fixmap = 0x80U;
+        inline constexpr std::uint8_t fixarray = 0x90U;
+        inline constexpr std::uint8_t fixstr = 0xA0U;
+        inline constexpr std::uint8_t nil = 0xC0U;
+        inline constexpr std::uint8_t false_value = 0xC2U;
+        inline constexpr std::uint8_t true_value = 0xC3U;
+        inline constexpr std::uint8_t bin8 = 0xC4U;
+        inline constexpr std::uint8_t bin16 = 0xC5U;
+        inline constexpr std::uint8_t bin32 = 0xC6U;
+        inline constexpr std::uint8_t ext8 = 0xC7U;
+        inline constexpr std::uint8_t ext16 = 0xC8U;
+        inline constexpr std::uint8_t ext32 = 0xC9U;
+        inline constexpr std::uint8_t float32 = 0xCAU;
+        inline constexpr std::uint8_t float64 = 0xCBU;
+        inline constexpr std::uint8_t uint8 = 0xCCU;
+        inline constexpr std::uint8_t uint16 = 0xCDU;
+        inline constexpr std::uint8_t uint32 = 0xCEU;
+        inline constexpr std::uint8_t uint64 = 0xCFU;
+        inline constexpr std::uint8_t int8 = 0xD0U;
+        inline constexpr std::uint8_t int16 = 0xD1U;
+        inline constexpr std::uint8_t int32 = 0xD2U;
+        inline constexpr std::uint8_t int64 = 0xD3U;
+        inline constexpr std::uint8_t fixext1 = 0xD4U;
+        inline constexpr std::uint8_t fixext2 = 0xD5U;
+        inline constexpr std::uint8_t fixext4 = 0xD6U;
+        inline constexpr std::uint8_t fixext8 = 0xD7U;
+        inline constexpr std::uint8_t fixext16 = 0xD8U;
+        inline constexpr std::uint8_t str8 = 0xD9U;
+        inline constexpr std::uint8_t str16 = 0xDAU;
+        inline constexpr std::uint8_t str32 = 0xDBU;
+        inline constexpr std::uint8_t array16 = 0xDCU;
+        inline constexpr std::uint8_t array32 = 0xDDU;
+        inline constexpr std::uint8_t map16 = 0xDEU;
+        inline constexpr std::uint8_t map32 = 0xDFU;
+        inline constexpr std::uint8_t negative_fixint = 0xE0U;
+    } //namespace tag
+
+    // Contiguous containers of bytes are written as MessagePack bin, in a single copy
+    template<typename T, typename = void>
+    struct is_byte_container : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_byte_container<T, std::enable_if_t<containers::is_bulk_copyable_v<T>>> :
+        std::bool_constant<
+            std::is_same_v<std::remove_cv_t<typename containers::traits<T>::value_type>,
+                unsigned char>
+            || std::is_same_v<std::remove_cv_t<typename containers::traits<T>::value_type>,
+                std::byte>>
+    {
+    };
+
+    template<typename T>
+    inline constexpr bool is_byte_container_v = is_byte_container<T>::value;
+
+    // Views that are deserialized in place, pointing into the input
+    template<typename T>
+    inline constexpr bool is_borrowed_v = std::is_same_v<T, std::string_view>
+        || std::is_same_v<T, view<std::uint8_t>> || std::is_same_v<T, view<std::byte>>;
+
+    template<typename T, typename U>
+    [[nodiscard]] constexpr auto convert(const U num) noexcept -> T
+    {
+        if constexpr (std::is_same_v<T, U>)
+        {
+            return num;
+        }
+        else
+        {
+            return static_cast<T>(num);
+        }
+    }
+
+    // Writes MessagePack directly to a byte vector as values are visited. Objects become maps
+    // from field name to value, other types use the smallest MessagePack format that holds them
+    class serializer : public detail::serializer_base<serial_adapter, false>
+    {
+    public:
+        serializer() noexcept = default;
+        explicit serializer(const std::vector<std::uint8_t>& bytes) : m_bytes(bytes) {}
+
+        explicit serializer(std::vector<std::uint8_t>&& bytes) noexcept
+            : m_bytes(std::move(bytes))
+        {
+        }
+
+        // Writes to the caller's vector instead of an owned one, its capacity is reused between
+        // calls to serialize_object()
+        explicit serializer(const std::reference_wrapper<std::vector<std::uint8_t>> out) noexcept
+            : m_p_out(&out.get())
+        {
+            m_p_out->clear();
+        }
+
+        // A copy would write to the same caller's vector, moving hands it over
+        serializer(const serializer&) = delete;
+        serializer(serializer&&) noexcept = default;
+        auto operator=(const serializer&) -> serializer& = delete;
+        auto operator=(serializer&&) noexcept -> serializer& = default;
+        ~serializer() noexcept = default;
+
+        template<typename T>
+        void serialize_object(const T& val)
+        {
+            buffer().clear();
+            m_frame = frame{};
+            m_frame.wide = starts_wide<T>();
+            m_depth = 0;
+
+            detail::serializer_base<serial_adapter, false>::serialize_object(val);
+            end_object();
+        }
+
+        [[nodiscard]] auto object() const& noexcept -> const std::vector<std::uint8_t>&
+        {
+            return m_p_out == nullptr ? m_bytes : *m_p_out;
+        }
+
+        [[nodiscard]] auto object() && noexcept -> std::vector<std::uint8_t>&&
+        {
+            return std::move(buffer());
+        }
+
+        // Used by serialize_parallel() and serialize_to(): each chunk of a split array is written
+        // as just its elements, then splice_array() puts the array header in front of the chunks
+        // (serialize_to() writes serialize_array_head(), the chunks and serialize_array_tail())
+        template<typename It>
+        void serialize_elements(It first, const It last)
+        {
+            buffer().clear();
+            m_frame = frame{};
+            m_depth = 0;
+
+            for (; first != last; ++first)
+            {
+                push_arg(*first);
+            }
+        }
+
+        template<typename T>
+        void splice_array(const T& val, std::vector<std::vector<std::uint8_t>>& chunks)
+        {
+            serialize_array_head(val);
+
+            auto& out = buffer();
+            out.reserve(std::accumulate(chunks.begin(), chunks.end(), out.size(),
+                [](const std::size_t size, const std::vector<std::uint8_t>& chunk)
+                { return size + chunk.size(); }));
+
+            for (const auto& chunk : chunks)
+            {
+                out.insert(out.end(), chunk.begin(), chunk.end());
+            }
+        }
+
+        template<typename T>
+        void serialize_array_head(const T& val)
+        {
+            buffer().clear();
+            m_frame = frame{};
+            m_depth = 0;
+
+            put_header(static_cast<std::size_t>(std::distance(std::begin(val), std::end(val))),
+                tag::fixarray, 0x0FU, 0, tag::array16);
+        }
+
+        // Elements follow each other and the array ends with its last one
+        void serialize_array_tail() { buffer().clear(); }
+
+        [[nodiscard]] static constexpr auto element_separator() noexcept -> std::string_view
+        {
+            return {};
+        }
+
+        void as_bool(const std::string_view key, const bool val)
+        {
+            begin_field(key);
+            push_bool(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_float(const std::string_view key, const T val)
+        {
+            static_assert(!std::is_same_v<T, long double>, "long double is not supported");
+
+            begin_field(key);
+            push_float(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_int(const std::string_view key, const T val)
+        {
+            static_assert(sizeof(T) <= sizeof(std::int64_t), "maximum 64-bit integers supported");
+            static_assert(
+                std::is_integral_v<T> && std::is_signed_v<T>, "only signed integers are supported");
+
+            begin_field(key);
+            push_integer(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_uint(const std::string_view key, const T val)
+        {
+            static_assert(sizeof(T) <= sizeof(std::int64_t), "maximum 64-bit integers supported");
+            static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>,
+                "only unsigned integers are supported");
+
+            begin_field(key);
+            push_integer(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_enum(const std::string_view key, const T val)
+        {
+            static_assert(std::is_enum_v<T>, "T must be an enum type");
+
+            begin_field(key);
+            push_integer(static_cast<std::underlying_type_t<T>>(val));
+            end_field();
+        }
+
+        template<typename T>
+        void as_string(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_string(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_array(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_array(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_map(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_map(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_multimap(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_multimap(val);
+            end_field();
+        }
+
+        template<typename T1, typename T2>
+        void as_tuple(const std::string_view key, const std::pair<T1, T2>& val)
+        {
+            begin_field(key);
+            push_pair(val);
+            end_field();
+        }
+
+        template<typename... Args>
+        void as_tuple(const std::string_view key, const std::tuple<Args...>& val)
+        {
+            begin_field(key);
+            push_tuple(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_optional(const std::string_view key, const std::optional<T>& val)
+        {
+            begin_field(key);
+            push_optional(val);
+            end_field();
+        }
+
+        template<typename... Args>
+        void as_variant(const std::string_view key, const std::variant<Args...>& val)
+        {
+            begin_field(key);
+            push_variant(val);
+            end_field();
+        }
+
+        template<typename T>
+        void as_object(const std::string_view key, const T& val)
+        {
+            begin_field(key);
+            push_arg(val);
+            end_field();
+        }
+
+        void as_null(const std::string_view key)
+        {
+            begin_field(key);
+            buffer().push_back(tag::nil);
+            end_field();
+        }
+
+    private:
+        // Keyed fields are counted into a fixmap header, widened in place to a map16 when a 16th
+        // field is written. Types declaring more field keys than a fixmap holds start with a map16
+        static constexpr std::size_t max_fields = std::numeric_limits<std::uint16_t>::max();
+        static constexpr std::size_t max_fixmap_fields = 0x0FU;
+
+        template<typename T>
+        [[nodiscard]] static constexpr auto starts_wide() noexcept -> bool
+        {
+            if constexpr (detail::has_field_keys_v<T>)
+            {
+                return field_keys<T>::value.size() > max_fixmap_fields;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        // State of the object currently being written: nothing yet, a map of keyed fields, or a
+        // single unkeyed value
+        enum class frame_state : std::uint8_t
+        {
+            empty,
+            keyed,
+            unkeyed,
+        };
+
+        struct frame
+        {
+            frame_state state{ frame_state::empty };
+            std::size_t header_pos{};
+            std::size_t field_count{};
+            bool wide{ false };
+        };
+
+        [[nodiscard]] auto buffer() noexcept -> std::vector<std::uint8_t>&
+        {
+            return m_p_out == nullptr ? m_bytes : *m_p_out;
+        }
+
+        void begin_field(const std::string_view key)
+        {
+            auto& out = buffer();
+
+            if (key.empty())
+            {
+                if (m_frame.state != frame_state::empty)
+                {
+                    if (m_depth != 0)
+                    {
+                        EXTENSER_THROW(serialization_error{
+                            "MessagePack error: unkeyed value written to an object that already "
+                            "has content" });
+                    }
+
+                    // Top-level unkeyed values replace the document, as they do in json_adapter
+                    out.clear();
+                }
+
+                m_frame.state = frame_state::unkeyed;
+                return;
+            }
+
+            switch (m_frame.state)
+            {
+                case frame_state::empty:
+                    m_frame.state = frame_state::keyed;
+                    m_frame.header_pos = out.size();
+
+                    if (m_frame.wide)
+                    {
+                        out.insert(out.end(), { tag::map16, 0, 0 });
+                    }
+                    else
+                    {
+                        out.push_back(tag::fixmap);
+                    }
+
+                    break;
+
+                case frame_state::keyed:
+                    break;
+
+                case frame_state::unkeyed:
+                default:
+                    EXTENSER_THROW(serialization_error{ "MessagePack error: keyed value written to "
+                                                        "an object holding an unkeyed value" });
+            }
+
+            if (++m_frame.field_count > max_fields)
+            {
+                EXTENSER_THROW(
+                    serialization_error{ "MessagePack error: too many fields in one object" });
+            }
+
+            if (!m_frame.wide && m_frame.field_count > max_fixmap_fields)
+            {
+                const auto header = out.begin() + static_cast<std::ptrdiff_t>(m_frame.header_pos);
+
+                *header = tag::map16;
+                out.insert(header + 1, 2, 0);
+                m_frame.wide = true;
+            }
+
+            push_string(key);
+        }
+
+        void end_field()
+        {
+            // The top-level map is kept complete between fields, so object() is always a valid
+            // document
+            if (m_depth == 0 && m_frame.state == frame_state::keyed)
+            {
+                write_field_count();
+            }
+        }
+
+        void write_field_count()
+        {
+            auto& out = buffer();
+
+            if (m_frame.wide)
+            {
+                out[m_frame.header_pos + 1] = static_cast<std::uint8_t>(m_frame.field_count >> 8U);
+                out[m_frame.header_pos + 2] = static_cast<std::uint8_t>(m_frame.field_count);
+            }
+            else
+            {
+                out[m_frame.header_pos] =
+                    static_cast<std::uint8_t>(tag::fixmap | m_frame.field_count);
+            }
+        }
+
+        void end_object()
+        {
+            auto& out = buffer();
+
+            if (m_frame.state == frame_state::empty)
+            {
+                out.push_back(tag::nil);
+            }
+            else if (m_frame.state == frame_state::keyed)
+            {
+                write_field_count();
+            }
+        }
+
+        // Writes tag followed by the low byte_count bytes of val, big-endian
+        void put(const std::uint8_t tag_byte, const std::uint64_t val, const std::size_t byte_count)
+        {
+            std::array<std::uint8_t, 9> bytes{ tag_byte };
+
+            for (std::size_t i = 0; i < byte_count; ++i)
+            {
+                bytes[byte_count - i] = static_cast<std::uint8_t>(val >> (8U * i));
+            }
+
+            auto& out = buffer();
+            out.insert(out.end(), bytes.begin(),
+                bytes.begin() + static_cast<std::ptrdiff_t>(byte_count + 1));
+        }
+
+        // Writes the header of a str, bin, array or map. fix_max is 0 for formats without a fix
+        // variant, size8 is 0 for formats without an 8-bit length
+        void put_header(const std::size_t size, const std::uint8_t fix_base,
+            const std::size_t fix_max, const std::uint8_t size8, const std::uint8_t size16)
+        {
+            if (size <= fix_max)
+            {
+                buffer().push_back(static_cast<std::uint8_t>(fix_base | size));
+            }
+            else if (size8 != 0 && size <= std::numeric_limits<std::uint8_t>::max())
+            {
+                put(size8, size, 1);
+            }
+            else if (size <= std::numeric_limits<std::uint16_t>::max())
+            {
+                put(size16, size, 2);
+            }
+            else if (size <= std::numeric_limits<std::uint32_t>::max())
+            {
+                // The 32-bit format always follows the 16-bit one
+                put(static_cast<std::uint8_t>(size16 + 1), size, 4);
+            }
+            else
+            {
+                EXTENSER_THROW(serialization_error{ "MessagePack error: size exceeds 32 bits" });
+            }
+        }
+
+        void push_bool(const bool arg)
+        {
+            buffer().push_back(arg ? tag::true_value : tag::false_value);
+        }
+
+        void push_uint(const std::uint64_t arg)
+        {
+            if (arg <= tag::positive_fixint_max)
+            {
+                buffer().push_back(static_cast<std::uint8_t>(arg));
+            }
+            else if (arg <= std::numeric_limits<std::uint8_t>::max())
+            {
+                put(tag::uint8, arg, 1);
+            }
+            else if (arg <= std::numeric_limits<std::uint16_t>::max())
+            {
+                put(tag::uint16, arg, 2);
+            }
+            else if (arg <= std::numeric_limits<std::uint32_t>::max())
+            {
+                put(tag::uint32, arg, 4);
+            }
+            else
+            {
+                put(tag::uint64, arg, 8);
+            }
+        }
+
+        // Negative values only, non-negative signed values use the unsigned formats
+        void push_negative(const std::int64_t arg)
+        {
+            if (arg >= -32)
+            {
+                buffer().push_back(static_cast<std::uint8_t>(arg));
+            }
+            else if (arg >= std::numeric_limits<std::int8_t>::min())
+            {
+                put(tag::int8, static_cast<std::uint64_t>(arg), 1);
+            }
+            else if (arg >= std::numeric_limits<std::int16_t>::min())
+            {
+                put(tag::int16, static_cast<std::uint64_t>(arg), 2);
+            }
+            else if (arg >= std::numeric_limits<std::int32_t>::min())
+            {
+                put(tag::int32, static_cast<std::uint64_t>(arg), 4);
+            }
+            else
+            {
+                put(tag::int64, static_cast<std::uint64_t>(arg), 8);
+            }
+        }
+
+        template<typename T>
+        void push_integer(const T arg)
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (arg < 0)
+                {
+                    push_negative(arg);
+                    return;
+                }
+            }
+
+            push_uint(static_cast<std::uint64_t>(arg));
+        }
+
+        template<typename T>
+        void push_float(const T arg)
+        {
+            if constexpr (std::is_same_v<T, float>)
+            {
+                std::uint32_t bits{};
+                std::memcpy(&bits, &arg, sizeof(bits));
+                put(tag::float32, bits, 4);
+            }
+            else
+            {
+                const auto dbl = convert<double>(arg);
+                std::uint64_t bits{};
+                std::memcpy(&bits, &dbl, sizeof(bits));
+                put(tag::float64, bits, 8);
+            }
+        }
+
+        template<typename T>
+        void push_string(const T& arg)
+        {
+            if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                const std::string_view str{ arg };
+                put_header(str.size(), tag::fixstr, 0x1FU, tag::str8, tag::str16);
+
+                auto& out = buffer();
+                const auto* const p_first = reinterpret_cast<const std::uint8_t*>(str.data());
+                out.insert(out.end(), p_first, p_first + str.size());
+            }
+            else
+            {
+                // Non-char strings are written as arrays of code units
+                push_array(arg);
+            }
+        }
+
+        template<typename T>
+        void push_array(const T& arg)
+        {
+            if constexpr (is_byte_container_v<T>)
+            {
+                const auto bytes = containers::adapter<T>::bulk_view(arg);
+                put_header(bytes.size(), 0, 0, tag::bin8, tag::bin16);
+
+                auto& out = buffer();
+                const auto* const p_first = reinterpret_cast<const std::uint8_t*>(bytes.data());
+                out.insert(out.end(), p_first, p_first + bytes.size());
+            }
+            else
+            {
+                put_header(static_cast<std::size_t>(std::distance(std::begin(arg), std::end(arg))),
+                    tag::fixarray, 0x0FU, 0, tag::array16);
+
+                for (const auto& subval : arg)
+                {
+                    push_arg(subval);
+                }
+            }
+        }
+
+        template<typename T>
+        void push_map(const T& arg)
+        {
+            put_header(static_cast<std::size_t>(std::distance(std::begin(arg), std::end(arg))),
+                tag::fixmap, 0x0FU, 0, tag::map16);
+
+            for (const auto& [k, v] : arg)
+            {
+                push_arg(k);
+                push_arg(v);
+            }
+        }
+
+        // Each key is written once followed by the array of its values, as in json_adapter
+        template<typename T>
+        void push_multimap(const T& arg)
+        {
+            std::size_t key_count = 0;
+
+            for (auto it = arg.begin(); it != arg.end(); it = arg.equal_range(it->first).second)
+            {
+                ++key_count;
+            }
+
+            put_header(key_count, tag::fixmap, 0x0FU, 0, tag::map16);
+
+            for (auto it = arg.begin(); it != arg.end();)
+            {
+                const auto range = arg.equal_range(it->first);
+
+                push_arg(it->first);
+                put_header(static_cast<std::size_t>(std::distance(range.first, range.second)),
+                    tag::fixarray, 0x0FU, 0, tag::array16);
+
+                for (; it != range.second; ++it)
+                {
+                    push_arg(it->second);
+                }
+            }
+        }
+
+        template<typename T1, typename T2>
+        void push_pair(const std::pair<T1, T2>& arg)
+        {
+            buffer().push_back(static_cast<std::uint8_t>(tag::fixarray | 2U));
+            push_arg(arg.first);
+            push_arg(arg.second);
+        }
+
+        template<typename... Args>
+        void push_tuple(const std::tuple<Args...>& arg)
+        {
+            put_header(sizeof...(Args), tag::fixarray, 0x0FU, 0, tag::array16);
+            detail::for_each_tuple(
+                arg, [this](auto&& elem) { push_arg(std::forward<decltype(elem)>(elem)); });
+        }
+
+        template<typename T>
+        void push_optional(const std::optional<T>& arg)
+        {
+            if (arg.has_value())
+            {
+                push_arg(*arg);
+            }
+            else
+            {
+                buffer().push_back(tag::nil);
+            }
+        }
+
+        // Variants are written as [index, value]
+        template<typename... Args>
+        void push_variant(const std::variant<Args...>& arg)
+        {
+            buffer().push_back(static_cast<std::uint8_t>(tag::fixarray | 2U));
+
+            if constexpr (detail::is_tagged_variant_v<std::variant<Args...>>)
+            {
+                push_uint(detail::variant_tag_index<std::variant<Args...>>::tags[arg.index()].id);
+            }
+            else
+            {
+                push_uint(arg.index());
+            }
+
+            std::visit([this](auto&& l_val) { push_arg(std::forward<decltype(l_val)>(l_val)); },
+                arg);
+        }
+
+        template<typename T>
+        void push_object(const T& arg)
+        {
+            const auto prev_frame = std::exchange(m_frame, frame{});
+            m_frame.wide = starts_wide<T>();
+            ++m_depth;
+
+            detail::serializer_base<serial_adapter, false>::serialize_object(arg);
+            end_object();
+
+            --m_depth;
+            m_frame = prev_frame;
+        }
+
+        template<typename T>
+        void push_arg(const T& arg)
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+            if constexpr (is_null_serializable<no_ref_t>)
+            {
+                buffer().push_back(tag::nil);
+            }
+            else if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                push_bool(arg);
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                static_assert(
+                    !std::is_same_v<no_ref_t, long double>, "long double is not supported");
+                push_float(arg);
+            }
+            else if constexpr (std::is_arithmetic_v<no_ref_t>)
+            {
+                push_integer(arg);
+            }
+            else if constexpr (is_enum_serializable<no_ref_t>)
+            {
+                push_integer(static_cast<std::underlying_type_t<no_ref_t>>(arg));
+            }
+            else if constexpr (is_string_serializable<no_ref_t>)
+            {
+                push_string(arg);
+            }
+            else if constexpr (is_multimap_serializable<no_ref_t>)
+            {
+                push_multimap(arg);
+            }
+            else if constexpr (is_map_serializable<no_ref_t>)
+            {
+                push_map(arg);
+            }
+            else if constexpr (is_array_serializable<no_ref_t>)
+            {
+                push_array(arg);
+            }
+            else if constexpr (is_optional_serializable<no_ref_t>)
+            {
+                push_optional(arg);
+            }
+            else if constexpr (is_tuple_serializable<no_ref_t>)
+            {
+                if constexpr (detail::is_pair_v<no_ref_t>)
+                {
+                    push_pair(arg);
+                }
+                else
+                {
+                    push_tuple(arg);
+                }
+            }
+            else if constexpr (is_variant_serializable<no_ref_t>)
+            {
+                push_variant(arg);
+            }
+            else
+            {
+                push_object(arg);
+            }
+        }
+
+        std::vector<std::uint8_t> m_bytes{};
+        std::vector<std::uint8_t>* m_p_out{ nullptr };
+        frame m_frame{};
+        std::size_t m_depth{};
+    };
+
+    // Reads values straight out of the MessagePack bytes as the as_xxx() calls arrive. Like
+    // json_text_adapter, map members are matched in order, members read out of order are
+    // remembered so they are only scanned once, and unvisited values are skipped without being
+    // decoded. std::string_view and byte views are deserialized as views into the input
+    class deserializer : public detail::serializer_base<serial_adapter, true>
+    {
+    public:
+        // Reads bytes in place, so they must outlive the deserializer
+        explicit deserializer(const std::vector<std::uint8_t>& bytes) noexcept
+            : m_p_bytes(&bytes), m_p_data(bytes.data()), m_size(bytes.size())
+        {
+        }
+
+        explicit deserializer(std::vector<std::uint8_t>&& bytes) = delete;
+
+        explicit deserializer(const view<std::uint8_t> bytes) noexcept
+            : m_p_data(bytes.data()), m_size(bytes.size())
+        {
+        }
+
+        deserializer(const std::uint8_t* const p_data, const std::size_t size) noexcept
+            : m_p_data(p_data), m_size(size)
+        {
+        }
+
+        // Bound to the caller's bytes (and, when given a vector, re-reads it on every
+        // deserialize_object()), so it can be moved but not copied
+        deserializer(const deserializer&) = delete;
+        deserializer(deserializer&&) noexcept = default;
+        auto operator=(const deserializer&) -> deserializer& = delete;
+        auto operator=(deserializer&&) noexcept -> deserializer& = default;
+        ~deserializer() noexcept = default;
+
+        template<typename T>
+        void deserialize_object(T&& val)
+        {
+            if (m_p_bytes != nullptr)
+            {
+                m_p_data = m_p_bytes->data();
+                m_size = m_p_bytes->size();
+            }
+
+            m_skipped.clear();
+            m_last_pos = npos;
+            m_frame = frame{ 0 };
+
+            detail::serializer_base<serial_adapter, true>::deserialize_object(std::forward<T>(val));
+
+            if (!failed() && frame_end() != m_size)
+            {
+                fail(deserialization_errc::malformed,
+                    "MessagePack error: unexpected trailing bytes");
+            }
+        }
+
+        // Used by deserialize_from(), which reads a top-level array a window of the input at a
+        // time, deserializing each element from its own bytes. Returns the position of the first
+        // element and the number of elements. The count is not checked against the input's size,
+        // as the rest of the array has not been read yet
+        [[nodiscard]] auto scan_array_head() const -> std::pair<std::size_t, std::size_t>
+        {
+            const auto first = static_cast<std::uint8_t>(read_be(0, 1));
+
+            if ((first & 0xF0U) == tag::fixarray)
+            {
+                return { 1, first & 0x0FU };
+            }
+
+            if (first == tag::array16 || first == tag::array32)
+            {
+                const auto header = first == tag::array16 ? item{ kind::array, 3, read_be(1, 2) }
+                                                          : item{ kind::array, 5, read_be(1, 4) };
+
+                return { header.body, static_cast<std::size_t>(header.arg) };
+            }
+
+            fail(deserialization_errc::type_mismatch,
+                std::string{ "MessagePack error: expected array, got " }.append(
+                    type_name(read_item(0).type)));
+
+            return { m_size, 0 };
+        }
+
+        // Where the element at pos (the index-th) starts and ends
+        [[nodiscard]] auto scan_array_item(
+            const std::size_t pos, [[maybe_unused]] const std::size_t index) const
+            -> std::pair<std::size_t, std::size_t>
+        {
+            return { pos, skip_value(pos) };
+        }
+
+        // Nothing may follow the array
+        [[nodiscard]] static constexpr auto scan_trailing(const std::size_t pos) noexcept
+            -> std::size_t
+        {
+            return pos;
+        }
+
+        void as_bool(const std::string_view key, bool& val) { parse_field(key, val); }
+
+        template<typename T>
+        void as_float(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_int(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_uint(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_enum(const std::string_view key, T& val)
+        {
+            static_assert(std::is_enum_v<T>, "T must be an enum type");
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_string(const std::string_view key, T& val)
+        {
+            if constexpr (std::is_array_v<T>)
+            {
+                span arr{ val };
+                as_string(key, arr);
+            }
+            else
+            {
+                const auto pos = find_field(key);
+
+                if (!failed())
+                {
+                    finish_field(pos, parse_string_like(pos, val));
+                }
+            }
+        }
+
+        template<typename T>
+        void as_array(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_map(const std::string_view key, T& val)
+        {
+            EXTENSER_PRECONDITION(std::size(val) == 0);
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_multimap(const std::string_view key, T& val)
+        {
+            EXTENSER_PRECONDITION(std::size(val) == 0);
+            parse_field(key, val);
+        }
+
+        template<typename T1, typename T2>
+        void as_tuple(const std::string_view key, std::pair<T1, T2>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename... Args>
+        void as_tuple(const std::string_view key, std::tuple<Args...>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_optional(const std::string_view key, std::optional<T>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename... Args>
+        void as_variant(const std::string_view key, std::variant<Args...>& val)
+        {
+            parse_field(key, val);
+        }
+
+        template<typename T>
+        void as_object(const std::string_view key, T& val)
+        {
+            parse_field(key, val);
+        }
+
+        void as_null(const std::string_view key)
+        {
+            std::nullptr_t val{};
+            parse_field(key, val);
+        }
+
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        enum class kind : std::uint8_t
+        {
+            nil,
+            boolean,
+            uint,
+            sint,
+            float32,
+            float64,
+            str,
+            bin,
+            array,
+            map,
+            ext,
+        };
+
+        // A decoded header: body is the position just past it. arg holds the value of a boolean
+        // or number (negative for sint only), the byte length of a str, bin or ext, or the element
+        // count of an array or map
+        struct item
+        {
+            kind type{};
+            std::size_t body{};
+            std::uint64_t arg{};
+        };
+
+        // The value currently being deserialized and, once a key has been looked up, the read
+        // position within its map
+        struct frame
+        {
+            std::size_t value_pos{ npos };
+            std::size_t cursor{ npos };
+            std::uint64_t member_count{};
+            std::uint64_t members_read{};
+            std::size_t skipped_begin{};
+        };
+
+        struct member
+        {
+            std::string_view key{};
+            std::size_t value_pos{};
+        };
+
+        // Position of the next element of an array, shared by its element_iterators
+        struct array_cursor
+        {
+            std::size_t first{};
+            std::size_t index{};
+            std::size_t pos{};
+        };
+
+        // Iterates the element positions of an array. Positions are only found when dereferenced,
+        // so the container adapters can take std::distance() of a range for the cost of a count
+        class element_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::size_t*;
+            using reference = const std::size_t&;
+
+            element_iterator() noexcept = default;
+
+            element_iterator(
+                deserializer& des, array_cursor& cursor, const std::size_t index) noexcept
+                : m_p_des(&des), m_p_cursor(&cursor), m_index(index)
+            {
+            }
+
+            auto operator*() const -> reference
+            {
+                m_pos = m_p_des->element_pos(*m_p_cursor, m_index);
+                return m_pos;
+            }
+
+            auto operator++() noexcept -> element_iterator&
+            {
+                ++m_index;
+                return *this;
+            }
+
+            auto operator++(int) noexcept -> element_iterator
+            {
+                auto tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            friend auto operator==(
+                const element_iterator& lhs, const element_iterator& rhs) noexcept -> bool
+            {
+                return lhs.m_index == rhs.m_index;
+            }
+
+            friend auto operator!=(
+                const element_iterator& lhs, const element_iterator& rhs) noexcept -> bool
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            deserializer* m_p_des{ nullptr };
+            array_cursor* m_p_cursor{ nullptr };
+            std::size_t m_index{};
+            mutable std::size_t m_pos{ npos };
+        };
+
+        // Errors are reported through fail(), which throws unless called under
+        // try_deserialize_object(). There, the parse runs to the end of the input instead: each
+        // read returns m_size once an error is recorded, where every further read stops
+        [[nodiscard]] auto fail_at(const deserialization_errc code, std::string message) const
+            -> std::size_t
+        {
+            fail(code, std::move(message));
+            return m_size;
+        }
+
+        [[nodiscard]] auto fail_end_of_input() const -> std::size_t
+        {
+            return fail_at(
+                deserialization_errc::end_of_input, "MessagePack error: unexpected end of input");
+        }
+
+        // Reads byte_count bytes at pos as a big-endian unsigned integer
+        [[nodiscard]] auto read_be(const std::size_t pos, const std::size_t byte_count) const
+            -> std::uint64_t
+        {
+            if (pos > m_size || byte_count > m_size - pos)
+            {
+                std::ignore = fail_end_of_input();
+                return 0;
+            }
+
+            std::uint64_t num{};
+
+            for (std::size_t i = 0; i < byte_count; ++i)
+            {
+                num = (num << 8U) | m_p_data[pos + i];
+            }
+
+            return num;
+        }
+
+        [[nodiscard]] auto sized_item(
+            const kind type, const std::size_t body, const std::uint64_t length) const -> item
+        {
+            if (body > m_size || length > m_size - body)
+            {
+                return { kind::nil, fail_end_of_input(), 0 };
+            }
+
+            return { type, body, length };
+        }
+
+        // Every element takes at least one byte, so larger counts are rejected before anything
+        // is reserved for them
+        [[nodiscard]] auto container_item(
+            const kind type, const std::size_t body, const std::uint64_t count) const -> item
+        {
+            const auto min_bytes = type == kind::map ? count * 2 : count;
+
+            if (body > m_size || min_bytes > m_size - body)
+            {
+                return { kind::nil, fail_end_of_input(), 0 };
+            }
+
+            return { type, body, count };
+        }
+
+        [[nodiscard]] static auto signed_item(const std::size_t body, const std::int64_t num)
+            -> item
+        {
+            return { num < 0 ? kind::sint : kind::uint, body, static_cast<std::uint64_t>(num) };
+        }
+
+        // After an error, reads as nil at the end of the input
+        [[nodiscard]] auto read_item(const std::size_t pos) const -> item
+        {
+            const auto header = decode_item(pos);
+            return failed() ? item{ kind::nil, m_size, 0 } : header;
+        }
+
+        [[nodiscard]] auto decode_item(const std::size_t pos) const -> item
+        {
+            const auto first = static_cast<std::uint8_t>(read_be(pos, 1));
+            const auto body = pos + 1;
+
+            if (first <= tag::positive_fixint_max)
+            {
+                return { kind::uint, body, first };
+            }
+
+            if (first >= tag::negative_fixint)
+            {
+                return signed_item(body, static_cast<std::int8_t>(first));
+            }
+
+            if (first < tag::fixarray)
+            {
+                return container_item(kind::map, body, first & 0x0FU);
+            }
+
+            if (first < tag::fixstr)
+            {
+                return container_item(kind::array, body, first & 0x0FU);
+            }
+
+            if (first < tag::nil)
+            {
+                return sized_item(kind::str, body, first & 0x1FU);
+            }
+
+            switch (first)
+            {
+                case tag::nil:
+                    return { kind::nil, body, 0 };
+
+                case tag::false_value:
+                    return { kind::boolean, body, 0 };
+
+                case tag::true_value:
+                    return { kind::boolean, body, 1 };
+
+                case tag::bin8:
+                    return sized_item(kind::bin, body + 1, read_be(body, 1));
+
+                case tag::bin16:
+                    return sized_item(kind::bin, body + 2, read_be(body, 2));
+
+                case tag::bin32:
+                    return sized_item(kind::bin, body + 4, read_be(body, 4));
+
+                // The ext type byte follows the length
+                case tag::ext8:
+                    return sized_item(kind::ext, body + 2, read_be(body, 1));
+
+                case tag::ext16:
+                    return sized_item(kind::ext, body + 3, read_be(body, 2));
+
+                case tag::ext32:
+                    return sized_item(kind::ext, body + 5, read_be(body, 4));
+
+                case tag::float32:
+                    return { kind::float32, body + 4, read_be(body, 4) };
+
+                case tag::float64:
+                    return { kind::float64, body + 8, read_be(body, 8) };
+
+                case tag::uint8:
+                    return { kind::uint, body + 1, read_be(body, 1) };
+
+                case tag::uint16:
+                    return { kind::uint, body + 2, read_be(body, 2) };
+
+                case tag::uint32:
+                    return { kind::uint, body + 4, read_be(body, 4) };
+
+                case tag::uint64:
+                    return { kind::uint, body + 8, read_be(body, 8) };
+
+                case tag::int8:
+                    return signed_item(body + 1, static_cast<std::int8_t>(read_be(body, 1)));
+
+                case tag::int16:
+                    return signed_item(body + 2, static_cast<std::int16_t>(read_be(body, 2)));
+
+                case tag::int32:
+                    return signed_item(body + 4, static_cast<std::int32_t>(read_be(body, 4)));
+
+                case tag::int64:
+                    return signed_item(body + 8, static_cast<std::int64_t>(read_be(body, 8)));
+
+                case tag::fixext1:
+                    return sized_item(kind::ext, body + 1, 1);
+
+                case tag::fixext2:
+                    return sized_item(kind::ext, body + 1, 2);
+
+                case tag::fixext4:
+                    return sized_item(kind::ext, body + 1, 4);
+
+                case tag::fixext8:
+                    return sized_item(kind::ext, body + 1, 8);
+
+                case tag::fixext16:
+                    return sized_item(kind::ext, body + 1, 16);
+
+                case tag::str8:
+                    return sized_item(kind::str, body + 1, read_be(body, 1));
+
+                case tag::str16:
+                    return sized_item(kind::str, body + 2, read_be(body, 2));
+
+                case tag::str32:
+                    return sized_item(kind::str, body + 4, read_be(body, 4));
+
+                case tag::array16:
+                    return container_item(kind::array, body + 2, read_be(body, 2));
+
+                case tag::array32:
+                    return container_item(kind::array, body + 4, read_be(body, 4));
+
+                case tag::map16:
+                    return container_item(kind::map, body + 2, read_be(body, 2));
+
+                case tag::map32:
+                    return container_item(kind::map, body + 4, read_be(body, 4));
+
+                default:
+                    return { kind::nil,
+                        fail_at(deserialization_errc::malformed,
+                            std::string{ "MessagePack error: invalid format byte at position " }
+                                .append(std::to_string(pos))),
+                        0 };
+            }
+        }
+
+        [[nodiscard]] static auto type_name(const kind type) noexcept -> const char*
+        {
+            switch (type)
+            {
+                case kind::nil:
+                    return "nil";
+
+                case kind::boolean:
+                    return "boolean";
+
+                case kind::uint:
+                case kind::sint:
+                    return "integer";
+
+                case kind::float32:
+                case kind::float64:
+                    return "float";
+
+                case kind::str:
+                    return "string";
+
+                case kind::bin:
+                    return "binary";
+
+                case kind::array:
+                    return "array";
+
+                case kind::map:
+                    return "map";
+
+                case kind::ext:
+                default:
+                    return "extension";
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto fail_type(const kind type) const -> std::size_t
+        {
+            return fail_at(deserialization_errc::type_mismatch,
+                std::string{ "MessagePack error: expected " }
+                    .append(detail::expected_type_name<detail::remove_cvref_t<T>>())
+                    .append(", got ")
+                    .append(type_name(type)));
+        }
+
+        [[nodiscard]] auto skip_value(std::size_t pos) const -> std::size_t
+        {
+            std::uint64_t pending = 1;
+
+            while (pending != 0)
+            {
+                const auto header = read_item(pos);
+
+                if (failed())
+                {
+                    return m_size;
+                }
+
+                --pending;
+                pos = header.body;
+
+                switch (header.type)
+                {
+                    case kind::str:
+                    case kind::bin:
+                    case kind::ext:
+                        pos += static_cast<std::size_t>(header.arg);
+                        break;
+
+                    case kind::array:
+                        pending += header.arg;
+                        break;
+
+                    case kind::map:
+                        pending += header.arg * 2;
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            return pos;
+        }
+
+        // End of the value at pos, reusing the result of the last parse when it was that value
+        [[nodiscard]] auto value_end(const std::size_t pos) const -> std::size_t
+        {
+            return pos == m_last_pos ? m_last_end : skip_value(pos);
+        }
+
+        [[nodiscard]] auto element_pos(array_cursor& cursor, const std::size_t index) const
+            -> std::size_t
+        {
+            if (index < cursor.index)
+            {
+                cursor.index = 0;
+                cursor.pos = cursor.first;
+            }
+
+            for (; cursor.index < index; ++cursor.index)
+            {
+                cursor.pos = value_end(cursor.pos);
+            }
+
+            return cursor.pos;
+        }
+
+        // Reads the next member of the current map. Keys that are not strings never match a field
+        void read_member(member& out)
+        {
+            const auto header = read_item(m_frame.cursor);
+
+            if (header.type == kind::str)
+            {
+                out.key = { reinterpret_cast<const char*>(m_p_data + header.body),
+                    static_cast<std::size_t>(header.arg) };
+
+                out.value_pos = header.body + static_cast<std::size_t>(header.arg);
+            }
+            else
+            {
+                out.key = {};
+                out.value_pos = skip_value(m_frame.cursor);
+            }
+
+            ++m_frame.members_read;
+            m_frame.cursor = out.value_pos;
+        }
+
+        [[nodiscard]] auto find_field(const std::string_view key) -> std::size_t
+        {
+            if (key.empty())
+            {
+                return m_frame.value_pos;
+            }
+
+            if (m_frame.cursor == npos)
+            {
+                const auto header = read_item(m_frame.value_pos);
+
+                if (header.type != kind::map)
+                {
+                    return fail_at(deserialization_errc::type_mismatch,
+                        std::string{ "MessagePack error: cannot look up key '" }
+                            .append(key)
+                            .append("' in a value of type: ")
+                            .append(type_name(header.type)));
+                }
+
+                m_frame.cursor = header.body;
+                m_frame.member_count = header.arg;
+            }
+
+            for (auto i = m_frame.skipped_begin; i < m_skipped.size(); ++i)
+            {
+                if (m_skipped[i].key == key)
+                {
+                    return m_skipped[i].value_pos;
+                }
+            }
+
+            member mem{};
+
+            while (m_frame.members_read < m_frame.member_count && !failed())
+            {
+                read_member(mem);
+
+                if (mem.key == key)
+                {
+                    return mem.value_pos;
+                }
+
+                m_frame.cursor = skip_value(mem.value_pos);
+                m_skipped.push_back(mem);
+            }
+
+            return fail_at(deserialization_errc::missing_key,
+                std::string{ "MessagePack error: key '" }.append(key).append("' not found"));
+        }
+
+        void finish_field(const std::size_t pos, const std::size_t end) noexcept
+        {
+            // Members read in order move the cursor past their value
+            if (pos == m_frame.cursor)
+            {
+                m_frame.cursor = end;
+            }
+        }
+
+        template<typename T>
+        void parse_field(const std::string_view key, T& val)
+        {
+            const auto pos = find_field(key);
+
+            if (!failed())
+            {
+                finish_field(pos, parse_value(pos, val));
+            }
+        }
+
+        // Skips any members that were not read and returns the end of the current value
+        [[nodiscard]] auto frame_end() -> std::size_t
+        {
+            if (m_frame.cursor == npos)
+            {
+                return value_end(m_frame.value_pos);
+            }
+
+            member mem{};
+
+            while (m_frame.members_read < m_frame.member_count && !failed())
+            {
+                read_member(mem);
+                m_frame.cursor = skip_value(mem.value_pos);
+            }
+
+            return failed() ? m_size : m_frame.cursor;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_nested(const std::size_t pos, T& val) -> std::size_t
+        {
+            const auto prev_frame = std::exchange(m_frame, frame{ pos });
+            m_frame.skipped_begin = m_skipped.size();
+
+            detail::serializer_base<serial_adapter, true>::deserialize_object(val);
+
+            const auto end = failed() ? m_size : frame_end();
+
+            m_skipped.resize(m_frame.skipped_begin);
+            m_frame = prev_frame;
+            return end;
+        }
+
+        template<typename T>
+        auto parse_value(const std::size_t pos, T& val) -> std::size_t
+        {
+            const auto end = parse_value_impl(pos, val);
+            m_last_pos = pos;
+            m_last_end = end;
+            return end;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_value_impl(const std::size_t pos, T& val) -> std::size_t
+        {
+            using no_ref_t = detail::remove_cvref_t<T>;
+
+            if constexpr (is_null_serializable<no_ref_t>)
+            {
+                const auto header = read_item(pos);
+
+                if (header.type != kind::nil)
+                {
+                    return fail_type<no_ref_t>(header.type);
+                }
+
+                return header.body;
+            }
+            else if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                const auto header = read_item(pos);
+
+                if (header.type != kind::boolean)
+                {
+                    return fail_type<bool>(header.type);
+                }
+
+                val = header.arg != 0;
+                return header.body;
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                return parse_float(pos, val);
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                return parse_integer(pos, val);
+            }
+            else if constexpr (is_enum_serializable<no_ref_t>)
+            {
+                std::underlying_type_t<no_ref_t> num{};
+                const auto end = parse_integer(pos, num);
+
+                if (!failed())
+                {
+                    val = static_cast<no_ref_t>(num);
+                }
+
+                return end;
+            }
+            else if constexpr (is_string_serializable<no_ref_t>)
+            {
+                return parse_string_like(pos, val);
+            }
+            else if constexpr (is_multimap_serializable<no_ref_t>)
+            {
+                return parse_multimap(pos, val);
+            }
+            else if constexpr (is_map_serializable<no_ref_t>)
+            {
+                return parse_map(pos, val);
+            }
+            else if constexpr (is_array_serializable<no_ref_t>)
+            {
+                return parse_array(pos, val);
+            }
+            else if constexpr (is_optional_serializable<no_ref_t>)
+            {
+                if (const auto header = read_item(pos); header.type == kind::nil)
+                {
+                    val.reset();
+                    return header.body;
+                }
+
+                return parse_value(pos, val.emplace());
+            }
+            else if constexpr (detail::is_pair_v<no_ref_t>)
+            {
+                auto elem_pos = read_tuple_header<no_ref_t>(pos, 2);
+                elem_pos = parse_value(elem_pos, val.first);
+                return parse_value(elem_pos, val.second);
+            }
+            else if constexpr (is_tuple_serializable<no_ref_t>)
+            {
+                auto elem_pos = read_tuple_header<no_ref_t>(pos, std::tuple_size_v<no_ref_t>);
+
+                std::apply([this, &elem_pos](auto&... elems)
+                    { ((elem_pos = parse_value(elem_pos, elems)), ...); },
+                    val);
+
+                return elem_pos;
+            }
+            else if constexpr (is_variant_serializable<no_ref_t>)
+            {
+                return parse_variant(pos, val);
+            }
+            else
+            {
+                return parse_nested(pos, val);
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_integer(const std::size_t pos, T& val) const -> std::size_t
+        {
+            const auto header = read_item(pos);
+
+            if (header.type == kind::uint)
+            {
+                if (header.arg > static_cast<std::uint64_t>(std::numeric_limits<T>::max()))
+                {
+                    return fail_at(deserialization_errc::out_of_range,
+                        "MessagePack error: integer out of range");
+                }
+
+                val = convert<T>(header.arg);
+            }
+            else if (header.type == kind::sint)
+            {
+                const auto num = static_cast<std::int64_t>(header.arg);
+
+                if constexpr (std::is_unsigned_v<T>)
+                {
+                    return fail_at(deserialization_errc::out_of_range,
+                        "MessagePack error: integer out of range");
+                }
+                else
+                {
+                    if (num < static_cast<std::int64_t>(std::numeric_limits<T>::min()))
+                    {
+                        return fail_at(deserialization_errc::out_of_range,
+                            "MessagePack error: integer out of range");
+                    }
+
+                    val = convert<T>(num);
+                }
+            }
+            else
+            {
+                return fail_type<T>(header.type);
+            }
+
+            return header.body;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_float(const std::size_t pos, T& val) const -> std::size_t
+        {
+            static_assert(!std::is_same_v<T, long double>, "long double is not supported");
+
+            const auto header = read_item(pos);
+
+            switch (header.type)
+            {
+                case kind::float32:
+                {
+                    const auto bits = static_cast<std::uint32_t>(header.arg);
+                    float num{};
+                    std::memcpy(&num, &bits, sizeof(num));
+                    val = convert<T>(num);
+                    break;
+                }
+
+                case kind::float64:
+                {
+                    double num{};
+                    std::memcpy(&num, &header.arg, sizeof(num));
+                    val = convert<T>(num);
+                    break;
+                }
+
+                case kind::uint:
+                    val = static_cast<T>(header.arg);
+                    break;
+
+                case kind::sint:
+                    val = static_cast<T>(static_cast<std::int64_t>(header.arg));
+                    break;
+
+                default:
+                    return fail_type<T>(header.type);
+            }
+
+            return header.body;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_string_like(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+
+            if constexpr (!std::is_same_v<typename traits_t::value_type, char>)
+            {
+                // Non-char strings are arrays of code units
+                return parse_array(pos, val);
+            }
+            else
+            {
+                const auto header = read_item(pos);
+
+                if (header.type != kind::str)
+                {
+                    return fail_type<T>(header.type);
+                }
+
+                const auto* const p_chars = reinterpret_cast<const char*>(m_p_data + header.body);
+                const auto length = static_cast<std::size_t>(header.arg);
+
+                if constexpr (std::is_same_v<T, std::string>)
+                {
+                    val.assign(p_chars, length);
+                }
+                else if constexpr (is_borrowed_v<T>)
+                {
+                    val = T{ p_chars, length };
+                }
+                else if constexpr (traits_t::is_mutable)
+                {
+                    if constexpr (traits_t::has_fixed_size)
+                    {
+                        if (length > adapter_t::size(val))
+                        {
+                            return fail_at(deserialization_errc::out_of_range,
+                                "MessagePack error: array out of bounds");
+                        }
+                    }
+
+                    adapter_t::assign_from_range(
+                        val, p_chars, p_chars + length, [](const char c) { return c; });
+                }
+
+                return header.body + length;
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_bin(const item& header, T& val) const -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+
+            const auto length = static_cast<std::size_t>(header.arg);
+
+            if constexpr (is_borrowed_v<T>)
+            {
+                const T borrowed{ reinterpret_cast<const typename traits_t::value_type*>(
+                                      m_p_data + header.body),
+                    length };
+
+                val = borrowed;
+            }
+            else if constexpr (traits_t::is_mutable)
+            {
+                if constexpr (traits_t::has_fixed_size)
+                {
+                    if (length != adapter_t::size(val))
+                    {
+                        return fail_at(deserialization_errc::out_of_range,
+                            "MessagePack error: array out of bounds");
+                    }
+                }
+
+                adapter_t::bulk_assign(val, m_p_data + header.body, length);
+            }
+
+            return header.body + length;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_array(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using value_t = detail::remove_cvref_t<typename traits_t::value_type>;
+
+            const auto header = read_item(pos);
+
+            if constexpr (is_byte_container_v<T>)
+            {
+                if (header.type == kind::bin)
+                {
+                    return parse_bin(header, val);
+                }
+            }
+
+            if (header.type != kind::array)
+            {
+                return fail_type<T>(header.type);
+            }
+
+            if constexpr (traits_t::is_mutable)
+            {
+                const auto count = static_cast<std::size_t>(header.arg);
+
+                if constexpr (traits_t::has_fixed_size)
+                {
+                    if (count != adapter_t::size(val))
+                    {
+                        return fail_at(deserialization_errc::out_of_range,
+                            "MessagePack error: array out of bounds");
+                    }
+                }
+
+                array_cursor cursor{ header.body, 0, header.body };
+                const element_iterator first{ *this, cursor, 0 };
+                const element_iterator last{ *this, cursor, count };
+                std::size_t index = 0;
+
+                // After an error, the remaining elements are left unread
+                const auto parse_elem = [this, &index](const std::size_t elem_pos)
+                {
+                    auto elem = detail::make_value<value_t>();
+
+                    if (!failed())
+                    {
+                        const path_guard trace{ *this, index++ };
+                        parse_value(elem_pos, elem);
+                    }
+
+                    return elem;
+                };
+
+                if constexpr (traits_t::is_sequential)
+                {
+                    adapter_t::assign_from_range(val, first, last, parse_elem);
+                }
+                else
+                {
+                    for (auto it = first; it != last; ++it)
+                    {
+                        adapter_t::insert_value(val, *it, parse_elem);
+                    }
+                }
+
+                return failed() ? m_size : element_pos(cursor, count);
+            }
+            else
+            {
+                std::ignore = val;
+                return skip_value(pos);
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_map(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using key_t = typename traits_t::key_type;
+            using mapped_t = typename traits_t::mapped_type;
+
+            const auto header = read_item(pos);
+
+            if (header.type != kind::map)
+            {
+                return fail_type<T>(header.type);
+            }
+
+            auto member_pos = header.body;
+
+            for (std::uint64_t i = 0; i < header.arg; ++i)
+            {
+                auto next_pos = npos;
+
+                adapter_t::insert_value(val, member_pos,
+                    [this, &next_pos](const std::size_t key_pos)
+                    {
+                        std::pair<key_t, mapped_t> kv_pair{ detail::make_value<key_t>(),
+                            detail::make_value<mapped_t>() };
+
+                        next_pos = parse_value(parse_value(key_pos, kv_pair.first), kv_pair.second);
+                        return kv_pair;
+                    });
+
+                if (failed())
+                {
+                    return m_size;
+                }
+
+                member_pos = next_pos != npos ? next_pos : skip_value(skip_value(member_pos));
+            }
+
+            return member_pos;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto parse_multimap(const std::size_t pos, T& val) -> std::size_t
+        {
+            using traits_t = containers::traits<T>;
+            using adapter_t = containers::adapter<T>;
+            using key_t = typename traits_t::key_type;
+            using mapped_t = typename traits_t::mapped_type;
+
+            const auto header = read_item(pos);
+
+            if (header.type != kind::map)
+            {
+                return fail_type<T>(header.type);
+            }
+
+            auto member_pos = header.body;
+
+            for (std::uint64_t i = 0; i < header.arg; ++i)
+            {
+                auto key = detail::make_value<key_t>();
+                const auto values_pos = parse_value(member_pos, key);
+                const auto values = read_item(values_pos);
+
+                if (values.type != kind::array)
+                {
+                    return fail_type<std::vector<mapped_t>>(values.type);
+                }
+
+                array_cursor cursor{ values.body, 0, values.body };
+                const element_iterator last{ *this, cursor, static_cast<std::size_t>(values.arg) };
+
+                for (element_iterator it{ *this, cursor, 0 }; it != last; ++it)
+                {
+                    adapter_t::insert_value(val, *it,
+                        [this, &key](const std::size_t mapped_pos)
+                        {
+                            std::pair<key_t, mapped_t> kv_pair{ key,
+                                detail::make_value<mapped_t>() };
+
+                            parse_value(mapped_pos, kv_pair.second);
+                            return kv_pair;
+                        });
+
+                    if (failed())
+                    {
+                        return m_size;
+                    }
+                }
+
+                member_pos = element_pos(cursor, static_cast<std::size_t>(values.arg));
+            }
+
+            return member_pos;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto read_tuple_header(const std::size_t pos, const std::size_t size) const
+            -> std::size_t
+        {
+            const auto header = read_item(pos);
+
+            if (header.type != kind::array)
+            {
+                return fail_type<T>(header.type);
+            }
+
+            if (header.arg != size)
+            {
+                return fail_at(deserialization_errc::out_of_range,
+                    "MessagePack error: invalid number of args");
+            }
+
+            return header.body;
+        }
+
+        template<typename... Args>
+        [[nodiscard]] auto parse_variant(const std::size_t pos, std::variant<Args...>& val)
+            -> std::size_t
+        {
+            if constexpr (detail::is_tagged_variant_v<std::variant<Args...>>)
+            {
+                using index_t = detail::variant_tag_index<std::variant<Args...>>;
+
+                std::uint32_t v_id{};
+                const auto v_pos =
+                    parse_integer(read_tuple_header<std::variant<Args...>>(pos, 2), v_id);
+                if (failed())
+                {
+                    return v_pos;
+                }
+
+                const auto v_idx = index_t::find(v_id);
+
+                if (v_idx == index_t::npos)
+                {
+                    return fail_at(deserialization_errc::invalid_value,
+                        std::string{ "MessagePack error: unknown variant tag: " }.append(
+                            std::to_string(v_id)));
+                }
+
+                return parse_variant_alt(v_pos, v_idx, val);
+            }
+
+            static constexpr std::size_t arg_sz = sizeof...(Args);
+
+            std::size_t v_idx{};
+            const auto v_pos =
+                parse_integer(read_tuple_header<std::variant<Args...>>(pos, 2), v_idx);
+
+            if (failed())
+            {
+                return v_pos;
+            }
+
+            if (v_idx >= arg_sz)
+            {
+                return fail_at(deserialization_errc::out_of_range,
+                    std::string{ "MessagePack error: variant index exceeded variant size: " }
+                        .append(std::to_string(arg_sz)));
+            }
+
+            return parse_variant_alt(v_pos, v_idx, val);
+        }
+
+        template<typename... Args>
+        [[nodiscard]] auto parse_variant_alt(const std::size_t pos, const std::size_t v_idx,
+            std::variant<Args...>& val) -> std::size_t
+        {
+            return detail::visit_index<std::variant<Args...>>(v_idx,
+                [this, pos, &val](auto idx_constant) -> std::size_t
+                {
+                    static constexpr std::size_t alt_idx = decltype(idx_constant)::value;
+                    return parse_value(pos, val.template emplace<alt_idx>());
+                });
+        }
+
+        const std::vector<std::uint8_t>* m_p_bytes{ nullptr };
+        const std::uint8_t* m_p_data{ nullptr };
+        std::size_t m_size{};
+        frame m_frame{};
+        std::vector<member> m_skipped{};
+        std::size_t m_last_pos{ npos };
+        std::size_t m_last_end{ npos };
+    };
+} //namespace detail_msgpack
+
+using msgpack_adapter = detail_msgpack::serial_adapter;
+} //namespace extenser
+#endif //EXTENSER_MSGPACK_HPP
@@ -0,0 +1,291 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_PARALLEL_HPP
+#define EXTENSER_PARALLEL_HPP
+
+#include "extenser.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace extenser
+{
+// Controls how a large array is split between threads
+struct parallel_options
+{
+    // Threads to use, including the calling thread. 0 uses std::thread::hardware_concurrency()
+    std::size_t thread_count{};
+
+    // The array is only split when every thread would get at least this many elements
+    std::size_t min_chunk_size{ 1024 };
+};
+
+namespace detail
+{
+    // Arrays of arithmetic values and enums are written as a block (or close to it) by the
+    // adapters, so only contiguous arrays of other values are worth splitting
+    template<typename T, typename = void>
+    struct is_splittable_array : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_splittable_array<T, std::enable_if_t<containers::traits<T>::is_sequential>> :
+        std::bool_constant<containers::traits<T>::is_contiguous
+            && !std::is_arithmetic_v<typename containers::traits<T>::value_type>
+            && !std::is_enum_v<typename containers::traits<T>::value_type>>
+    {
+    };
+
+    // Adapters take part by providing serialize_elements(first, last), which writes a run of
+    // array elements without the array around them, and splice_array(val, chunks), which writes
+    // val as an array whose elements are the concatenated chunks
+    template<typename Adapter, typename T, typename = void>
+    struct has_splice_array : std::false_type
+    {
+    };
+
+    template<typename Adapter, typename T>
+    struct has_splice_array<Adapter, T,
+        std::void_t<decltype(std::declval<typename Adapter::serializer_t&>().splice_array(
+            std::declval<const T&>(), std::declval<std::vector<typename Adapter::serial_t>&>()))>>
+        : std::true_type
+    {
+    };
+
+    // Resizable random-access containers (std::vector, std::deque) can be sized up front and
+    // then filled a slice per thread
+    template<typename T, typename = void>
+    struct is_presizable_array : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_presizable_array<T, std::enable_if_t<containers::traits<T>::is_sequential>> :
+        std::bool_constant<!containers::traits<T>::has_fixed_size
+            && containers::traits<T>::is_mutable
+            && std::is_base_of_v<std::random_access_iterator_tag,
+                typename std::iterator_traits<typename T::iterator>::iterator_category>
+            && std::is_default_constructible_v<typename containers::traits<T>::value_type>
+            && !std::is_arithmetic_v<typename containers::traits<T>::value_type>
+            && !std::is_enum_v<typename containers::traits<T>::value_type>>
+    {
+    };
+
+    // Adapters whose input can be indexed without parsing it take part by providing
+    // array_size(), the number of elements in the top-level array (0 if it is not one), and
+    // deserialize_elements(first, last, index), which reads elements from index onwards into
+    // [first, last)
+    template<typename Adapter, typename T, typename = void>
+    struct has_deserialize_elements : std::false_type
+    {
+    };
+
+    template<typename Adapter, typename T>
+    struct has_deserialize_elements<Adapter, T,
+        std::void_t<decltype(std::declval<typename Adapter::deserializer_t&>().array_size()),
+            decltype(std::declval<typename Adapter::deserializer_t&>().deserialize_elements(
+                std::declval<T&>().begin(), std::declval<T&>().end(), std::size_t{}))>>
+        : std::true_type
+    {
+    };
+
+    [[nodiscard]] inline auto chunk_count(
+        const std::size_t size, const parallel_options& options) noexcept -> std::size_t
+    {
+        const auto threads = options.thread_count != 0
+            ? options.thread_count
+            : static_cast<std::size_t>(std::thread::hardware_concurrency());
+
+        return std::min(threads, size / std::max(options.min_chunk_size, std::size_t{ 1 }));
+    }
+
+    // Start of chunk idx when size elements are split into count chunks, whose sizes differ by at
+    // most one
+    [[nodiscard]] constexpr auto chunk_begin(
+        const std::size_t size, const std::size_t count, const std::size_t idx) noexcept
+        -> std::size_t
+    {
+        return (size / count) * idx + std::min(idx, size % count);
+    }
+
+    // Runs task(idx) for every idx in [0, count), chunk 0 on the calling thread. A chunk whose
+    // thread cannot be started runs on the calling thread instead
+    template<typename F>
+    void run_chunks(const std::size_t count, const F& task)
+    {
+        std::vector<std::thread> workers{};
+        workers.reserve(count - 1);
+
+        for (std::size_t idx = 1; idx < count; ++idx)
+        {
+            try
+            {
+                workers.emplace_back(task, idx);
+            }
+            catch (const std::system_error&)
+            {
+                task(idx);
+            }
+        }
+
+        task(0);
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    // Rethrows the exception of the first chunk that failed, so the error reported does not
+    // depend on thread timing
+    inline void rethrow_first(const std::vector<std::exception_ptr>& errors)
+    {
+        for (const auto& p_error : errors)
+        {
+            if (p_error)
+            {
+                std::rethrow_exception(p_error);
+            }
+        }
+    }
+} //namespace detail
+
+// Serializes val, producing the same output as easy_serializer<Adapter>::quick_serialize(). When
+// val is a contiguous container of objects (or strings, ...) large enough to split per options,
+// its elements are serialized in chunks on separate threads and the adapter joins the chunks. If
+// any chunk throws, the exception from the earliest chunk is rethrown
+template<typename Adapter, typename T>
+[[nodiscard]] auto serialize_parallel(const T& val, const parallel_options& options) ->
+    typename Adapter::serial_t
+{
+    using serial_t = typename Adapter::serial_t;
+    using serializer_t = typename Adapter::serializer_t;
+
+    if constexpr (detail::is_splittable_array<T>::value)
+    {
+        static_assert(detail::has_splice_array<Adapter, T>::value,
+            "Adapter does not support parallel serialization (no splice_array())");
+
+        const auto size = containers::adapter<T>::size(val);
+        const auto count = detail::chunk_count(size, options);
+
+        if (count > 1)
+        {
+            std::vector<serial_t> chunks(count);
+            std::vector<std::exception_ptr> errors(count);
+
+            detail::run_chunks(count,
+                [&](const std::size_t idx) noexcept
+                {
+                    const auto first = std::begin(val);
+
+                    try
+                    {
+                        serializer_t ser{};
+                        ser.serialize_elements(
+                            first
+                                + static_cast<std::ptrdiff_t>(
+                                    detail::chunk_begin(size, count, idx)),
+                            first
+                                + static_cast<std::ptrdiff_t>(
+                                    detail::chunk_begin(size, count, idx + 1)));
+
+                        chunks[idx] = std::move(ser).object();
+                    }
+                    catch (...)
+                    {
+                        errors[idx] = std::current_exception();
+                    }
+                });
+
+            detail::rethrow_first(errors);
+
+            serializer_t ser{};
+            ser.splice_array(val, chunks);
+            return std::move(ser).object();
+        }
+    }
+
+    return easy_serializer<Adapter>::quick_serialize(val);
+}
+
+// Deserializes val from serial, as easy_serializer<Adapter>::quick_deserialize() does. When val is
+// a std::vector or std::deque of objects (or strings, ...) large enough to split per options, and
+// the adapter can index its input without parsing it (json_adapter), val is sized up front and
+// slices of it are filled on separate threads. Otherwise (including while a scoped_resource is
+// active) val is deserialized on the calling thread. If any slice throws, the exception from the
+// earliest slice is rethrown: the same error deserializing on one thread would have reported
+template<typename Adapter, typename T>
+void deserialize_parallel(
+    const typename Adapter::serial_t& serial, T& val, const parallel_options& options)
+{
+    using deserializer_t = typename Adapter::deserializer_t;
+
+    if constexpr (detail::is_presizable_array<T>::value
+        && detail::has_deserialize_elements<Adapter, T>::value)
+    {
+        const auto size = deserializer_t{ serial }.array_size();
+        auto count = detail::chunk_count(size, options);
+
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+        // Elements are move-assigned into the pre-sized container, which would copy them out of
+        // the scoped_resource into the container's allocator
+        if (detail::current_resource() != nullptr)
+        {
+            count = 0;
+        }
+#endif
+
+        if (count > 1)
+        {
+            containers::adapter<T>::presize(val, size);
+
+            std::vector<std::exception_ptr> errors(count);
+
+            detail::run_chunks(count,
+                [&](const std::size_t idx) noexcept
+                {
+                    const auto chunk_first = detail::chunk_begin(size, count, idx);
+                    const auto first = std::begin(val);
+
+                    try
+                    {
+                        deserializer_t des{ serial };
+                        des.deserialize_elements(
+                            first + static_cast<std::ptrdiff_t>(chunk_first),
+                            first
+                                + static_cast<std::ptrdiff_t>(
+                                    detail::chunk_begin(size, count, idx + 1)),
+                            chunk_first);
+                    }
+                    catch (...)
+                    {
+                        errors[idx] = std::current_exception();
+                    }
+                });
+
+            detail::rethrow_first(errors);
+            return;
+        }
+    }
+
+    deserializer_t des{ serial };
+    des.deserialize_object(val);
+}
+} //namespace extenser
+#endif //EXTENSER_PARALLEL_HPP
@@ -0,0 +1,172 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_STATS_HPP
+#define EXTENSER_STATS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace extenser
+{
+// Measurements for one top-level serialize_object() or deserialize_object() call, collected when
+// EXTENSER_STATS is defined. Nested objects are counted as part of the call that contains them
+struct call_stats
+{
+    // Heap allocations made during the call, only available once an allocation probe is set
+    std::size_t allocations{};
+    std::size_t bytes_allocated{};
+
+    // Values dispatched through the serializer (as_int(), as_object(), ...)
+    std::size_t nodes_visited{};
+
+    // Deepest nesting of objects, where the top-level object has a depth of 1
+    std::size_t max_depth{};
+
+    std::chrono::nanoseconds elapsed{};
+};
+
+namespace stats
+{
+#if defined(EXTENSER_STATS)
+    inline constexpr bool enabled = true;
+#else
+    inline constexpr bool enabled = false;
+#endif
+
+    // Running totals of this thread's heap allocations. ExtenSer cannot see allocations itself, so
+    // a program that counts them (typically by replacing operator new) provides a probe
+    struct alloc_totals
+    {
+        std::size_t count{};
+        std::size_t bytes{};
+    };
+
+    using alloc_probe_t = alloc_totals (*)() noexcept;
+
+    // Called on the calling thread after each top-level call, must not throw
+    using sink_t = void (*)(const call_stats& stats, void* p_context) noexcept;
+
+    namespace detail
+    {
+        struct thread_state
+        {
+            call_stats current{};
+            call_stats last{};
+            std::size_t depth{};
+            alloc_totals allocs_at_start{};
+            std::chrono::steady_clock::time_point start{};
+            sink_t sink{ nullptr };
+            void* p_sink_context{ nullptr };
+        };
+
+        inline auto state() noexcept -> thread_state&
+        {
+            static thread_local thread_state t_state{};
+            return t_state;
+        }
+
+        inline auto alloc_probe() noexcept -> alloc_probe_t&
+        {
+            static alloc_probe_t s_probe{ nullptr };
+            return s_probe;
+        }
+
+        inline void count_node() noexcept { ++state().current.nodes_visited; }
+
+        class call_guard
+        {
+        public:
+            call_guard() noexcept
+            {
+                auto& t_state = state();
+
+                if (t_state.depth == 0)
+                {
+                    t_state.current = call_stats{};
+
+                    if (const auto probe = alloc_probe(); probe != nullptr)
+                    {
+                        t_state.allocs_at_start = probe();
+                    }
+
+                    t_state.start = std::chrono::steady_clock::now();
+                }
+
+                ++t_state.depth;
+                t_state.current.max_depth = std::max(t_state.current.max_depth, t_state.depth);
+            }
+
+            ~call_guard() noexcept
+            {
+                auto& t_state = state();
+
+                if (--t_state.depth != 0)
+                {
+                    return;
+                }
+
+                t_state.current.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - t_state.start);
+
+                if (const auto probe = alloc_probe(); probe != nullptr)
+                {
+                    const auto allocs_at_end = probe();
+                    t_state.current.allocations =
+                        allocs_at_end.count - t_state.allocs_at_start.count;
+                    t_state.current.bytes_allocated =
+                        allocs_at_end.bytes - t_state.allocs_at_start.bytes;
+                }
+
+                t_state.last = t_state.current;
+
+                if (t_state.sink != nullptr)
+                {
+                    t_state.sink(t_state.last, t_state.p_sink_context);
+                }
+            }
+
+            call_guard(const call_guard&) = delete;
+            call_guard(call_guard&&) = delete;
+            auto operator=(const call_guard&) -> call_guard& = delete;
+            auto operator=(call_guard&&) -> call_guard& = delete;
+        };
+    } //namespace detail
+
+    // Sets the allocation probe for all threads, should be set before any serialization starts
+    inline void set_alloc_probe(const alloc_probe_t probe) noexcept
+    {
+        detail::alloc_probe() = probe;
+    }
+
+    // Sets the sink that receives this thread's call_stats, pass nullptr to remove it
+    inline void set_sink(const sink_t sink, void* const p_context = nullptr) noexcept
+    {
+        detail::state().sink = sink;
+        detail::state().p_sink_context = p_context;
+    }
+
+    // The stats of the last top-level call to finish on this thread
+    [[nodiscard]] inline auto last_call() noexcept -> const call_stats&
+    {
+        return detail::state().last;
+    }
+} //namespace stats
+} //namespace extenser
+
+#if defined(EXTENSER_STATS)
+#  define EXTENSER_STATS_CALL() const ::extenser::stats::detail::call_guard extenser_stats_guard_{}
+#  define EXTENSER_STATS_NODE() ::extenser::stats::detail::count_node()
+#else
+#  define EXTENSER_STATS_CALL() static_cast<void>(0)
+#  define EXTENSER_STATS_NODE() static_cast<void>(0)
+#endif
+
+#endif //EXTENSER_STATS_HPP
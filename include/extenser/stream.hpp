@@ -0,0 +1,566 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#ifndef EXTENSER_STREAM_HPP
+#define EXTENSER_STREAM_HPP
+
+#include "extenser.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace extenser
+{
+// Controls how much of the serial form serialize_to() and deserialize_from() hold at once
+struct stream_options
+{
+    // Bytes to write per batch of array elements, and the initial size of the input window. An
+    // element larger than this is still held whole
+    std::size_t buffer_size{ 64 * 1024 };
+};
+
+namespace detail
+{
+    // Arrays of arithmetic values and enums are written as a block by some adapters, so only
+    // arrays of other values are written a batch of elements at a time
+    template<typename T, typename = void>
+    struct is_streamable_array : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_streamable_array<T, std::enable_if_t<containers::traits<T>::is_sequential>> :
+        std::bool_constant<!std::is_arithmetic_v<typename containers::traits<T>::value_type>
+            && !std::is_enum_v<typename containers::traits<T>::value_type>>
+    {
+    };
+
+    // ...and read an element at a time into a container that can be appended to
+    template<typename T, typename = void>
+    struct is_appendable_array : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_appendable_array<T,
+        std::void_t<decltype(std::declval<T&>().push_back(
+            std::declval<typename containers::traits<T>::value_type>()))>> :
+        std::bool_constant<is_streamable_array<T>::value
+            && !containers::traits<T>::has_fixed_size && containers::traits<T>::is_mutable
+            && std::is_default_constructible_v<typename containers::traits<T>::value_type>>
+    {
+    };
+
+    // Views into the input (std::string_view and byte views), which would dangle once the part of
+    // the stream they were read from is reused or freed. Members of user-defined types can't be
+    // seen, so only views and standard types holding them are caught
+    template<typename T>
+    struct is_view : std::false_type
+    {
+    };
+
+    template<typename CharT, typename Traits>
+    struct is_view<std::basic_string_view<CharT, Traits>> : std::true_type
+    {
+    };
+
+    template<typename T>
+    struct is_view<span<T>> : std::true_type
+    {
+    };
+
+    template<typename T, typename = void>
+    struct holds_view : is_view<T>
+    {
+    };
+
+    template<typename T>
+    struct holds_view<T, std::enable_if_t<is_container_v<T> && !is_view<T>::value>> :
+        holds_view<std::remove_cv_t<typename T::value_type>>
+    {
+    };
+
+    template<typename T>
+    struct holds_view<std::optional<T>> : holds_view<T>
+    {
+    };
+
+    template<typename T1, typename T2>
+    struct holds_view<std::pair<T1, T2>> :
+        std::disjunction<holds_view<std::remove_cv_t<T1>>, holds_view<std::remove_cv_t<T2>>>
+    {
+    };
+
+    template<typename... Args>
+    struct holds_view<std::tuple<Args...>> : std::disjunction<holds_view<Args>...>
+    {
+    };
+
+    template<typename... Args>
+    struct holds_view<std::variant<Args...>> : std::disjunction<holds_view<Args>...>
+    {
+    };
+
+    // Adapters take part in writing by providing serialize_array_head(val),
+    // serialize_elements(first, last) and serialize_array_tail(), each of which writes its part of
+    // the array to a new serializer, and element_separator(), written between runs of elements
+    template<typename Adapter, typename T, typename = void>
+    struct has_array_head : std::false_type
+    {
+    };
+
+    template<typename Adapter, typename T>
+    struct has_array_head<Adapter, T,
+        std::void_t<decltype(std::declval<typename Adapter::serializer_t&>().serialize_array_head(
+            std::declval<const T&>()))>> : std::true_type
+    {
+    };
+
+    // ...and in reading by providing scan_array_head(), scan_array_item(pos, index) and
+    // scan_trailing(pos), which find the parts of the array in a window of the input
+    template<typename Adapter, typename = void>
+    struct has_scan_array : std::false_type
+    {
+    };
+
+    template<typename Adapter>
+    struct has_scan_array<Adapter,
+        std::void_t<decltype(std::declval<typename Adapter::deserializer_t&>().scan_array_head())>>
+        : std::true_type
+    {
+    };
+
+    // Serial forms held as bytes (or chars) are copied to and from the stream as is
+    template<typename Serial, typename = void>
+    struct is_byte_serial : std::false_type
+    {
+    };
+
+    template<typename Serial>
+    struct is_byte_serial<Serial, std::void_t<decltype(std::declval<Serial&>().data())>> :
+        std::bool_constant<sizeof(typename Serial::value_type) == 1>
+    {
+    };
+
+    inline void write_bytes(std::ostream& out, const void* const p_data, const std::size_t size)
+    {
+        if (size != 0
+            && !out.write(static_cast<const char*>(p_data), static_cast<std::streamsize>(size)))
+        {
+            throw serialization_error{ "stream error: write failed" };
+        }
+    }
+
+    inline void write_bytes(
+        std::FILE* const p_file, const void* const p_data, const std::size_t size)
+    {
+        if (size != 0 && std::fwrite(p_data, 1, size, p_file) != size)
+        {
+            throw serialization_error{ "stream error: write failed" };
+        }
+    }
+
+    // Reads up to size bytes, fewer only at the end of the input
+    inline auto read_bytes(std::istream& in, void* const p_data, const std::size_t size)
+        -> std::size_t
+    {
+        in.read(static_cast<char*>(p_data), static_cast<std::streamsize>(size));
+
+        if (in.bad())
+        {
+            throw deserialization_error{ "stream error: read failed" };
+        }
+
+        return static_cast<std::size_t>(in.gcount());
+    }
+
+    inline auto read_bytes(std::FILE* const p_file, void* const p_data, const std::size_t size)
+        -> std::size_t
+    {
+        const auto count = std::fread(p_data, 1, size, p_file);
+
+        if (count != size && std::ferror(p_file) != 0)
+        {
+            throw deserialization_error{ "stream error: read failed" };
+        }
+
+        return count;
+    }
+
+    // Other serial forms (nlohmann::json) go through their stream operators
+    template<typename Serial>
+    void write_serial(std::ostream& out, const Serial& serial)
+    {
+        if constexpr (is_byte_serial<Serial>::value)
+        {
+            write_bytes(out, serial.data(), serial.size());
+        }
+        else if (!(out << serial))
+        {
+            throw serialization_error{ "stream error: write failed" };
+        }
+    }
+
+    template<typename Serial>
+    void write_serial(std::FILE* const p_file, const Serial& serial)
+    {
+        if constexpr (is_byte_serial<Serial>::value)
+        {
+            write_bytes(p_file, serial.data(), serial.size());
+        }
+        else
+        {
+            std::ostringstream text{};
+            text << serial;
+            const auto str = std::move(text).str();
+            write_bytes(p_file, str.data(), str.size());
+        }
+    }
+
+    template<typename Serial, typename Source>
+    void read_all(Source& source, Serial& serial, const std::size_t buffer_size)
+    {
+        std::size_t size = 0;
+        serial.resize(std::max(buffer_size, std::size_t{ 1 }));
+
+        while (true)
+        {
+            const auto count = read_bytes(source, serial.data() + size, serial.size() - size);
+            size += count;
+
+            if (size != serial.size())
+            {
+                break;
+            }
+
+            serial.resize(serial.size() * 2);
+        }
+
+        serial.resize(size);
+    }
+
+    template<typename Serial>
+    void read_serial(std::istream& in, Serial& serial, const std::size_t buffer_size)
+    {
+        if constexpr (is_byte_serial<Serial>::value)
+        {
+            read_all(in, serial, buffer_size);
+        }
+        else if (!(in >> serial))
+        {
+            throw deserialization_error{ "stream error: read failed" };
+        }
+    }
+
+    template<typename Serial>
+    void read_serial(std::FILE* const p_file, Serial& serial, const std::size_t buffer_size)
+    {
+        if constexpr (is_byte_serial<Serial>::value)
+        {
+            read_all(p_file, serial, buffer_size);
+        }
+        else
+        {
+            std::string str{};
+            read_all(p_file, str, buffer_size);
+            std::istringstream text{ std::move(str) };
+            read_serial(text, serial, buffer_size);
+        }
+    }
+
+    template<typename Adapter, typename T, typename Sink>
+    void write_array(Sink& sink, const T& val, const stream_options& options)
+    {
+        using serializer_t = typename Adapter::serializer_t;
+
+        // Every part is written to the same buffer, reusing its capacity
+        typename Adapter::serial_t piece{};
+
+        {
+            serializer_t ser{ std::ref(piece) };
+            ser.serialize_array_head(val);
+            write_serial(sink, ser.object());
+        }
+
+        const auto separator = serializer_t::element_separator();
+        std::size_t batch_size = 1;
+        std::size_t elements_written = 0;
+        std::size_t bytes_written = 0;
+
+        for (auto first = std::begin(val), last = std::end(val); first != last;)
+        {
+            auto batch_last = first;
+            std::size_t count = 0;
+
+            for (; count != batch_size && batch_last != last; ++count)
+            {
+                ++batch_last;
+            }
+
+            serializer_t ser{ std::ref(piece) };
+            ser.serialize_elements(first, batch_last);
+
+            if (elements_written != 0)
+            {
+                write_bytes(sink, separator.data(), separator.size());
+            }
+
+            const auto& bytes = ser.object();
+            write_bytes(sink, bytes.data(), bytes.size());
+
+            // Later batches are sized to fill the buffer with elements as large as the average
+            elements_written += count;
+            bytes_written += bytes.size();
+            batch_size = std::max(options.buffer_size
+                    / std::max(bytes_written / elements_written, std::size_t{ 1 }),
+                std::size_t{ 1 });
+
+            first = batch_last;
+        }
+
+        serializer_t ser{ std::ref(piece) };
+        ser.serialize_array_tail();
+        write_serial(sink, ser.object());
+    }
+
+    // The unread part of the input, refilled from the source as it is consumed. It only grows
+    // (doubling) when an item does not fit in it
+    template<typename Serial, typename Source>
+    class stream_window
+    {
+    public:
+        stream_window(Source& source, const std::size_t capacity)
+            : m_source(source),
+              m_buffer(std::max(capacity, std::size_t{ 1 }), typename Serial::value_type{})
+        {
+        }
+
+        [[nodiscard]] auto data() const noexcept -> const typename Serial::value_type*
+        {
+            return m_buffer.data() + m_begin;
+        }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return m_end - m_begin; }
+        [[nodiscard]] auto eof() const noexcept -> bool { return m_eof; }
+
+        void consume(const std::size_t count) noexcept { m_begin += count; }
+
+        void fill()
+        {
+            if (m_begin != 0)
+            {
+                std::memmove(m_buffer.data(), data(), size());
+                m_end -= m_begin;
+                m_begin = 0;
+            }
+
+            if (m_end == m_buffer.size())
+            {
+                m_buffer.resize(m_buffer.size() * 2);
+            }
+
+            const auto requested = m_buffer.size() - m_end;
+            const auto count = read_bytes(m_source, m_buffer.data() + m_end, requested);
+            m_end += count;
+            m_eof = count != requested;
+        }
+
+        // Runs scan_fn over a deserializer of the window, which returns where the item it found
+        // ends. An item ending with the window may go on (a number, in JSON text), and an
+        // end_of_input_error may just be the window cutting an item short, so both are retried
+        // with more input until the source runs out. Any other error is in the input itself, so
+        // it is thrown at once rather than after reading the rest of the source
+        template<typename Deserializer, typename F>
+        void scan(const F& scan_fn)
+        {
+            while (true)
+            {
+                try
+                {
+                    Deserializer des{ data(), size() };
+
+                    if (scan_fn(des) < size() || m_eof)
+                    {
+                        return;
+                    }
+                }
+                catch (const end_of_input_error&)
+                {
+                    if (m_eof)
+                    {
+                        throw;
+                    }
+                }
+
+                fill();
+            }
+        }
+
+    private:
+        Source& m_source;
+        Serial m_buffer;
+        std::size_t m_begin{};
+        std::size_t m_end{};
+        bool m_eof{};
+    };
+
+    template<typename Adapter, typename T, typename Source>
+    void read_array(Source& source, T& val, const stream_options& options)
+    {
+        using deserializer_t = typename Adapter::deserializer_t;
+        using value_t = typename containers::traits<T>::value_type;
+
+        stream_window<typename Adapter::serial_t, Source> window{ source, options.buffer_size };
+        window.fill();
+
+        std::pair<std::size_t, std::size_t> head{};
+        window.template scan<deserializer_t>(
+            [&head](deserializer_t& des)
+            {
+                head = des.scan_array_head();
+                return head.first;
+            });
+
+        window.consume(head.first);
+        containers::adapter<T>::presize(val, 0);
+
+        // The count is std::size_t(-1) when the end of the array is marked instead
+        for (std::size_t index = 0; index != head.second; ++index)
+        {
+            std::pair<std::size_t, std::size_t> item{};
+            window.template scan<deserializer_t>(
+                [&item, index](deserializer_t& des)
+                {
+                    item = des.scan_array_item(0, index);
+                    return item.second;
+                });
+
+            if (item.first == item.second)
+            {
+                window.consume(item.second);
+                break;
+            }
+
+            auto elem = make_value<value_t>();
+            deserializer_t des{ window.data() + item.first, item.second - item.first };
+            des.deserialize_object(elem);
+            containers::adapter<T>::append(val, std::move(elem));
+
+            window.consume(item.second);
+        }
+
+        while (true)
+        {
+            deserializer_t des{ window.data(), window.size() };
+
+            if (des.scan_trailing(0) != window.size())
+            {
+                throw deserialization_error{ "stream error: unexpected trailing input" };
+            }
+
+            window.consume(window.size());
+
+            if (window.eof())
+            {
+                return;
+            }
+
+            window.fill();
+        }
+    }
+
+    template<typename Adapter, typename T, typename Sink>
+    void write_to(Sink& sink, const T& val, const stream_options& options)
+    {
+        if constexpr (is_streamable_array<T>::value && has_array_head<Adapter, T>::value)
+        {
+            write_array<Adapter>(sink, val, options);
+        }
+        else
+        {
+            write_serial(sink, easy_serializer<Adapter>::quick_serialize(val));
+        }
+    }
+
+    template<typename Adapter, typename T, typename Source>
+    void read_from(Source& source, T& val, const stream_options& options)
+    {
+        static_assert(!holds_view<T>::value,
+            "values read from a stream must not hold views into the input, which is not kept");
+
+        if constexpr (is_appendable_array<T>::value && has_scan_array<Adapter>::value)
+        {
+            read_array<Adapter>(source, val, options);
+        }
+        else
+        {
+            typename Adapter::serial_t serial{};
+            read_serial(source, serial, options.buffer_size);
+            easy_serializer<Adapter>::quick_deserialize(serial, val);
+        }
+    }
+} //namespace detail
+
+// Writes val to out, producing the same bytes as easy_serializer<Adapter>::quick_serialize().
+// When val is a container of objects (or strings, ...), and the adapter supports it (all but
+// json_adapter), its elements are serialized and written in batches of about
+// options.buffer_size bytes, so its whole serial form is never held in memory. Other values are
+// serialized whole and then written. Throws serialization_error if writing fails
+template<typename Adapter, typename T>
+void serialize_to(std::ostream& out, const T& val, const stream_options& options = {})
+{
+    detail::write_to<Adapter>(out, val, options);
+}
+
+// As above, writing to p_file (a file descriptor can be wrapped with fdopen())
+template<typename Adapter, typename T>
+void serialize_to(std::FILE* p_file, const T& val, const stream_options& options = {})
+{
+    EXTENSER_PRECONDITION(p_file != nullptr);
+
+    detail::write_to<Adapter>(p_file, val, options);
+}
+
+// Reads val from the rest of in, as easy_serializer<Adapter>::quick_deserialize() would from the
+// same bytes. When val is a std::vector, std::deque or std::list of objects (or strings, ...), and
+// the adapter supports it (msgpack_adapter, cbor_adapter and json_text_adapter), the input is read
+// through a window of options.buffer_size bytes (growing only to fit a larger element) and each
+// element is deserialized as soon as it has been read. Otherwise the input is read whole and then
+// deserialized. Either way the input is gone once this returns, so val must not keep views into it
+// (std::string_view or byte views): elements that are such views, or standard types holding them,
+// are rejected at compile time. Throws deserialization_error if reading fails
+template<typename Adapter, typename T>
+void deserialize_from(std::istream& in, T& val, const stream_options& options = {})
+{
+    detail::read_from<Adapter>(in, val, options);
+}
+
+// As above, reading from p_file (a file descriptor can be wrapped with fdopen())
+template<typename Adapter, typename T>
+void deserialize_from(std::FILE* p_file, T& val, const stream_options& options = {})
+{
+    EXTENSER_PRECONDITION(p_file != nullptr);
+
+    detail::read_from<Adapter>(p_file, val, options);
+}
+} //namespace extenser
+#endif //EXTENSER_STREAM_HPP
@@ -0,0 +1,219 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+// Behavior every adapter shares, checked against each of them
+
+#include "extenser/cbor_adapter/extenser_cbor.hpp"
+#include "extenser/json_adapter/extenser_json.hpp"
+#include "extenser/json_adapter/extenser_json_text.hpp"
+#include "extenser/msgpack_adapter/extenser_msgpack.hpp"
+#include "extenser/parallel.hpp"
+#include "extenser/stream.hpp"
+#include "test_helpers.hpp"
+
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace extenser::tests
+{
+TEST_SUITE("adapters")
+{
+    TEST_CASE_TEMPLATE("large arrays can be serialized in parallel", Adapter, json_adapter,
+        json_text_adapter, msgpack_adapter, cbor_adapter)
+    {
+        const parallel_options options{ 4, 100 };
+
+        SUBCASE("an array of objects large enough to split between threads is written as on one "
+                "thread")
+        {
+            const auto people = create_people(1001);
+
+            CHECK(serialize_parallel<Adapter>(people, options)
+                == easy_serializer<Adapter>::quick_serialize(people));
+        }
+
+        SUBCASE("an array too small to split is written as on one thread")
+        {
+            const auto people = create_people(10);
+
+            CHECK(serialize_parallel<Adapter>(people, options)
+                == easy_serializer<Adapter>::quick_serialize(people));
+        }
+    }
+
+    // Reads a Pet's species as a string, which every adapter writes as a number
+    struct SpeciesReader
+    {
+        std::string name{};
+        std::string species{};
+
+        template<typename S>
+        void serialize(generic_serializer<S>& ser)
+        {
+            ser.as_string("name", name);
+
+            if (name.empty())
+            {
+                throw std::invalid_argument{ "unnamed pet" };
+            }
+
+            ser.as_string("species", species);
+        }
+    };
+
+    struct PetReader
+    {
+        std::vector<PetReader> friends{};
+        std::optional<SpeciesReader> pet{};
+
+        template<typename S>
+        void serialize(generic_serializer<S>& ser)
+        {
+            ser.as_array("friends", friends);
+            ser.as_optional("pet", pet);
+        }
+    };
+
+    TEST_CASE_TEMPLATE("try_deserialize reports errors with their path", Adapter, json_adapter,
+        json_text_adapter, msgpack_adapter, cbor_adapter)
+    {
+        Person person{ 30, "Alice", create_people(3), {}, {} };
+
+        for (auto& friend_ : person.friends)
+        {
+            friend_.pet.reset();
+        }
+
+        person.friends[1].pet = Pet{ "Sparky", Pet::Species::Dog };
+
+        SUBCASE("a value of the wrong type is reported without throwing")
+        {
+            const auto serial = easy_serializer<Adapter>::quick_serialize(person);
+
+            PetReader test_val{};
+            deserialization_result result{};
+            REQUIRE_NOTHROW(result = easy_serializer<Adapter>::try_deserialize(serial, test_val));
+
+            CHECK(result.code == deserialization_errc::type_mismatch);
+            CHECK(result.path == "/friends/1/pet/species");
+            CHECK_FALSE(result.message.empty());
+        }
+
+        SUBCASE("an exception thrown while reading a value is reported with its path")
+        {
+            person.friends[1].pet->name.clear();
+            const auto serial = easy_serializer<Adapter>::quick_serialize(person);
+
+            PetReader test_val{};
+            deserialization_result result{};
+            REQUIRE_NOTHROW(result = easy_serializer<Adapter>::try_deserialize(serial, test_val));
+
+            CHECK(result.code == deserialization_errc::malformed);
+            CHECK(result.path == "/friends/1/pet");
+            CHECK(result.message == "unnamed pet");
+        }
+    }
+
+    // Reading views from a stream is rejected, as the input they point into is not kept
+    static_assert(detail::holds_view<std::vector<std::string_view>>::value);
+    static_assert(detail::holds_view<std::vector<std::pair<int, view<std::uint8_t>>>>::value);
+    static_assert(
+        detail::holds_view<std::map<std::string, std::optional<std::string_view>>>::value);
+    static_assert(!detail::holds_view<std::vector<Person>>::value);
+    static_assert(!detail::holds_view<std::vector<std::string>>::value);
+
+    TEST_CASE_TEMPLATE("values can be written to and read from streams", Adapter, msgpack_adapter,
+        cbor_adapter, json_text_adapter)
+    {
+        const stream_options options{ 64 };
+
+        SUBCASE("an array larger than the stream buffer")
+        {
+            const auto people = create_people(300);
+            const auto serial = easy_serializer<Adapter>::quick_serialize(people);
+            const std::string text{ serial.begin(), serial.end() };
+
+            SUBCASE("is written in batches, producing the same output")
+            {
+                std::ostringstream out{};
+                serialize_to<Adapter>(out, people, options);
+                CHECK(out.str() == text);
+            }
+
+            SUBCASE("is read back an element at a time")
+            {
+                std::istringstream in{ text };
+                std::vector<Person> test_val{ Person{} };
+                deserialize_from<Adapter>(in, test_val, stream_options{ 1 });
+                CHECK(test_val == people);
+            }
+
+            SUBCASE("round trips through a FILE*")
+            {
+                std::FILE* const p_file = std::tmpfile();
+                REQUIRE(p_file != nullptr);
+
+                serialize_to<Adapter>(p_file, people, options);
+                std::rewind(p_file);
+
+                std::vector<Person> test_val{};
+                deserialize_from<Adapter>(p_file, test_val, options);
+                std::fclose(p_file);
+
+                CHECK(test_val == people);
+            }
+
+            SUBCASE("throws when cut short")
+            {
+                std::istringstream in{ text.substr(0, text.size() - 1) };
+                std::vector<Person> test_val{};
+                CHECK_THROWS_AS(
+                    deserialize_from<Adapter>(in, test_val, options), deserialization_error);
+            }
+        }
+
+        SUBCASE("a value that is not an array")
+        {
+            const auto person = create_people(1).front();
+            const auto serial = easy_serializer<Adapter>::quick_serialize(person);
+            const std::string text{ serial.begin(), serial.end() };
+
+            SUBCASE("is written and read whole")
+            {
+                std::ostringstream out{};
+                serialize_to<Adapter>(out, person);
+                REQUIRE(out.str() == text);
+
+                std::istringstream in{ out.str() };
+                Person test_val{};
+                deserialize_from<Adapter>(in, test_val);
+                CHECK(test_val == person);
+            }
+
+            SUBCASE("throws when read as an array")
+            {
+                std::istringstream in{ text };
+                std::vector<Person> test_val{};
+                CHECK_THROWS_AS(deserialize_from<Adapter>(in, test_val), deserialization_error);
+            }
+        }
+    }
+}
+} //namespace extenser::tests
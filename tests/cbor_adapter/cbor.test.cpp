@@ -0,0 +1,561 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#include "extenser/cbor_adapter/extenser_cbor.hpp"
+#include "extenser/stream.hpp"
+#include "test_helpers.hpp"
+
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace extenser::tests
+{
+namespace
+{
+    using bytes = std::vector<std::uint8_t>;
+
+    // Decodes a string of hex digits, as the examples in RFC 8949 Appendix A are written
+    auto hex(const std::string_view digits) -> bytes
+    {
+        const auto nibble = [](const char c)
+        { return static_cast<std::uint8_t>(c <= '9' ? c - '0' : c - 'a' + 10); };
+
+        bytes out{};
+
+        for (std::size_t i = 0; i + 1 < digits.size(); i += 2)
+        {
+            out.push_back(
+                static_cast<std::uint8_t>((nibble(digits[i]) << 4U) | nibble(digits[i + 1])));
+        }
+
+        return out;
+    }
+
+    template<typename T>
+    auto encode(const T& val) -> bytes
+    {
+        return easy_serializer<cbor_adapter>::quick_serialize(val);
+    }
+
+    template<typename T>
+    auto decode(const bytes& serial) -> T
+    {
+        return easy_serializer<cbor_adapter>::quick_deserialize<T>(serial);
+    }
+
+    template<typename T>
+    auto round_trips(const T& val) -> bool
+    {
+        return decode<T>(encode(val)) == val;
+    }
+} //namespace
+
+TEST_SUITE("cbor::serializer")
+{
+    SCENARIO("scalars are written in their canonical CBOR form")
+    {
+        GIVEN("the integer examples from RFC 8949 Appendix A")
+        {
+            THEN("each is written in its shortest form")
+            {
+                CHECK_EQ(encode(0), hex("00"));
+                CHECK_EQ(encode(23), hex("17"));
+                CHECK_EQ(encode(24), hex("1818"));
+                CHECK_EQ(encode(1000), hex("1903e8"));
+                CHECK_EQ(encode(1000000), hex("1a000f4240"));
+                CHECK_EQ(encode(std::int64_t{ 1000000000000 }), hex("1b000000e8d4a51000"));
+                CHECK_EQ(encode(std::numeric_limits<std::uint64_t>::max()),
+                    hex("1bffffffffffffffff"));
+                CHECK_EQ(encode(-1), hex("20"));
+                CHECK_EQ(encode(-100), hex("3863"));
+                CHECK_EQ(encode(-1000), hex("3903e7"));
+                CHECK_EQ(encode(std::numeric_limits<std::int64_t>::min()),
+                    hex("3b7fffffffffffffff"));
+            }
+        }
+
+        GIVEN("the float examples from RFC 8949 Appendix A")
+        {
+            THEN("each is written in the shortest width that holds its value")
+            {
+                CHECK_EQ(encode(0.0), hex("f90000"));
+                CHECK_EQ(encode(-0.0), hex("f98000"));
+                CHECK_EQ(encode(1.0), hex("f93c00"));
+                CHECK_EQ(encode(1.5F), hex("f93e00"));
+                CHECK_EQ(encode(65504.0), hex("f97bff"));
+                CHECK_EQ(encode(5.960464477539063e-8), hex("f90001"));
+                CHECK_EQ(encode(0.00006103515625), hex("f90400"));
+                CHECK_EQ(encode(-4.0), hex("f9c400"));
+                CHECK_EQ(encode(100000.0), hex("fa47c35000"));
+                CHECK_EQ(encode(3.4028234663852886e+38), hex("fa7f7fffff"));
+                CHECK_EQ(encode(1.1), hex("fb3ff199999999999a"));
+                CHECK_EQ(encode(1.0e+300), hex("fb7e37e43c8800759c"));
+                CHECK_EQ(encode(std::numeric_limits<double>::infinity()), hex("f97c00"));
+                CHECK_EQ(encode(std::numeric_limits<double>::quiet_NaN()), hex("f97e00"));
+            }
+        }
+
+        GIVEN("the other simple values and strings")
+        {
+            THEN("each matches RFC 8949 Appendix A")
+            {
+                CHECK_EQ(encode(false), hex("f4"));
+                CHECK_EQ(encode(true), hex("f5"));
+                CHECK_EQ(encode(std::optional<int>{}), hex("f6"));
+                CHECK_EQ(encode(std::string{}), hex("60"));
+                CHECK_EQ(encode(std::string{ "IETF" }), hex("6449455446"));
+                CHECK_EQ(encode(std::vector<std::string>{}), hex("80"));
+                CHECK_EQ(encode(std::list<int>{ 1, 2, 3 }), hex("83010203"));
+                CHECK_EQ(encode(bytes{ 0x01U, 0x02U, 0x03U, 0x04U }), hex("4401020304"));
+            }
+        }
+    }
+
+    SCENARIO("map entries are sorted by their encoded keys")
+    {
+        GIVEN("a map whose keys are not in canonical order")
+        {
+            const std::map<std::string, int> test_val{ { "aa", 2 }, { "b", 1 }, { "a", 3 } };
+
+            WHEN("the map is serialized")
+            {
+                const auto serial = encode(test_val);
+
+                THEN("shorter keys come first, then keys of a length by their bytes")
+                {
+                    CHECK_EQ(serial, hex("a3616103616201626161" "02"));
+                }
+            }
+        }
+
+        GIVEN("an unordered_map with negative and positive keys")
+        {
+            std::unordered_map<int, int> test_val{};
+
+            for (int i = -20; i <= 20; ++i)
+            {
+                test_val.emplace(i * 7, i);
+            }
+
+            WHEN("the map is serialized")
+            {
+                const auto serial = encode(test_val);
+
+                THEN("the bytes do not depend on the map's iteration order")
+                {
+                    std::unordered_map<int, int> reordered{};
+                    reordered.reserve(1024);
+                    reordered.insert(test_val.begin(), test_val.end());
+
+                    CHECK_EQ(encode(reordered), serial);
+                    CHECK(decode<std::unordered_map<int, int>>(serial) == test_val);
+                }
+            }
+        }
+
+        GIVEN("an object whose fields are not in canonical order")
+        {
+            const Employee test_val{ 7, "Eve", std::nullopt, {} };
+
+            WHEN("the object is serialized")
+            {
+                const auto serial = encode(test_val);
+
+                THEN("its fields are sorted as well")
+                {
+                    CHECK_EQ(serial, hex("a46269640763706574f6646e616d656345766565726f6c657380"));
+                    CHECK(round_trips(test_val));
+                }
+            }
+        }
+
+        GIVEN("a map with more than 255 entries")
+        {
+            std::map<std::string, int> test_val{};
+
+            for (int i = 0; i < 300; ++i)
+            {
+                test_val.emplace(std::to_string(i), i);
+            }
+
+            THEN("the value round-trips")
+            {
+                const auto serial = encode(test_val);
+
+                CHECK_EQ(serial[0], 0xB9U);
+                CHECK(round_trips(test_val));
+            }
+        }
+
+        GIVEN("more than 23 keyed values written directly, in reverse order")
+        {
+            cbor_adapter::serializer_t ser{};
+            std::map<std::string, int> expected{};
+
+            for (int i = 29; i >= 0; --i)
+            {
+                const auto key = std::to_string(i);
+                ser.as_int(key, i);
+                expected.emplace(key, i);
+            }
+
+            THEN("the document holds a sorted map with a two byte header")
+            {
+                const auto& serial = ser.object();
+
+                CHECK_EQ(serial, encode(expected));
+                CHECK_EQ(serial[0], 0xB8U);
+                CHECK_EQ(serial[1], 30);
+            }
+        }
+    }
+
+    SCENARIO("contiguous arithmetic containers are written as typed arrays")
+    {
+        GIVEN("a vector of uint16")
+        {
+            const std::vector<std::uint16_t> test_val{ 0x0102U, 0x0304U };
+
+            WHEN("the vector is serialized")
+            {
+                const auto serial = encode(test_val);
+
+                THEN("it is a little-endian tagged byte string on every host")
+                {
+                    CHECK_EQ(serial, hex("d8454402010403"));
+                }
+            }
+        }
+
+        GIVEN("a typed array in the other byte order")
+        {
+            const auto serial = detail_cbor::is_little_endian_host ? hex("d8494401020304")
+                                                                   : hex("d84d4402010403");
+
+            WHEN("it is deserialized")
+            {
+                const auto val = decode<std::vector<std::int16_t>>(serial);
+
+                THEN("the elements are swapped to the host's byte order")
+                {
+                    CHECK_EQ(val, (std::vector<std::int16_t>{ 0x0102, 0x0304 }));
+                }
+            }
+        }
+
+        GIVEN("a plain CBOR array of numbers")
+        {
+            const auto serial = hex("83010203");
+
+            THEN("it can still be read into a contiguous container")
+            {
+                const std::vector<double> expected{ 1.0, 2.0, 3.0 };
+                CHECK_EQ(decode<std::vector<double>>(serial), expected);
+            }
+        }
+
+        GIVEN("contiguous containers of floats and signed integers")
+        {
+            THEN("each value round-trips")
+            {
+                CHECK(round_trips(std::vector<double>{ 0.1, -2.5, 1e300 }));
+                CHECK(round_trips(std::vector<float>{ 0.1F, -2.5F }));
+                CHECK(round_trips(std::array<std::int64_t, 3>{ -1, 0, 1 }));
+                CHECK(round_trips(std::vector<std::int8_t>{ -128, 127 }));
+                CHECK(round_trips(std::u16string{ u"wide" }));
+            }
+        }
+    }
+}
+
+TEST_SUITE("cbor::deserializer")
+{
+    using deserializer = cbor_adapter::deserializer_t;
+
+    // The bytes are read in place, so a temporary vector would dangle
+    static_assert(!std::is_constructible_v<deserializer, bytes&&>);
+    static_assert(std::is_constructible_v<deserializer, const bytes&>);
+
+    SCENARIO("values round-trip through CBOR")
+    {
+        GIVEN("a Person with friends, a pet and a map")
+        {
+            Person test_val{ 30, "Alice", {}, Pet{ "Rex", Pet::Species::Dog },
+                { { Fruit::Apple, 2 }, { Fruit::Kiwi, 5 } } };
+
+            test_val.friends.push_back(Person{ 29, "Bob", {}, std::nullopt, {} });
+
+            THEN("the value round-trips")
+            {
+                CHECK(round_trips(test_val));
+            }
+        }
+
+        GIVEN("scalars at the edges of their range")
+        {
+            THEN("each value round-trips")
+            {
+                CHECK(round_trips(std::numeric_limits<std::int64_t>::min()));
+                CHECK(round_trips(std::numeric_limits<std::uint64_t>::max()));
+                CHECK(round_trips(std::numeric_limits<double>::denorm_min()));
+                CHECK(round_trips(std::numeric_limits<float>::lowest()));
+                CHECK(round_trips(-std::numeric_limits<double>::infinity()));
+                CHECK(round_trips(PlainEnum::VALUE_XX));
+                CHECK(std::isnan(decode<double>(encode(std::numeric_limits<double>::quiet_NaN()))));
+            }
+        }
+
+        GIVEN("containers, tuples and variants")
+        {
+            const std::multimap<int, std::string> test_multimap{ { 1, "a" }, { 1, "b" },
+                { 2, "c" } };
+
+            THEN("each value round-trips")
+            {
+                CHECK(round_trips(create_test_val<std::vector<bool>>()));
+                CHECK(round_trips(create_test_val<std::list<Person>>()));
+                CHECK(round_trips(create_test_val<std::set<int>>()));
+                CHECK(round_trips(create_3d_vec(3, 4, 5)));
+                CHECK(round_trips(test_multimap));
+                CHECK(round_trips(std::pair<int, std::string>{ 1, "one" }));
+                CHECK(round_trips(std::tuple<int, double, std::string>{ 1, 2.5, "three" }));
+                CHECK(round_trips(std::variant<int, std::string>{ "alt" }));
+                CHECK(round_trips(Shape{ Rect{ 3, 4 } }));
+                CHECK(round_trips(std::string(70000, 'z')));
+            }
+        }
+
+        GIVEN("a variant whose alternatives are tagged")
+        {
+            const auto serial = encode(Shape{ Rect{ 3, 4 } });
+
+            THEN("it is written as the tag id and read back in any alternative order")
+            {
+                REQUIRE_GE(serial.size(), 2U);
+                CHECK_EQ(serial[0], 0x82U);
+                CHECK_EQ(serial[1], 0x07U);
+                CHECK(std::get<Rect>(decode<std::variant<Rect, Circle>>(serial)) == Rect{ 3, 4 });
+                CHECK_THROWS_AS(decode<Shape>(hex("820500")), deserialization_error);
+            }
+        }
+    }
+
+    SCENARIO("CBOR written by other encoders is accepted")
+    {
+        GIVEN("indefinite-length arrays and strings from RFC 8949 Appendix A")
+        {
+            THEN("they are read like definite ones")
+            {
+                using nested_t = std::tuple<int, std::vector<int>, std::vector<int>>;
+
+                const nested_t nested{ 1, { 2, 3 }, { 4, 5 } };
+                const bytes streamed{ 0x01U, 0x02U, 0x03U, 0x04U, 0x05U };
+
+                CHECK_EQ(decode<nested_t>(hex("9f018202039f0405ffff")), nested);
+
+                CHECK_EQ(decode<std::string>(hex("7f657374726561646d696e67ff")), "streaming");
+                CHECK_EQ(decode<bytes>(hex("5f42010243030405ff")), streamed);
+            }
+        }
+
+        GIVEN("an indefinite-length map holding an object's fields out of order")
+        {
+            // {_ "species": 2, "extra": [_ 1], "name": "Rex"}
+            const auto serial = hex("bf6773706563696573026565787472619f01ff646e616d6563526578ff");
+
+            THEN("the object is found, skipping the unknown field")
+            {
+                CHECK_EQ(decode<Pet>(serial), (Pet{ "Rex", Pet::Species::Dog }));
+            }
+        }
+
+        GIVEN("a map whose keys are indefinite-length strings")
+        {
+            // {_ (_ "spe" "cies"): 2, "name": (_ "R" "ex")}
+            const auto serial = hex("bf7f637370656463696573ff02646e616d657f6152626578ffff");
+
+            THEN("the chunked keys are joined before they are matched")
+            {
+                CHECK_EQ(decode<Pet>(serial), (Pet{ "Rex", Pet::Species::Dog }));
+            }
+        }
+
+        GIVEN("a value wrapped in the self-described CBOR tag")
+        {
+            const auto serial = hex("d9d9f71864");
+
+            THEN("the tag is skipped")
+            {
+                CHECK_EQ(decode<int>(serial), 100);
+            }
+        }
+
+        GIVEN("a half-precision float")
+        {
+            const auto serial = hex("f93e00");
+
+            THEN("it can be read as a float or a double")
+            {
+                CHECK_EQ(decode<float>(serial), 1.5F);
+                CHECK_EQ(decode<double>(serial), 1.5);
+            }
+        }
+    }
+
+    SCENARIO("views borrow from the input")
+    {
+        GIVEN("a serialized string")
+        {
+            const auto serial = encode(std::string{ "borrowed" });
+
+            WHEN("it is deserialized as a view")
+            {
+                std::string_view str{};
+                easy_serializer<cbor_adapter>::quick_deserialize(serial, str);
+
+                THEN("the view points into the input")
+                {
+                    CHECK_EQ(str, "borrowed");
+                    CHECK_EQ(static_cast<const void*>(str.data()),
+                        static_cast<const void*>(serial.data() + 1));
+                }
+            }
+        }
+
+        GIVEN("an indefinite-length string")
+        {
+            const auto serial = hex("7f657374726561646d696e67ff");
+
+            THEN("it cannot be viewed")
+            {
+                std::string_view str{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(str), deserialization_error);
+            }
+        }
+    }
+
+    SCENARIO("invalid input is rejected")
+    {
+        GIVEN("malformed or hostile input")
+        {
+            THEN("deserializing throws")
+            {
+                int num{};
+                std::uint8_t small{};
+                std::vector<int> vec{};
+                std::string str{};
+
+                const auto parse = [](const std::string_view digits, auto& val)
+                {
+                    const auto serial = hex(digits);
+                    deserializer{ serial }.deserialize_object(val);
+                };
+
+                CHECK_THROWS_AS(parse("19ff", num), deserialization_error);
+                CHECK_THROWS_AS(parse("0102", num), deserialization_error);
+                CHECK_THROWS_AS(parse("1c", num), deserialization_error);
+                CHECK_THROWS_AS(parse("1f", num), deserialization_error);
+                CHECK_THROWS_AS(parse("ff", num), deserialization_error);
+                CHECK_THROWS_AS(parse("6161", num), deserialization_error);
+                CHECK_THROWS_AS(parse("190100", small), deserialization_error);
+                CHECK_THROWS_AS(parse("20", small), deserialization_error);
+                CHECK_THROWS_AS(parse("7a7fffffff61", str), deserialization_error);
+                CHECK_THROWS_AS(parse("9f0102", vec), deserialization_error);
+                CHECK_THROWS_AS(parse("7f4161ff", str), deserialization_error);
+            }
+        }
+
+        GIVEN("an array claiming more elements than the input holds")
+        {
+            const auto serial = hex("9affffffff01");
+
+            THEN("deserializing throws before allocating")
+            {
+                std::vector<int> val{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+                CHECK_EQ(val.capacity(), 0);
+            }
+        }
+
+        GIVEN("an object missing a field")
+        {
+            const auto serial = encode(Foo{ 1 });
+
+            THEN("deserializing throws")
+            {
+                Bar val{ 0 };
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+            }
+        }
+    }
+
+    // The cases shared with the other adapters are in tests/adapters.test.cpp
+    SCENARIO("CBOR-specific input can be read from streams")
+    {
+        GIVEN("an array of objects larger than the stream buffer")
+        {
+            const auto people = create_people(300);
+            const auto serial = encode(people);
+            const stream_options options{ 64 };
+
+            WHEN("the first element is malformed")
+            {
+                // The 3-byte array head is followed by 0x1C, an unsigned integer with a reserved length
+                auto text = std::string{ serial.begin(), serial.end() };
+                text[3] = '\x1C';
+                std::istringstream in{ text };
+                std::vector<Person> test_val{};
+
+                THEN("deserialization throws without reading the rest of the input")
+                {
+                    CHECK_THROWS_AS(deserialize_from<cbor_adapter>(in, test_val, options),
+                        deserialization_error);
+                    CHECK_FALSE(in.eof());
+                }
+            }
+        }
+
+        GIVEN("a tagged, indefinite-length array")
+        {
+            // 55799(["a", "bb"]), written with a break at the end instead of a count
+            const auto serial = hex("d9d9f79f6161626262ff");
+
+            THEN("it is read up to the break")
+            {
+                std::istringstream in{ std::string{ serial.begin(), serial.end() } };
+                std::vector<std::string> test_val{};
+                deserialize_from<cbor_adapter>(in, test_val, stream_options{ 1 });
+                CHECK(test_val == std::vector<std::string>{ "a", "bb" });
+            }
+        }
+    }
+}
+} //namespace extenser::tests
@@ -12,6 +12,7 @@
 #endif
 
 #include "extenser/json_adapter/extenser_json.hpp"
+#include "extenser/parallel.hpp"
 #include "test_helpers.hpp"
 
 #define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
@@ -20,7 +21,9 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <deque>
 #include <limits>
+#include <map>
 #include <optional>
 #include <string>
 #include <type_traits>
@@ -29,6 +32,27 @@
 
 namespace extenser::tests
 {
+namespace
+{
+    // Asks for its fields in a different order than it declares them
+    struct Badge
+    {
+        int id{};
+        std::string label{};
+        int level{};
+
+        EXTENSER_FIELDS("level", "label", "id");
+
+        template<typename S>
+        void serialize(generic_serializer<S>& ser)
+        {
+            ser.as_int("id", id);
+            ser.as_string("label", label);
+            ser.as_int("level", level);
+        }
+    };
+} //namespace
+
 #if defined(EXTENSER_USE_MAGIC_ENUM_TEST)
 TEST_SUITE("json::deserializer (magic_enum)")
 #else
@@ -840,6 +864,37 @@ TEST_SUITE("json::deserializer")
             }
         }
 
+        GIVEN("a deserializer with a JSON object representing a map with narrow or negative keys")
+        {
+            const auto test_obj = nlohmann::json::parse(
+                R"({"small": {"@-128": 1, "@0": 2, "@127": 3}, "fraction": {"@1.5": 5}})");
+            const deserializer dser{ test_obj };
+
+            WHEN("the keys fit the key type")
+            {
+                std::map<std::int8_t, int> test_val{};
+                REQUIRE_NOTHROW(dser.as_map("small", test_val));
+
+                THEN("the keys are parsed")
+                {
+                    REQUIRE_EQ(test_val.size(), 3);
+                    CHECK_EQ(test_val.at(-128), 1);
+                    CHECK_EQ(test_val.at(0), 2);
+                    CHECK_EQ(test_val.at(127), 3);
+                }
+            }
+
+            WHEN("a key is not an integer")
+            {
+                std::map<int, int> test_val{};
+
+                THEN("a deserialization_error is thrown")
+                {
+                    CHECK_THROWS_AS(dser.as_map("fraction", test_val), deserialization_error);
+                }
+            }
+        }
+
         GIVEN("a deserializer with a JSON object representing an unordered_map")
         {
             const std::unordered_map<std::string, Person> expected_val{
@@ -1162,6 +1217,57 @@ TEST_SUITE("json::deserializer")
         }
     }
 
+    SCENARIO("a tagged variant is deserialized by its tag")
+    {
+        GIVEN("a deserializer with a JSON object keyed by the Rect tag")
+        {
+            const auto test_obj = nlohmann::json::parse(R"({"Rect": {"width": 3, "height": 4}})");
+            const deserializer dser{ test_obj };
+
+            WHEN("the object is deserialized as a Shape")
+            {
+                Shape test_val{};
+
+                REQUIRE_NOTHROW(dser.as_variant("", test_val));
+
+                THEN("the variant holds the Rect")
+                {
+                    REQUIRE(std::holds_alternative<Rect>(test_val));
+                    CHECK(std::get<Rect>(test_val) == Rect{ 3, 4 });
+                }
+            }
+
+            WHEN("the object is deserialized as a variant with the alternatives reordered")
+            {
+                std::variant<Rect, Circle> test_val{ Circle{} };
+
+                REQUIRE_NOTHROW(dser.as_variant("", test_val));
+
+                THEN("the variant still holds the Rect")
+                {
+                    REQUIRE(std::holds_alternative<Rect>(test_val));
+                    CHECK(std::get<Rect>(test_val) == Rect{ 3, 4 });
+                }
+            }
+        }
+
+        GIVEN("a deserializer with a JSON object keyed by an unknown tag")
+        {
+            const auto test_obj = nlohmann::json::parse(R"({"Hexagon": {"side": 2}})");
+            const deserializer dser{ test_obj };
+
+            WHEN("the object is deserialized as a Shape")
+            {
+                Shape test_val{};
+
+                THEN("a deserialization_error is thrown")
+                {
+                    CHECK_THROWS_AS(dser.as_variant("", test_val), deserialization_error);
+                }
+            }
+        }
+    }
+
     SCENARIO("a user-defined class can be deserialized from JSON")
     {
         GIVEN("a deserializer with a JSON object representing a class")
@@ -1296,5 +1402,341 @@ TEST_SUITE("json::deserializer")
             }
         }
     }
+
+    SCENARIO("a user-defined class declaring its field keys can be deserialized from JSON")
+    {
+        GIVEN("a deserializer with a JSON object whose members are out of order")
+        {
+            const auto test_obj = nlohmann::json::parse(
+                R"({"roles": ["dev", "ops"], "extra": 1, "pet": null, "name": "Ann", "id": 7})");
+            const deserializer dser{ test_obj };
+
+            WHEN("the class is deserialized")
+            {
+                Employee test_val{};
+
+                REQUIRE_NOTHROW(dser.as_object("", test_val));
+
+                THEN("each field is resolved by its key")
+                {
+                    CHECK_EQ(test_val.id, 7);
+                    CHECK_EQ(test_val.name, "Ann");
+                    CHECK_FALSE(test_val.pet.has_value());
+                    CHECK_EQ(test_val.roles, std::vector<std::string>({ "dev", "ops" }));
+                }
+            }
+        }
+
+        GIVEN("a deserializer with a JSON object containing a sub-object with a nested class")
+        {
+#if defined(EXTENSER_USE_MAGIC_ENUM_TEST)
+            const auto test_obj = nlohmann::json::parse(R"({"test_val": {"id": 1, "name": "Bo",
+                "pet": {"name": "Rex", "species": "Dog"}, "roles": []}})");
+#else
+            const auto test_obj = nlohmann::json::parse(R"({"test_val": {"id": 1, "name": "Bo",
+                "pet": {"name": "Rex", "species": 2}, "roles": []}})");
+#endif
+            const deserializer dser{ test_obj };
+
+            WHEN("the sub-object is deserialized")
+            {
+                Employee test_val{};
+
+                REQUIRE_NOTHROW(dser.as_object("test_val", test_val));
+
+                THEN("the nested class is resolved as well")
+                {
+                    REQUIRE(test_val.pet.has_value());
+                    CHECK_EQ(test_val.pet->name, "Rex");
+                    CHECK_EQ(test_val.pet->species, Pet::Species::Dog);
+                    CHECK_EQ(test_val.id, 1);
+                }
+            }
+        }
+
+        GIVEN("a deserializer with a JSON object for a class reading its fields out of order")
+        {
+            const auto test_obj =
+                nlohmann::json::parse(R"({"id": 3, "label": "guest", "level": 2})");
+            const deserializer dser{ test_obj };
+
+            WHEN("the class is deserialized")
+            {
+                Badge test_val{};
+
+                REQUIRE_NOTHROW(dser.as_object("", test_val));
+
+                THEN("each field is still resolved by its key")
+                {
+                    CHECK_EQ(test_val.id, 3);
+                    CHECK_EQ(test_val.label, "guest");
+                    CHECK_EQ(test_val.level, 2);
+                }
+            }
+        }
+
+        GIVEN("a deserializer with a JSON object missing a declared key")
+        {
+            const auto test_obj = nlohmann::json::parse(R"({"id": 1, "name": "Bo", "pet": null})");
+            const deserializer dser{ test_obj };
+
+            WHEN("the class is deserialized")
+            {
+                Employee test_val{};
+
+                THEN("a deserialization_error is thrown")
+                {
+                    REQUIRE_THROWS_AS(dser.as_object("", test_val), deserialization_error);
+                }
+            }
+        }
+    }
+
+    SCENARIO("a JSON deserializer can be reused after failing on a nested object")
+    {
+        GIVEN("a deserializer with a deeply nested object, one level of which is malformed")
+        {
+            const auto test_obj = nlohmann::json::parse(R"({
+                "bad": {"age": 1, "name": "A", "friends": [{"age": 2, "name": "B",
+                    "friends": [{"age": "3", "name": "C", "friends": [], "pet": null,
+                    "fruit_count": {}}], "pet": null, "fruit_count": {}}],
+                    "pet": null, "fruit_count": {}},
+                "good": {"age": 1, "name": "A", "friends": [{"age": 2, "name": "B",
+                    "friends": [{"age": 3, "name": "C", "friends": [], "pet": null,
+                    "fruit_count": {}}], "pet": null, "fruit_count": {}}],
+                    "pet": null, "fruit_count": {}}})");
+            const deserializer dser{ test_obj };
+
+            WHEN("the malformed object is deserialized")
+            {
+                Person bad_val{};
+                REQUIRE_THROWS_AS(dser.as_object("bad", bad_val), deserialization_error);
+
+                AND_WHEN("the well-formed object is deserialized with the same deserializer")
+                {
+                    Person good_val{};
+                    REQUIRE_NOTHROW(dser.as_object("good", good_val));
+
+                    THEN("every level of the object is resolved")
+                    {
+                        REQUIRE_EQ(good_val.friends.size(), 1);
+                        REQUIRE_EQ(good_val.friends[0].friends.size(), 1);
+                        CHECK_EQ(good_val.friends[0].name, "B");
+                        CHECK_EQ(good_val.friends[0].friends[0].age, 3);
+                        CHECK_EQ(good_val.friends[0].friends[0].name, "C");
+                    }
+                }
+            }
+        }
+    }
+
+    SCENARIO("try_deserialize reports errors without throwing")
+    {
+        using json_serializer = easy_serializer<json_adapter>;
+
+        GIVEN("a well-formed Person")
+        {
+            const Person expected_val{ 30, "Alice", { Person{ 29, "Bob", {}, {}, {} } }, {}, {} };
+            const auto test_obj = json_serializer::quick_serialize(expected_val);
+
+            WHEN("the object is deserialized with try_deserialize")
+            {
+                Person test_val{};
+                const auto result = json_serializer::try_deserialize(test_obj, test_val);
+
+                THEN("the result is ok and the value is filled")
+                {
+                    CHECK(static_cast<bool>(result));
+                    CHECK_EQ(result.code, deserialization_errc::ok);
+                    CHECK(result.path.empty());
+                    CHECK_EQ(test_val, expected_val);
+                }
+            }
+        }
+
+        GIVEN("a Person whose friend's name is a number")
+        {
+            auto test_obj = json_serializer::quick_serialize(
+                Person{ 30, "Alice", { Person{ 29, "Bob", {}, {}, {} } }, {}, {} });
+            test_obj["friends"][0]["name"] = 5;
+
+            WHEN("the object is deserialized with try_deserialize")
+            {
+                Person test_val{};
+                deserialization_result result{};
+                REQUIRE_NOTHROW(result = json_serializer::try_deserialize(test_obj, test_val));
+
+                THEN("the result holds the error and the path of the value")
+                {
+                    CHECK_FALSE(static_cast<bool>(result));
+                    CHECK_EQ(result.code, deserialization_errc::type_mismatch);
+                    CHECK_EQ(result.path, "/friends/0/name");
+                    CHECK_FALSE(result.message.empty());
+                }
+            }
+        }
+
+        GIVEN("an Employee missing its name, with keys resolved through its field table")
+        {
+            const auto test_obj = nlohmann::json::parse(R"({"id": 4, "pet": null, "roles": []})");
+
+            WHEN("the object is deserialized with try_deserialize")
+            {
+                Employee test_val{};
+                const auto result = json_serializer::try_deserialize(test_obj, test_val);
+
+                THEN("the missing key is reported")
+                {
+                    CHECK_EQ(result.code, deserialization_errc::missing_key);
+                    CHECK_EQ(result.path, "/name");
+                    CHECK_EQ(test_val.id, 4);
+                }
+            }
+        }
+
+        GIVEN("a map whose value under one key is malformed")
+        {
+            const auto test_obj = nlohmann::json::parse(R"({"a": [1, 2], "b": [3, "4"]})");
+
+            WHEN("the object is deserialized with try_deserialize")
+            {
+                std::map<std::string, std::vector<int>> test_val{};
+                const auto result = json_serializer::try_deserialize(test_obj, test_val);
+
+                THEN("the path includes the key and the index of the element")
+                {
+                    CHECK_EQ(result.code, deserialization_errc::type_mismatch);
+                    CHECK_EQ(result.path, "/b/1");
+                }
+            }
+        }
+
+        GIVEN("a Shape with an unknown tag")
+        {
+            const auto bad_obj = nlohmann::json::parse(R"({"Hexagon": {"side": 2}})");
+            const auto good_obj = nlohmann::json::parse(R"({"Circle": {"radius": 1.5}})");
+
+            Shape test_val{};
+            deserializer bad_dser{ bad_obj };
+            const auto bad_result = bad_dser.try_deserialize_object(test_val);
+
+            THEN("the unknown tag is reported")
+            {
+                CHECK_EQ(bad_result.code, deserialization_errc::invalid_value);
+            }
+
+            AND_THEN("the same API still throws outside of try_deserialize")
+            {
+                CHECK_THROWS_AS(bad_dser.deserialize_object(test_val), deserialization_error);
+            }
+
+            AND_THEN("a well-formed Shape deserializes")
+            {
+                deserializer good_dser{ good_obj };
+                CHECK(static_cast<bool>(good_dser.try_deserialize_object(test_val)));
+                CHECK(std::get<Circle>(test_val) == Circle{ 1.5 });
+            }
+        }
+    }
+
+    SCENARIO("large arrays can be deserialized in parallel")
+    {
+        const parallel_options options{ 4, 100 };
+        const auto expected_val = create_people(1001);
+        auto test_obj = easy_serializer<json_adapter>::quick_serialize(expected_val);
+
+        GIVEN("an array of objects large enough to split between threads")
+        {
+            THEN("a vector is filled as it is on one thread")
+            {
+                std::vector<Person> test_val{ Person{} };
+                deserialize_parallel<json_adapter>(test_obj, test_val, options);
+                CHECK_EQ(test_val, expected_val);
+            }
+
+            THEN("a deque is filled as it is on one thread")
+            {
+                std::deque<Person> test_val{};
+                deserialize_parallel<json_adapter>(test_obj, test_val, options);
+                CHECK(std::equal(
+                    test_val.begin(), test_val.end(), expected_val.begin(), expected_val.end()));
+            }
+        }
+
+        GIVEN("an array with invalid elements in more than one slice")
+        {
+            test_obj[300]["age"] = "thirty";
+            test_obj[900]["name"] = 5;
+
+            const auto error_of = [](auto&& deserialize) -> std::string
+            {
+                try
+                {
+                    deserialize();
+                }
+                catch (const deserialization_error& ex)
+                {
+                    return ex.what();
+                }
+
+                return {};
+            };
+
+            THEN("the error from the earliest element is thrown, as on one thread")
+            {
+                std::vector<Person> test_val{};
+
+                const auto parallel_error = error_of(
+                    [&] { deserialize_parallel<json_adapter>(test_obj, test_val, options); });
+                const auto sequential_error = error_of(
+                    [&] { easy_serializer<json_adapter>::quick_deserialize(test_obj, test_val); });
+
+                CHECK_FALSE(parallel_error.empty());
+                CHECK_EQ(parallel_error, sequential_error);
+            }
+        }
+
+        GIVEN("a value that is not an array")
+        {
+            THEN("it is reported as on one thread")
+            {
+                std::vector<Person> test_val{};
+                CHECK_THROWS_AS(
+                    deserialize_parallel<json_adapter>(nlohmann::json{ { "age", 1 } }, test_val,
+                        options),
+                    deserialization_error);
+            }
+        }
+    }
+
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+    SCENARIO("a user-defined allocator-aware class can be deserialized into a memory_resource")
+    {
+        GIVEN("a deserializer with a JSON object and a monotonic arena")
+        {
+            const auto test_obj = nlohmann::json::parse(R"({
+                "name": "The Long-Winded Society of Roster Keepers",
+                "members": ["Bartholomew Jenkins-Smythe", "Maximilian Featherstonehaugh"],
+                "fruit_count": {}})");
+
+            std::pmr::monotonic_buffer_resource arena{};
+            deserializer dser{ test_obj };
+            dser.set_memory_resource(&arena);
+
+            WHEN("the class is deserialized")
+            {
+                Roster test_val{ &arena };
+                REQUIRE_NOTHROW(dser.deserialize_object(test_val));
+
+                THEN("the class and all of its members allocate from the arena")
+                {
+                    CHECK_EQ(test_val.members.size(), 2);
+                    CHECK_EQ(test_val.members[1], "Maximilian Featherstonehaugh");
+                    CHECK(uses_resource(test_val, &arena));
+                }
+            }
+        }
+    }
+#endif
 }
 } //namespace extenser::tests
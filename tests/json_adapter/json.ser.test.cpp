@@ -12,6 +12,7 @@
 #endif
 
 #include "extenser/json_adapter/extenser_json.hpp"
+#include "extenser/stream.hpp"
 #include "test_helpers.hpp"
 
 #define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
@@ -21,12 +22,14 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <deque>
 #include <forward_list>
 #include <limits>
 #include <list>
 #include <optional>
 #include <set>
+#include <sstream>
 #include <string>
 #include <type_traits>
 #include <unordered_set>
@@ -731,6 +734,30 @@ TEST_SUITE("json::serializer")
                 }
             }
 
+            WHEN("a std::map with negative and extreme keys is serialized")
+            {
+                const std::map<std::int64_t, int> test_val{
+                    { (std::numeric_limits<std::int64_t>::min)(), 1 }, { -7, 2 },
+                    { (std::numeric_limits<std::int64_t>::max)(), 3 }
+                };
+
+                REQUIRE_NOTHROW(ser.as_map("", test_val));
+
+                THEN("each key is written as '@' followed by its JSON number")
+                {
+                    REQUIRE(obj.is_object());
+                    CHECK_EQ(obj.size(), test_val.size());
+
+                    for (const auto& [k, v] : test_val)
+                    {
+                        const auto key_str = "@" + nlohmann::json(k).dump();
+
+                        REQUIRE(obj.contains(key_str));
+                        CHECK_EQ(obj[key_str].get<int>(), v);
+                    }
+                }
+            }
+
             WHEN("a std::unordered_map is serialized")
             {
                 const std::unordered_map<std::string, Person> test_val{
@@ -834,6 +861,7 @@ TEST_SUITE("json::serializer")
                             const auto& val_obj = obj[key_str];
 
                             REQUIRE(val_obj.is_array());
+                            CHECK_EQ(val_obj.size(), test_val.count(k));
                             const auto find_it = std::find(val_obj.cbegin(), val_obj.cend(), v);
                             CHECK_NE(find_it, val_obj.cend());
                         }
@@ -864,6 +892,7 @@ TEST_SUITE("json::serializer")
                             const auto& val_obj = obj.at(k);
 
                             REQUIRE(val_obj.is_array());
+                            CHECK_EQ(val_obj.size(), test_val.count(k));
                             const auto find_it = std::find(val_obj.cbegin(), val_obj.cend(), v);
                             CHECK_NE(find_it, val_obj.cend());
                         }
@@ -1199,6 +1228,31 @@ TEST_SUITE("json::serializer")
         }
     }
 
+    SCENARIO("a tagged variant is serialized as an object keyed by its tag")
+    {
+        GIVEN("a default-init serializer")
+        {
+            serializer ser{};
+            const auto& obj = ser.object();
+
+            WHEN("a Shape holding a Rect is serialized")
+            {
+                const Shape test_val{ Rect{ 3, 4 } };
+
+                REQUIRE_NOTHROW(ser.as_variant("", test_val));
+
+                THEN("the object has a single member named by the Rect tag")
+                {
+                    REQUIRE(obj.is_object());
+                    REQUIRE_EQ(obj.size(), 1U);
+                    REQUIRE(obj.contains("Rect"));
+                    CHECK_EQ(obj["Rect"]["width"].get<int>(), 3);
+                    CHECK_EQ(obj["Rect"]["height"].get<int>(), 4);
+                }
+            }
+        }
+    }
+
     SCENARIO("a user-defined class can be serialized to JSON")
     {
         GIVEN("a default-init serializer")
@@ -1462,5 +1516,46 @@ TEST_SUITE("json::serializer")
             }
         }
     }
+
+    SCENARIO("values can be written to and read from streams as JSON text")
+    {
+        GIVEN("an array of objects")
+        {
+            const auto people = create_people(100);
+            const auto obj = easy_serializer<json_adapter>::quick_serialize(people);
+
+            THEN("the whole document is written as text")
+            {
+                std::ostringstream out{};
+                serialize_to<json_adapter>(out, people);
+                CHECK(out.str() == obj.dump());
+            }
+
+            THEN("it round trips through a FILE*")
+            {
+                std::FILE* const p_file = std::tmpfile();
+                REQUIRE(p_file != nullptr);
+
+                serialize_to<json_adapter>(p_file, people, stream_options{ 64 });
+                std::rewind(p_file);
+
+                std::vector<Person> test_val{};
+                deserialize_from<json_adapter>(p_file, test_val, stream_options{ 64 });
+                std::fclose(p_file);
+
+                CHECK(test_val == people);
+            }
+
+            THEN("it round trips through a std::stringstream")
+            {
+                std::stringstream stream{};
+                serialize_to<json_adapter>(stream, people);
+
+                std::vector<Person> test_val{};
+                deserialize_from<json_adapter>(stream, test_val);
+                CHECK(test_val == people);
+            }
+        }
+    }
 }
 } //namespace extenser::tests
@@ -0,0 +1,777 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#if defined(EXTENSER_USE_MAGIC_ENUM) && !defined(EXTENSER_USE_MAGIC_ENUM_TEST)
+#  undef EXTENSER_USE_MAGIC_ENUM
+#endif
+
+#include "extenser/json_adapter/extenser_json.hpp"
+#include "extenser/json_adapter/extenser_json_text.hpp"
+#include "extenser/stream.hpp"
+#include "test_helpers.hpp"
+
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace extenser::tests
+{
+namespace
+{
+    // The text serializer must produce the same document json_adapter builds
+    template<typename T>
+    auto matches_dom(const T& val) -> bool
+    {
+        const auto text = easy_serializer<json_text_adapter>::quick_serialize(val);
+        const auto dom = easy_serializer<json_adapter>::quick_serialize(val);
+
+        return nlohmann::json::parse(text) == dom;
+    }
+
+    template<typename T>
+    auto round_trips(const T& val) -> bool
+    {
+        const auto text = easy_serializer<json_text_adapter>::quick_serialize(val);
+
+        return easy_serializer<json_text_adapter>::quick_deserialize<T>(text) == val;
+    }
+
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+    // Makes any allocation from the default memory_resource throw while in scope
+    class null_default_resource
+    {
+    public:
+        null_default_resource() noexcept
+            : m_p_previous(std::pmr::set_default_resource(std::pmr::null_memory_resource()))
+        {
+        }
+
+        ~null_default_resource() noexcept { std::pmr::set_default_resource(m_p_previous); }
+
+        null_default_resource(const null_default_resource&) = delete;
+        null_default_resource(null_default_resource&&) = delete;
+        auto operator=(const null_default_resource&) -> null_default_resource& = delete;
+        auto operator=(null_default_resource&&) -> null_default_resource& = delete;
+
+    private:
+        std::pmr::memory_resource* m_p_previous;
+    };
+#endif
+} //namespace
+
+#if defined(EXTENSER_USE_MAGIC_ENUM_TEST)
+TEST_SUITE("json_text::serializer (magic_enum)")
+#else
+TEST_SUITE("json_text::serializer")
+#endif
+{
+    using serializer = json_text_adapter::serializer_t;
+
+    SCENARIO("scalars are written directly as JSON text")
+    {
+        GIVEN("a default-init serializer")
+        {
+            serializer ser{};
+            const auto& text = ser.object();
+
+            REQUIRE(text.empty());
+
+            WHEN("an int is serialized")
+            {
+                ser.as_int("", -42);
+
+                THEN("the text holds the number")
+                {
+                    CHECK_EQ(text, "-42");
+                }
+            }
+
+            WHEN("a uint64 is serialized")
+            {
+                ser.as_uint("", std::numeric_limits<std::uint64_t>::max());
+
+                THEN("the text holds the full value")
+                {
+                    CHECK_EQ(text, "18446744073709551615");
+                }
+            }
+
+            WHEN("a bool is serialized")
+            {
+                ser.as_bool("", true);
+
+                THEN("the text holds a JSON boolean")
+                {
+                    CHECK_EQ(text, "true");
+                }
+            }
+
+            WHEN("an integral float is serialized")
+            {
+                ser.as_float("", 2.0);
+
+                THEN("the text keeps the value typed as a float")
+                {
+                    CHECK_EQ(text, "2.0");
+                    CHECK(nlohmann::json::parse(text).is_number_float());
+                }
+            }
+
+            WHEN("a fractional float is serialized")
+            {
+                static constexpr double test_val = 0.1;
+                ser.as_float("", test_val);
+
+                THEN("the value round-trips exactly")
+                {
+                    CHECK_EQ(nlohmann::json::parse(text).get<double>(), test_val);
+                }
+            }
+
+            WHEN("NaN is serialized")
+            {
+                ser.as_float("", std::numeric_limits<double>::quiet_NaN());
+
+                THEN("the text holds null, as nlohmann::json::dump() writes")
+                {
+                    CHECK_EQ(text, "null");
+                }
+            }
+
+            WHEN("two unkeyed values are serialized")
+            {
+                ser.as_int("", 1);
+                ser.as_int("", 2);
+
+                THEN("the second replaces the first")
+                {
+                    CHECK_EQ(text, "2");
+                }
+            }
+        }
+    }
+
+    SCENARIO("strings are escaped when written")
+    {
+        GIVEN("a string with quotes, backslashes and control characters")
+        {
+            const std::string test_val = "say \"hi\"\\\n\t\x01 done";
+
+            WHEN("the string is serialized")
+            {
+                const auto text = easy_serializer<json_text_adapter>::quick_serialize(test_val);
+
+                THEN("the text is valid JSON holding the original string")
+                {
+                    CHECK_EQ(text, R"("say \"hi\"\\\n\t\u0001 done")");
+                    CHECK_EQ(nlohmann::json::parse(text).get<std::string>(), test_val);
+                }
+            }
+        }
+    }
+
+    SCENARIO("keyed values are written as a complete JSON object")
+    {
+        GIVEN("a default-init serializer")
+        {
+            serializer ser{};
+            const auto& text = ser.object();
+
+            WHEN("keyed values are serialized directly")
+            {
+                ser.as_int("a", 1);
+                ser.as_string("b", std::string{ "two" });
+
+                THEN("the object is closed after every field")
+                {
+                    CHECK_EQ(text, R"({"a":1,"b":"two"})");
+                }
+
+                AND_WHEN("an unkeyed value is then serialized")
+                {
+                    ser.as_null("");
+
+                    THEN("it replaces the object")
+                    {
+                        CHECK_EQ(text, "null");
+                    }
+                }
+            }
+
+            WHEN("a keyed value follows an unkeyed value")
+            {
+                ser.as_int("", 1);
+
+                THEN("a serialization_error is thrown")
+                {
+                    CHECK_THROWS_AS(ser.as_int("a", 2), serialization_error);
+                }
+            }
+        }
+    }
+
+    SCENARIO("a caller-supplied string can be used as the output buffer")
+    {
+        GIVEN("a string and a serializer writing to it")
+        {
+            std::string out = "stale contents";
+            serializer ser{ std::ref(out) };
+
+            REQUIRE(out.empty());
+
+            WHEN("two objects are serialized in turn")
+            {
+                ser.serialize_object(Foo{ 12 });
+                ser.serialize_object(Foo{ 13 });
+
+                THEN("the buffer holds only the last object")
+                {
+                    CHECK_EQ(out, R"({"num":13})");
+                    CHECK_EQ(&ser.object(), &out);
+                }
+            }
+        }
+    }
+
+    SCENARIO("the text serializer produces the same document as json_adapter")
+    {
+        GIVEN("containers of scalars")
+        {
+            CHECK(matches_dom(std::vector<int>{ 1, 2, 3, 4, 5 }));
+            CHECK(matches_dom(std::vector<double>{ 0.5, -1.25, 3.0 }));
+            CHECK_EQ(easy_serializer<json_text_adapter>::quick_serialize(std::vector<int>{}), "[]");
+            CHECK(matches_dom(std::wstring{ L"wide" }));
+        }
+
+        GIVEN("maps with string and non-string keys")
+        {
+            CHECK(matches_dom(std::map<std::string, int>{ { "one", 1 }, { "@two", 2 } }));
+            CHECK(matches_dom(std::map<int, std::string>{ { -1, "neg" }, { 7, "seven" } }));
+            CHECK(matches_dom(std::map<std::pair<int, int>, bool>{ { { 1, 2 }, true } }));
+            CHECK(matches_dom(std::unordered_map<Fruit, int>{ { Fruit::Apple, 3 } }));
+            CHECK(matches_dom(std::map<std::string, std::map<int, double>>{
+                { "a", { { 1, 1.5 } } }, { "b", {} } }));
+        }
+
+        GIVEN("a multimap")
+        {
+            const std::multimap<std::string, int> test_val{ { "a", 1 }, { "b", 2 }, { "a", 3 },
+                { "c", 4 }, { "a", 5 } };
+
+            CHECK(matches_dom(test_val));
+        }
+
+        GIVEN("tuples, optionals and variants")
+        {
+            CHECK(matches_dom(std::make_tuple(1, std::string{ "two" }, 3.5)));
+            CHECK(matches_dom(std::optional<int>{}));
+            CHECK(matches_dom(
+                std::variant<int, std::string, Pet>{ Pet{ "Sam", Pet::Species::Cat } }));
+            CHECK(matches_dom(Shape{ Rect{ 3, 4 } }));
+        }
+
+        GIVEN("user-defined types")
+        {
+            CHECK(matches_dom(Bar{ 22 }));
+            CHECK(matches_dom(create_test_val<std::list<Person>>()));
+        }
+    }
+
+    SCENARIO("text written by the text serializer can be deserialized")
+    {
+        GIVEN("a list of people")
+        {
+            const auto test_val = create_test_val<std::list<Person>>();
+
+            WHEN("the list is round-tripped through json_text_adapter")
+            {
+                easy_serializer<json_text_adapter> ser{};
+                ser.serialize_object(test_val);
+
+                const auto out_val = ser.deserialize_object<std::list<Person>>();
+
+                THEN("the values are equal")
+                {
+                    CHECK_EQ(out_val, test_val);
+                }
+            }
+        }
+    }
+}
+#if defined(EXTENSER_USE_MAGIC_ENUM_TEST)
+TEST_SUITE("json_text::deserializer (magic_enum)")
+#else
+TEST_SUITE("json_text::deserializer")
+#endif
+{
+    using deserializer = json_text_adapter::deserializer_t;
+
+    // The text is read in place, so a temporary string would dangle
+    static_assert(!std::is_constructible_v<deserializer, std::string&&>);
+    static_assert(std::is_constructible_v<deserializer, const std::string&>);
+
+    SCENARIO("scalars are parsed directly from JSON text")
+    {
+        GIVEN("text holding scalars")
+        {
+            WHEN("an int is deserialized")
+            {
+                int test_val{};
+                deserializer des{ " -42 " };
+                des.as_int("", test_val);
+
+                THEN("the value is parsed")
+                {
+                    CHECK_EQ(test_val, -42);
+                }
+            }
+
+            WHEN("a float is deserialized")
+            {
+                double test_val{};
+                deserializer des{ "1.5e3" };
+                des.as_float("", test_val);
+
+                THEN("the value is parsed")
+                {
+                    CHECK_EQ(test_val, 1500.0);
+                }
+            }
+
+            WHEN("null is deserialized as a float")
+            {
+                double test_val{};
+                deserializer des{ "null" };
+                des.as_float("", test_val);
+
+                THEN("the value is NaN, as the serializer writes it")
+                {
+                    CHECK_NE(test_val, test_val);
+                }
+            }
+
+            WHEN("an out of range int is deserialized")
+            {
+                std::uint8_t test_val{};
+                deserializer des{ "256" };
+
+                THEN("a deserialization_error is thrown")
+                {
+                    CHECK_THROWS_AS(des.as_uint("", test_val), deserialization_error);
+                }
+            }
+
+            WHEN("a float is deserialized as an int")
+            {
+                int test_val{};
+                deserializer des{ "1.5" };
+
+                THEN("a deserialization_error is thrown")
+                {
+                    CHECK_THROWS_AS(des.as_int("", test_val), deserialization_error);
+                }
+            }
+
+            WHEN("an int is deserialized as a float")
+            {
+                double test_val{};
+                std::vector<double> test_vec{};
+                deserializer des{ "[2]" };
+                des.as_array("", test_vec);
+
+                THEN("the value is converted, as with json_adapter")
+                {
+                    REQUIRE_NOTHROW(deserializer{ "2" }.as_float("", test_val));
+                    CHECK_EQ(test_val, 2.0);
+                    CHECK_EQ(test_vec, std::vector<double>{ 2.0 });
+                    CHECK_EQ(easy_serializer<json_adapter>::quick_deserialize<std::vector<double>>(
+                                 nlohmann::json::parse("[2]")),
+                        test_vec);
+                }
+            }
+
+            WHEN("numbers outside the JSON grammar are deserialized")
+            {
+                int int_val{};
+                double float_val{};
+
+                THEN("a deserialization_error is thrown")
+                {
+                    CHECK_THROWS_AS(deserializer{ "007" }.as_int("", int_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ "-01" }.as_int("", int_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ "+1" }.as_int("", int_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ "1." }.as_float("", float_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ "-.5" }.as_float("", float_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ ".5" }.as_float("", float_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ "00.5" }.as_float("", float_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ "1e" }.as_float("", float_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ "-inf" }.as_float("", float_val),
+                        deserialization_error);
+                    CHECK_THROWS_AS(deserializer{ "-nan" }.as_float("", float_val),
+                        deserialization_error);
+                }
+            }
+        }
+    }
+
+    SCENARIO("strings are unescaped when parsed")
+    {
+        GIVEN("text holding escapes and unicode code points")
+        {
+            const std::string text = R"({"s":"say \"hi\"\\\n\t\u0001 é😀\/"})";
+
+            WHEN("the string is deserialized")
+            {
+                std::string test_val{};
+                deserializer des{ text };
+                des.as_string("s", test_val);
+
+                THEN("the original string is restored as UTF-8")
+                {
+                    CHECK_EQ(test_val, "say \"hi\"\\\n\t\x01 \xC3\xA9\xF0\x9F\x98\x80/");
+                }
+            }
+        }
+    }
+
+    SCENARIO("object members are matched in any order")
+    {
+        GIVEN("text with members in a different order than they are read")
+        {
+            const std::string text =
+                R"({ "z" : [1, {"a": "}"}], "b" : "two", "a" : 1, "ignored": {"x": [null]} })";
+
+            WHEN("the members are deserialized")
+            {
+                int val_a{};
+                std::string val_b{};
+                deserializer des{ text };
+                des.as_int("a", val_a);
+                des.as_string("b", val_b);
+
+                THEN("each key finds its value")
+                {
+                    CHECK_EQ(val_a, 1);
+                    CHECK_EQ(val_b, "two");
+                }
+            }
+
+            WHEN("a missing key is deserialized")
+            {
+                int test_val{};
+                deserializer des{ text };
+
+                THEN("a deserialization_error is thrown")
+                {
+                    CHECK_THROWS_AS(des.as_int("missing", test_val), deserialization_error);
+                }
+            }
+        }
+
+        GIVEN("text dumped from a json_adapter document, whose keys are sorted")
+        {
+            const auto test_val = create_test_val<std::list<Person>>();
+            const auto text = easy_serializer<json_adapter>::quick_serialize(test_val).dump();
+
+            WHEN("the text is deserialized")
+            {
+                std::list<Person> out_val{};
+                deserializer des{ text };
+                des.deserialize_object(out_val);
+
+                THEN("the values are equal")
+                {
+                    CHECK_EQ(out_val, test_val);
+                }
+            }
+        }
+    }
+
+    SCENARIO("containers and wrappers are parsed as json_adapter writes them")
+    {
+        GIVEN("maps with non-string keys")
+        {
+            const std::map<std::pair<int, int>, std::string> test_val{ { { 1, 2 }, "a" },
+                { { -3, 4 }, "b" } };
+            const std::map<std::string, int> escaped_val{ { "@at", 1 }, { "plain", 2 } };
+
+            CHECK(round_trips(test_val));
+            CHECK(round_trips(escaped_val));
+        }
+
+        GIVEN("a multimap")
+        {
+            const std::multimap<int, std::string> test_val{ { 1, "a" }, { 2, "b" }, { 1, "c" } };
+
+            CHECK(round_trips(test_val));
+        }
+
+        GIVEN("tuples, optionals and variants")
+        {
+            using text_serializer = easy_serializer<json_text_adapter>;
+            using variant_t = std::variant<int, std::string, Pet>;
+
+            const auto tuple_val = std::make_tuple(1, std::string{ "two" }, 3.5);
+            const variant_t variant_val{ std::string{ "Sam" } };
+            const auto variant_text = R"({"v_val":"Sam","v_idx":1})";
+
+            CHECK(round_trips(tuple_val));
+            CHECK(round_trips(std::optional<int>{}));
+            CHECK_EQ(text_serializer::quick_deserialize<variant_t>(variant_text), variant_val);
+            CHECK(round_trips(variant_t{ Pet{ "Sam", Pet::Species::Cat } }));
+            CHECK_THROWS_AS(
+                text_serializer::quick_deserialize<variant_t>(R"({"v_idx":3,"v_val":1})"),
+                deserialization_error);
+        }
+
+        GIVEN("tagged variants")
+        {
+            using text_serializer = easy_serializer<json_text_adapter>;
+            using reordered_t = std::variant<Rect, Circle>;
+
+            const reordered_t rect_val{ Rect{ 3, 4 } };
+
+            CHECK(round_trips(Shape{ Circle{ 1.5 } }));
+            CHECK(round_trips(Shape{ Rect{ 3, 4 } }));
+            CHECK_EQ(text_serializer::quick_deserialize<reordered_t>(
+                         R"({ "Rect" : {"height":4,"width":3} })"),
+                rect_val);
+            CHECK_EQ(text_serializer::quick_deserialize<reordered_t>(
+                         R"({"R\u0065ct":{"width":3,"height":4}})"),
+                rect_val);
+            CHECK_THROWS_AS(
+                text_serializer::quick_deserialize<Shape>(R"({"Hexagon":{"side":2}})"),
+                deserialization_error);
+            CHECK_THROWS_AS(text_serializer::quick_deserialize<Shape>(
+                                R"({"Circle":{"radius":1},"Rect":{"width":3,"height":4}})"),
+                deserialization_error);
+            CHECK_THROWS_AS(
+                text_serializer::quick_deserialize<Shape>("{}"), deserialization_error);
+        }
+
+        GIVEN("a fixed-size array")
+        {
+            std::array<int, 3> test_val{};
+
+            WHEN("the text holds the wrong number of elements")
+            {
+                deserializer des{ "[1,2]" };
+
+                THEN("a deserialization_error is thrown")
+                {
+                    CHECK_THROWS_AS(des.as_array("", test_val), deserialization_error);
+                }
+            }
+        }
+    }
+
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+    SCENARIO("allocator-aware values are built in the deserializer's memory_resource")
+    {
+        GIVEN("a monotonic arena, with the default resource unable to allocate")
+        {
+            using text_serializer = easy_serializer<json_text_adapter>;
+
+            Roster test_val{};
+            test_val.name = "The Long-Winded Society of Roster Keepers";
+            test_val.members = { "Bartholomew Jenkins-Smythe", "Maximilian Featherstonehaugh" };
+            test_val.fruit_count = { { Fruit::Apple, 3 }, { Fruit::Mango, 12 } };
+
+            const auto text = text_serializer::quick_serialize(test_val);
+
+            std::array<std::byte, 4096> buffer{};
+            std::pmr::monotonic_buffer_resource arena{ buffer.data(), buffer.size(),
+                std::pmr::null_memory_resource() };
+            const null_default_resource no_default{};
+
+            WHEN("quick_deserialize() is given the arena")
+            {
+                const auto out_val = text_serializer::quick_deserialize<Roster>(text, &arena);
+
+                THEN("the value and all of its members allocate from it")
+                {
+                    CHECK_EQ(out_val, test_val);
+                    CHECK(uses_resource(out_val, &arena));
+                }
+            }
+
+            WHEN("a deserializer is given the arena")
+            {
+                Roster out_val{ &arena };
+                deserializer des{ text };
+                des.set_memory_resource(&arena);
+                des.deserialize_object(out_val);
+
+                THEN("the values it creates allocate from it")
+                {
+                    CHECK_EQ(des.memory_resource(), &arena);
+                    CHECK_EQ(out_val, test_val);
+                    CHECK(uses_resource(out_val, &arena));
+                }
+            }
+        }
+    }
+#endif
+
+    SCENARIO("malformed text is rejected")
+    {
+        GIVEN("text with trailing characters")
+        {
+            std::vector<int> test_val{};
+            deserializer des{ "[1,2] 3" };
+
+            CHECK_THROWS_AS(des.deserialize_object(test_val), deserialization_error);
+        }
+
+        GIVEN("truncated text")
+        {
+            Foo test_val{ 0 };
+            deserializer des{ R"({"num":)" };
+
+            CHECK_THROWS_AS(des.deserialize_object(test_val), deserialization_error);
+        }
+
+        GIVEN("a value of the wrong type")
+        {
+            std::vector<int> test_val{};
+            deserializer des{ R"({"a":1})" };
+
+            CHECK_THROWS_AS(des.deserialize_object(test_val), deserialization_error);
+        }
+
+        GIVEN("a well-formed member that is skipped")
+        {
+            Foo test_val{ 0 };
+            deserializer des{
+                R"({"x":{"a":[1,-2.5e+3,0.5,"s\"\u00e9]",true,null,{}],"b" : [ ]},"num":3})"
+            };
+
+            des.deserialize_object(test_val);
+            CHECK_EQ(test_val.num(), 3);
+        }
+
+        GIVEN("malformed members that are skipped")
+        {
+            const std::array<const char*, 11> inputs{
+                R"({"x":[1 2 } junk ],"num":1})",
+                R"({"x":[1,2},"num":1})",
+                R"({"x":{"a":1],"num":1})",
+                R"({"x":[1,],"num":1})",
+                R"({"x":{"a" 1},"num":1})",
+                R"({"x":{1:2},"num":1})",
+                R"({"x":{"a":1,},"num":1})",
+                R"({"x":[01],"num":1})",
+                R"({"x":[1.e5],"num":1})",
+                R"({"x":["\q"],"num":1})",
+                R"({"x":[[1],"num":1})",
+            };
+
+            for (const auto* const input : inputs)
+            {
+                Foo test_val{ 0 };
+                deserializer des{ input };
+
+                CHECK_THROWS_AS(des.deserialize_object(test_val), deserialization_error);
+            }
+        }
+    }
+
+    // The cases shared with the other adapters are in tests/adapters.test.cpp
+    SCENARIO("JSON text-specific input can be read from streams")
+    {
+        GIVEN("text with whitespace, escapes and numbers split across reads")
+        {
+            std::istringstream in{ " \n[ \"a\" ,\"b\\\"]\",  \"c\" ]\n " };
+            std::istringstream numbers{ "[1,22,333,null,4444]" };
+            std::istringstream empty{ " [ ] " };
+
+            THEN("every element is read")
+            {
+                std::vector<std::string> test_val{};
+                deserialize_from<json_text_adapter>(in, test_val, stream_options{ 1 });
+                CHECK(test_val == std::vector<std::string>{ "a", "b\"]", "c" });
+
+                std::vector<std::optional<int>> test_num{};
+                deserialize_from<json_text_adapter>(numbers, test_num, stream_options{ 1 });
+                CHECK(test_num
+                    == std::vector<std::optional<int>>{ 1, 22, 333, std::nullopt, 4444 });
+
+                test_val = { "x" };
+                deserialize_from<json_text_adapter>(empty, test_val, stream_options{ 1 });
+                CHECK(test_val.empty());
+            }
+        }
+
+        GIVEN("malformed text")
+        {
+            std::vector<std::string> test_val{};
+
+            THEN("deserialization throws")
+            {
+                std::istringstream trailing{ R"(["a"] "b")" };
+                CHECK_THROWS_AS(deserialize_from<json_text_adapter>(trailing, test_val),
+                    deserialization_error);
+
+                std::istringstream missing_comma{ R"(["a" "b"])" };
+                CHECK_THROWS_AS(deserialize_from<json_text_adapter>(missing_comma, test_val),
+                    deserialization_error);
+
+                std::istringstream unterminated{ R"(["a", "b")" };
+                CHECK_THROWS_AS(deserialize_from<json_text_adapter>(unterminated, test_val),
+                    deserialization_error);
+
+                std::istringstream not_array{ R"({"a":1})" };
+                CHECK_THROWS_AS(deserialize_from<json_text_adapter>(not_array, test_val),
+                    deserialization_error);
+            }
+
+            THEN("an invalid element fails without reading the rest of the text")
+            {
+                std::string text{ "[x" };
+
+                for (int i = 0; i < 1000; ++i)
+                {
+                    text.append(R"(, "a")");
+                }
+
+                text.push_back(']');
+                std::istringstream in{ text };
+                CHECK_THROWS_AS(
+                    deserialize_from<json_text_adapter>(in, test_val, stream_options{ 16 }),
+                    deserialization_error);
+                CHECK_FALSE(in.eof());
+            }
+        }
+    }
+}
+} //namespace extenser::tests
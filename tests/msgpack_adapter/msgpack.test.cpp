@@ -0,0 +1,697 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+#include "extenser/msgpack_adapter/extenser_msgpack.hpp"
+#include "extenser/parallel.hpp"
+#include "extenser/stream.hpp"
+#include "test_helpers.hpp"
+
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace extenser::tests
+{
+namespace
+{
+    using bytes = std::vector<std::uint8_t>;
+
+    template<typename T>
+    auto round_trips(const T& val) -> bool
+    {
+        const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(val);
+
+        return easy_serializer<msgpack_adapter>::quick_deserialize<T>(serial) == val;
+    }
+
+    // Appends a MessagePack fixstr
+    void put_str(bytes& out, const std::string_view str)
+    {
+        out.push_back(static_cast<std::uint8_t>(0xA0U | str.size()));
+        out.insert(out.end(), str.begin(), str.end());
+    }
+} //namespace
+
+TEST_SUITE("msgpack::serializer")
+{
+    using serializer = msgpack_adapter::serializer_t;
+
+    SCENARIO("scalars are written in their smallest MessagePack format")
+    {
+        GIVEN("a default-init serializer")
+        {
+            serializer ser{};
+            const auto& serial = ser.object();
+
+            REQUIRE(serial.empty());
+
+            WHEN("a small positive int is serialized")
+            {
+                ser.as_int("", 42);
+
+                THEN("it is written as a positive fixint")
+                {
+                    CHECK_EQ(serial, (bytes{ 0x2AU }));
+                }
+            }
+
+            WHEN("a negative int is serialized")
+            {
+                ser.as_int("", -42);
+
+                THEN("it is written as an int8")
+                {
+                    CHECK_EQ(serial, (bytes{ 0xD0U, 0xD6U }));
+                }
+            }
+
+            WHEN("a small negative int is serialized")
+            {
+                ser.as_int("", -1);
+
+                THEN("it is written as a negative fixint")
+                {
+                    CHECK_EQ(serial, (bytes{ 0xFFU }));
+                }
+            }
+
+            WHEN("a uint64 is serialized")
+            {
+                ser.as_uint("", std::numeric_limits<std::uint64_t>::max());
+
+                THEN("it is written as a big-endian uint64")
+                {
+                    CHECK_EQ(serial,
+                        (bytes{ 0xCFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU }));
+                }
+            }
+
+            WHEN("a uint16 sized value is serialized")
+            {
+                ser.as_uint("", 0x1234U);
+
+                THEN("it is written as a big-endian uint16")
+                {
+                    CHECK_EQ(serial, (bytes{ 0xCDU, 0x12U, 0x34U }));
+                }
+            }
+
+            WHEN("a bool is serialized")
+            {
+                ser.as_bool("", true);
+
+                THEN("it is written as true")
+                {
+                    CHECK_EQ(serial, (bytes{ 0xC3U }));
+                }
+            }
+
+            WHEN("a float is serialized")
+            {
+                ser.as_float("", 1.5F);
+
+                THEN("it is written as a float32")
+                {
+                    CHECK_EQ(serial, (bytes{ 0xCAU, 0x3FU, 0xC0U, 0x00U, 0x00U }));
+                }
+            }
+
+            WHEN("a double is serialized")
+            {
+                ser.as_float("", 1.5);
+
+                THEN("it is written as a float64")
+                {
+                    CHECK_EQ(serial,
+                        (bytes{ 0xCBU, 0x3FU, 0xF8U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U }));
+                }
+            }
+
+            WHEN("an enum is serialized")
+            {
+                ser.as_enum("", TestCode::CodeX);
+
+                THEN("it is written as its underlying integer")
+                {
+                    CHECK_EQ(serial, (bytes{ 0xCCU, 0xFFU }));
+                }
+            }
+
+            WHEN("two unkeyed values are serialized")
+            {
+                ser.as_int("", 1);
+                ser.as_int("", 2);
+
+                THEN("the second replaces the first")
+                {
+                    CHECK_EQ(serial, (bytes{ 0x02U }));
+                }
+            }
+        }
+    }
+
+    SCENARIO("strings and bytes are written with a length prefix")
+    {
+        GIVEN("a short string")
+        {
+            const std::string test_val = "abc";
+
+            WHEN("the string is serialized")
+            {
+                const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(test_val);
+
+                THEN("it is written as a fixstr")
+                {
+                    CHECK_EQ(serial, (bytes{ 0xA3U, 'a', 'b', 'c' }));
+                }
+            }
+        }
+
+        GIVEN("a string longer than 31 chars")
+        {
+            const std::string test_val(40, 'x');
+
+            WHEN("the string is serialized")
+            {
+                const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(test_val);
+
+                THEN("it is written as a str8")
+                {
+                    REQUIRE_EQ(serial.size(), 42);
+                    CHECK_EQ(serial[0], 0xD9U);
+                    CHECK_EQ(serial[1], 40);
+                }
+            }
+        }
+
+        GIVEN("a vector of bytes")
+        {
+            const bytes test_val{ 0x00U, 0x01U, 0xFFU };
+
+            WHEN("the vector is serialized")
+            {
+                const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(test_val);
+
+                THEN("it is written as a bin8")
+                {
+                    CHECK_EQ(serial, (bytes{ 0xC4U, 0x03U, 0x00U, 0x01U, 0xFFU }));
+                }
+            }
+        }
+
+        GIVEN("a vector of ints")
+        {
+            const std::vector<int> test_val{ 1, 2, 3 };
+
+            WHEN("the vector is serialized")
+            {
+                const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(test_val);
+
+                THEN("it is written as a fixarray")
+                {
+                    CHECK_EQ(serial, (bytes{ 0x93U, 0x01U, 0x02U, 0x03U }));
+                }
+            }
+        }
+    }
+
+    SCENARIO("keyed values are written as a MessagePack map")
+    {
+        GIVEN("a default-init serializer")
+        {
+            serializer ser{};
+            const auto& serial = ser.object();
+
+            WHEN("keyed values are serialized directly")
+            {
+                ser.as_int("a", 1);
+                ser.as_bool("b", false);
+
+                THEN("the map is complete after each field")
+                {
+                    bytes expected{ 0x82U };
+                    put_str(expected, "a");
+                    expected.push_back(0x01U);
+                    put_str(expected, "b");
+                    expected.push_back(0xC2U);
+
+                    CHECK_EQ(serial, expected);
+                }
+            }
+
+            WHEN("more keyed values than a fixmap holds are serialized directly")
+            {
+                const std::array<std::string_view, 16> keys{ "a", "b", "c", "d", "e", "f", "g",
+                    "h", "i", "j", "k", "l", "m", "n", "o", "p" };
+
+                for (const auto key : keys)
+                {
+                    ser.as_int(key, 1);
+                }
+
+                THEN("the header is widened to a map16")
+                {
+                    bytes expected{ 0xDEU, 0x00U, 0x10U };
+
+                    for (const auto key : keys)
+                    {
+                        put_str(expected, key);
+                        expected.push_back(0x01U);
+                    }
+
+                    CHECK_EQ(serial, expected);
+                }
+            }
+
+            WHEN("an object with few fields is serialized")
+            {
+                ser.serialize_object(Foo{ 7 });
+
+                THEN("it is written as a fixmap")
+                {
+                    bytes expected{ 0x81U };
+                    put_str(expected, "num");
+                    expected.push_back(0x07U);
+
+                    CHECK_EQ(serial, expected);
+                }
+            }
+
+            WHEN("a nested object is serialized")
+            {
+                ser.serialize_object(Bar{ 7 });
+
+                THEN("the nested object is also a fixmap")
+                {
+                    bytes expected{ 0x81U };
+                    put_str(expected, "foo");
+                    expected.push_back(0x81U);
+                    put_str(expected, "num");
+                    expected.push_back(0x07U);
+
+                    CHECK_EQ(serial, expected);
+                }
+            }
+
+            WHEN("a keyed value follows an unkeyed value")
+            {
+                ser.as_int("", 1);
+
+                THEN("serialization fails")
+                {
+                    CHECK_THROWS_AS(ser.as_int("a", 2), serialization_error);
+                }
+            }
+        }
+
+        GIVEN("a serializer writing to a caller's buffer")
+        {
+            bytes buffer{ 0x01U, 0x02U };
+            serializer ser{ std::ref(buffer) };
+
+            WHEN("an object is serialized")
+            {
+                ser.serialize_object(Foo{ 1 });
+
+                THEN("the buffer holds only the object")
+                {
+                    Foo val{ 0 };
+                    easy_serializer<msgpack_adapter>::quick_deserialize(buffer, val);
+
+                    CHECK_EQ(ser.object().data(), buffer.data());
+                    CHECK_EQ(val, Foo{ 1 });
+                }
+            }
+        }
+    }
+}
+
+TEST_SUITE("msgpack::deserializer")
+{
+    using deserializer = msgpack_adapter::deserializer_t;
+
+    // The bytes are read in place, so a temporary vector would dangle
+    static_assert(!std::is_constructible_v<deserializer, bytes&&>);
+    static_assert(std::is_constructible_v<deserializer, const bytes&>);
+
+    SCENARIO("values round-trip through MessagePack")
+    {
+        GIVEN("a Person with friends, a pet and a map")
+        {
+            Person test_val{ 30, "Alice", {}, Pet{ "Rex", Pet::Species::Dog },
+                { { Fruit::Apple, 2 }, { Fruit::Kiwi, 5 } } };
+
+            test_val.friends.push_back(Person{ 29, "Bob", {}, std::nullopt, {} });
+
+            THEN("the value round-trips")
+            {
+                CHECK(round_trips(test_val));
+            }
+        }
+
+        GIVEN("scalars at the edges of their range")
+        {
+            THEN("each value round-trips")
+            {
+                CHECK(round_trips(std::numeric_limits<std::int64_t>::min()));
+                CHECK(round_trips(std::numeric_limits<std::int64_t>::max()));
+                CHECK(round_trips(std::numeric_limits<std::uint64_t>::max()));
+                CHECK(round_trips(std::numeric_limits<std::int8_t>::min()));
+                CHECK(round_trips(-33));
+                CHECK(round_trips(0.1));
+                CHECK(round_trips(0.25F));
+                CHECK(round_trips(PlainEnum::VALUE_XX));
+            }
+        }
+
+        GIVEN("containers, tuples and variants")
+        {
+            THEN("each value round-trips")
+            {
+                CHECK(round_trips(create_test_val<std::array<int, 5>>()));
+                CHECK(round_trips(create_test_val<std::vector<bool>>()));
+                CHECK(round_trips(create_test_val<std::deque<std::vector<double>>>()));
+                CHECK(round_trips(create_test_val<std::list<Person>>()));
+                CHECK(round_trips(create_test_val<std::set<int>>()));
+                CHECK(round_trips(create_3d_vec(3, 4, 5)));
+                CHECK(round_trips(std::pair<int, std::string>{ 1, "one" }));
+                CHECK(round_trips(std::tuple<int, double, std::string>{ 1, 2.5, "three" }));
+                CHECK(round_trips(std::variant<int, std::string>{ "alt" }));
+                CHECK(round_trips(Shape{ Rect{ 3, 4 } }));
+                CHECK(round_trips(std::optional<int>{}));
+                CHECK(round_trips(std::u16string{ u"wide" }));
+                CHECK(round_trips(bytes(300, 0xABU)));
+                CHECK(round_trips(std::string(70000, 'z')));
+            }
+        }
+
+        GIVEN("a variant whose alternatives are tagged")
+        {
+            using msgpack_serializer = easy_serializer<msgpack_adapter>;
+            using reordered_t = std::variant<Rect, Circle>;
+
+            const auto serial = msgpack_serializer::quick_serialize(Shape{ Rect{ 3, 4 } });
+
+            THEN("it is written as the tag id and read back in any alternative order")
+            {
+                REQUIRE_GE(serial.size(), 2U);
+                CHECK_EQ(serial[0], 0x92U);
+                CHECK_EQ(serial[1], 0x07U);
+                CHECK(std::get<Rect>(msgpack_serializer::quick_deserialize<reordered_t>(serial))
+                    == Rect{ 3, 4 });
+                CHECK_THROWS_AS(
+                    msgpack_serializer::quick_deserialize<Shape>(bytes{ 0x92U, 0x05U, 0xC0U }),
+                    deserialization_error);
+            }
+        }
+
+        GIVEN("maps and multimaps")
+        {
+            const std::map<std::string, int> test_map{ { "a", 1 }, { "b", 2 } };
+            const std::multimap<int, std::string> test_multimap{ { 1, "a" }, { 1, "b" },
+                { 2, "c" } };
+
+            THEN("each value round-trips")
+            {
+                CHECK(round_trips(test_map));
+                CHECK(round_trips(test_multimap));
+            }
+        }
+
+        GIVEN("an object with more than 15 fields")
+        {
+            std::map<std::string, int> test_val{};
+
+            for (int i = 0; i < 20; ++i)
+            {
+                test_val.emplace(std::to_string(i), i);
+            }
+
+            THEN("the value round-trips")
+            {
+                CHECK(round_trips(test_val));
+            }
+        }
+    }
+
+    SCENARIO("fields are matched by key in any order")
+    {
+        GIVEN("a map with the fields of an Employee out of order and an unknown field")
+        {
+            bytes serial{ 0x85U };
+            put_str(serial, "roles");
+            serial.push_back(0x91U);
+            put_str(serial, "admin");
+            put_str(serial, "extra");
+            serial.insert(serial.end(), { 0x92U, 0xC0U, 0xC3U });
+            put_str(serial, "name");
+            put_str(serial, "Eve");
+            put_str(serial, "pet");
+            serial.push_back(0xC0U);
+            put_str(serial, "id");
+            serial.push_back(0x07U);
+
+            WHEN("an Employee is deserialized")
+            {
+                const auto val = easy_serializer<msgpack_adapter>::quick_deserialize<Employee>(
+                    serial);
+
+                THEN("each field is found")
+                {
+                    CHECK_EQ(val.id, 7);
+                    CHECK_EQ(val.name, "Eve");
+                    CHECK_FALSE(val.pet.has_value());
+                    CHECK_EQ(val.roles, std::vector<std::string>{ "admin" });
+                }
+            }
+        }
+    }
+
+    SCENARIO("views borrow from the input")
+    {
+        GIVEN("a serialized string and bytes")
+        {
+            const auto str_serial = easy_serializer<msgpack_adapter>::quick_serialize(
+                std::string{ "borrowed" });
+
+            const auto bin_serial = easy_serializer<msgpack_adapter>::quick_serialize(
+                bytes{ 0x01U, 0x02U });
+
+            WHEN("they are deserialized as views")
+            {
+                std::string_view str{};
+                view<std::uint8_t> bin{};
+                easy_serializer<msgpack_adapter>::quick_deserialize(str_serial, str);
+                easy_serializer<msgpack_adapter>::quick_deserialize(bin_serial, bin);
+
+                THEN("the views point into the input")
+                {
+                    CHECK_EQ(str, "borrowed");
+                    CHECK_EQ(static_cast<const void*>(str.data()),
+                        static_cast<const void*>(str_serial.data() + 1));
+
+                    REQUIRE_EQ(bin.size(), 2);
+                    CHECK_EQ(bin.data(), bin_serial.data() + 2);
+                }
+            }
+        }
+    }
+
+    SCENARIO("invalid input is rejected")
+    {
+        GIVEN("truncated input")
+        {
+            const bytes serial{ 0xCDU, 0x12U };
+
+            THEN("deserializing throws")
+            {
+                int val{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+            }
+
+            THEN("try_deserialize reports the end of the input")
+            {
+                int val{};
+                const auto result = easy_serializer<msgpack_adapter>::try_deserialize(serial, val);
+                CHECK_EQ(result.code, deserialization_errc::end_of_input);
+                CHECK_FALSE(result.message.empty());
+            }
+        }
+
+        GIVEN("input with trailing bytes")
+        {
+            const bytes serial{ 0x01U, 0x02U };
+
+            THEN("deserializing throws")
+            {
+                int val{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+            }
+        }
+
+        GIVEN("an array claiming more elements than the input holds")
+        {
+            const bytes serial{ 0xDDU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0x01U };
+
+            THEN("deserializing throws before allocating")
+            {
+                std::vector<int> val{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+                CHECK_EQ(val.capacity(), 0);
+            }
+        }
+
+        GIVEN("the reserved format byte")
+        {
+            const bytes serial{ 0xC1U };
+
+            THEN("deserializing throws")
+            {
+                std::optional<int> val{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+            }
+        }
+
+        GIVEN("a value of the wrong type")
+        {
+            const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(
+                std::string{ "text" });
+
+            THEN("deserializing throws")
+            {
+                int val{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+            }
+
+            THEN("the error names the expected and actual types")
+            {
+                int val{};
+                const auto result = easy_serializer<msgpack_adapter>::try_deserialize(serial, val);
+                CHECK_EQ(result.message, "MessagePack error: expected integer, got string");
+            }
+        }
+
+        GIVEN("an integer out of range of the target")
+        {
+            const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(300);
+
+            THEN("deserializing throws")
+            {
+                std::uint8_t val{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+            }
+        }
+
+        GIVEN("an object missing a field")
+        {
+            const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(Foo{ 1 });
+
+            THEN("deserializing throws")
+            {
+                Bar val{ 0 };
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+            }
+        }
+
+        GIVEN("an array of the wrong size for a std::array")
+        {
+            const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(
+                std::vector<int>{ 1, 2 });
+
+            THEN("deserializing throws")
+            {
+                std::array<int, 5> val{};
+                deserializer des{ serial };
+                CHECK_THROWS_AS(des.deserialize_object(val), deserialization_error);
+            }
+        }
+    }
+
+    SCENARIO("large arrays can be deserialized in parallel")
+    {
+        GIVEN("an adapter that cannot split its input")
+        {
+            const auto people = create_people(1001);
+            const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(people);
+
+            THEN("deserialize_parallel deserializes it on one thread")
+            {
+                std::vector<Person> test_val{};
+                deserialize_parallel<msgpack_adapter>(serial, test_val, parallel_options{ 4, 100 });
+                CHECK(test_val == people);
+            }
+        }
+    }
+
+    // The cases shared with the other adapters are in tests/adapters.test.cpp
+    SCENARIO("MessagePack-specific input can be read from streams")
+    {
+        GIVEN("an array of objects larger than the stream buffer")
+        {
+            const auto people = create_people(300);
+            const auto serial = easy_serializer<msgpack_adapter>::quick_serialize(people);
+            const stream_options options{ 64 };
+
+            WHEN("the first element is malformed")
+            {
+                // The 3-byte array16 head is followed by 0xC1, a format byte that is never used
+                auto text = std::string{ serial.begin(), serial.end() };
+                text[3] = '\xC1';
+                std::istringstream in{ text };
+                std::vector<Person> test_val{};
+
+                THEN("deserialization throws without reading the rest of the input")
+                {
+                    CHECK_THROWS_AS(deserialize_from<msgpack_adapter>(in, test_val, options),
+                        deserialization_error);
+                    CHECK_FALSE(in.eof());
+                }
+            }
+
+            WHEN("bytes follow the array")
+            {
+                auto text = std::string{ serial.begin(), serial.end() };
+                text.push_back('\x01');
+                std::istringstream in{ text };
+                std::vector<Person> test_val{};
+
+                THEN("deserialization throws")
+                {
+                    CHECK_THROWS_AS(deserialize_from<msgpack_adapter>(in, test_val, options),
+                        deserialization_error);
+                }
+            }
+        }
+    }
+}
+} //namespace extenser::tests
@@ -0,0 +1,53 @@
+// ExtenSer - An extensible, generic serialization library for C++
+//
+// Copyright (c) 2023 by Jackson Harmer
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Distributed under The 3-Clause BSD License
+// See accompanying file LICENSE or a copy at
+// https://opensource.org/license/bsd-3-clause/
+
+// Built with exceptions disabled, errors can only be reported through try_deserialize
+
+#include "extenser/cbor_adapter/extenser_cbor.hpp"
+#include "extenser/json_adapter/extenser_json_text.hpp"
+#include "extenser/msgpack_adapter/extenser_msgpack.hpp"
+#include "test_helpers.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_NO_EXCEPTIONS_BUT_WITH_ALL_ASSERTS
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include <doctest/doctest.h>
+
+#include <vector>
+
+namespace extenser::tests
+{
+TEST_SUITE("no exceptions")
+{
+    TEST_CASE_TEMPLATE("try_deserialize reports errors without exceptions", Adapter,
+        json_text_adapter, msgpack_adapter, cbor_adapter)
+    {
+        const auto people = create_people(3);
+        const auto serial = easy_serializer<Adapter>::quick_serialize(people);
+
+        SUBCASE("a well-formed value is read")
+        {
+            std::vector<Person> test_val{};
+            const auto result = easy_serializer<Adapter>::try_deserialize(serial, test_val);
+
+            CHECK(static_cast<bool>(result));
+            CHECK(test_val == people);
+        }
+
+        SUBCASE("a value of the wrong type is reported")
+        {
+            std::vector<int> test_val{};
+            const auto result = easy_serializer<Adapter>::try_deserialize(serial, test_val);
+
+            CHECK(result.code == deserialization_errc::type_mismatch);
+            CHECK(result.path == "/0");
+        }
+    }
+}
+} //namespace extenser::tests
@@ -24,8 +24,14 @@
 #include "extenser/containers/unordered_set.hpp"
 #include "extenser/containers/vector.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace extenser::tests
 {
@@ -189,6 +195,141 @@ private:
     Foo m_foo;
 };
 
+struct Employee
+{
+    int id{};
+    std::string name{};
+    std::optional<Pet> pet{};
+    std::vector<std::string> roles{};
+
+    EXTENSER_FIELDS("id", "name", "pet", "roles");
+
+    template<typename S>
+    void serialize(generic_serializer<S>& ser)
+    {
+        ser.as_int("id", id);
+        ser.as_string("name", name);
+        ser.as_optional("pet", pet);
+        ser.as_array("roles", roles);
+    }
+};
+
+inline bool operator==(const Employee& lhs, const Employee& rhs) noexcept
+{
+    return lhs.id == rhs.id && lhs.name == rhs.name && lhs.pet == rhs.pet
+        && lhs.roles == rhs.roles;
+}
+
+// Alternatives of Shape are written by their tag, so they may be reordered or added to
+struct Circle
+{
+    double radius{};
+
+    EXTENSER_VARIANT_TAG(1, "Circle");
+
+    template<typename S>
+    void serialize(generic_serializer<S>& ser)
+    {
+        ser.as_float("radius", radius);
+    }
+};
+
+inline bool operator==(const Circle& lhs, const Circle& rhs) noexcept
+{
+    return lhs.radius == rhs.radius;
+}
+
+struct Rect
+{
+    int width{};
+    int height{};
+
+    EXTENSER_VARIANT_TAG(7, "Rect");
+
+    template<typename S>
+    void serialize(generic_serializer<S>& ser)
+    {
+        ser.as_int("width", width);
+        ser.as_int("height", height);
+    }
+};
+
+inline bool operator==(const Rect& lhs, const Rect& rhs) noexcept
+{
+    return lhs.width == rhs.width && lhs.height == rhs.height;
+}
+
+using Shape = std::variant<Circle, Rect>;
+
+#if defined(EXTENSER_HAS_MEMORY_RESOURCE)
+// Allocator-aware, so a deserializer can build all of it in a caller's memory_resource
+struct Roster
+{
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    Roster() = default;
+
+    explicit Roster(const allocator_type& alloc)
+        : name(alloc), members(alloc), fruit_count(alloc)
+    {
+    }
+
+    std::pmr::string name{};
+    std::pmr::vector<std::pmr::string> members{};
+    std::pmr::unordered_map<Fruit, int> fruit_count{};
+
+    template<typename S>
+    void serialize(generic_serializer<S>& ser)
+    {
+        ser.as_string("name", name);
+        ser.as_array("members", members);
+        ser.as_map("fruit_count", fruit_count);
+    }
+};
+
+inline bool operator==(const Roster& lhs, const Roster& rhs) noexcept
+{
+    return lhs.name == rhs.name && lhs.members == rhs.members
+        && lhs.fruit_count == rhs.fruit_count;
+}
+
+// True if val and everything it owns was allocated from p_resource
+inline auto uses_resource(const Roster& val, const std::pmr::memory_resource* const p_resource)
+    -> bool
+{
+    return val.name.get_allocator().resource() == p_resource
+        && val.members.get_allocator().resource() == p_resource
+        && val.fruit_count.get_allocator().resource() == p_resource
+        && std::all_of(val.members.begin(), val.members.end(),
+            [p_resource](const std::pmr::string& member)
+            { return member.get_allocator().resource() == p_resource; });
+}
+#endif
+
+// count people, each with a friend, and a pet and fruit for every other one
+inline auto create_people(const std::size_t count) -> std::vector<Person>
+{
+    std::vector<Person> people;
+    people.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto age = static_cast<int>(i % 90);
+        Person person{ age, "Person #" + std::to_string(i), {}, std::nullopt, {} };
+
+        if (i % 2 == 0)
+        {
+            person.pet = Pet{ "Pet #" + std::to_string(i), Pet::Species::Cat };
+            person.fruit_count = { { Fruit::Apple, age } };
+        }
+
+        person.friends.push_back(Person{ age + 1, "Friend", {}, std::nullopt, {} });
+        people.push_back(std::move(person));
+    }
+
+    return people;
+}
+
 inline auto create_3d_vec(std::size_t x_sz, std::size_t y_sz, std::size_t z_sz)
 {
     std::vector<std::vector<std::vector<double>>> x;
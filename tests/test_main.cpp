@@ -8,6 +8,7 @@
 // https://opensource.org/license/bsd-3-clause/
 
 #include "extenser/extenser.hpp"
+#include "extenser/mapped_file.hpp"
 
 #include "extenser/json_adapter/extenser_json.hpp"
 #include "extenser/containers/array.hpp"
@@ -24,10 +25,16 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <numeric>
 #include <queue>
 #include <stack>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace
@@ -174,6 +181,220 @@ TEST_CASE("Vector")
     REQUIRE_EQ(nvec.at(4), 5);
 }
 
+TEST_CASE("Nested map")
+{
+    const std::map<std::string, std::map<int, double>> in_map{ { "a", { { 1, 1.5 }, { 2, 2.5 } } },
+        { "b", { { -3, 0.25 } } } };
+
+    easy_serializer<json_adapter> ser{};
+    ser.serialize_object(in_map);
+
+    REQUIRE(ser.object().at("a").is_object());
+
+    const auto out_map = ser.deserialize_object<std::map<std::string, std::map<int, double>>>();
+
+    CHECK_EQ(out_map, in_map);
+}
+
+TEST_CASE("Field table")
+{
+    static constexpr auto keys = extenser::make_field_keys("id", "name", "email", "address",
+        "phone", "created_at", "updated_at", "is_active", "roles", "manager_id");
+    static constexpr extenser::detail::field_table<keys.size()> table{ keys };
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        CHECK_EQ(table.find(keys[i]), i);
+    }
+
+    CHECK_EQ(table.find("nickname"), extenser::detail::field_table_view::npos);
+    CHECK_EQ(table.find(""), extenser::detail::field_table_view::npos);
+    static_assert(table.find("email") == 2);
+}
+
+namespace
+{
+constexpr std::size_t wide_key_count = 128;
+
+constexpr auto make_wide_names() noexcept
+{
+    std::array<std::array<char, 4>, wide_key_count> names{};
+
+    for (std::size_t i = 0; i < wide_key_count; ++i)
+    {
+        names[i] = { 'f', static_cast<char>('0' + (i / 100)),
+            static_cast<char>('0' + (i / 10 % 10)), static_cast<char>('0' + (i % 10)) };
+    }
+
+    return names;
+}
+
+constexpr auto wide_names = make_wide_names();
+
+constexpr auto make_wide_keys() noexcept
+{
+    std::array<std::string_view, wide_key_count> keys{};
+
+    for (std::size_t i = 0; i < wide_key_count; ++i)
+    {
+        keys[i] = std::string_view{ wide_names[i].data(), wide_names[i].size() };
+    }
+
+    return keys;
+}
+
+constexpr auto wide_keys = make_wide_keys();
+
+// Built within the compilers' default constexpr evaluation limits
+constexpr extenser::detail::field_table<wide_key_count> wide_table{ wide_keys };
+static_assert(wide_table.built());
+static_assert(wide_table.find("f000") == 0);
+static_assert(wide_table.find("f127") == 127);
+static_assert(wide_table.find("f128") == extenser::detail::field_table_view::npos);
+} //namespace
+
+TEST_CASE("Field table with many keys")
+{
+    for (std::size_t i = 0; i < wide_keys.size(); ++i)
+    {
+        CHECK_EQ(wide_table.find(wide_keys[i]), i);
+    }
+}
+
+TEST_CASE("Bulk copy")
+{
+    using containers::adapter;
+    using containers::is_bulk_copyable_v;
+
+    static_assert(is_bulk_copyable_v<std::vector<float>>);
+    static_assert(is_bulk_copyable_v<std::array<std::uint32_t, 4>>);
+    static_assert(is_bulk_copyable_v<int[3]>);
+    static_assert(!is_bulk_copyable_v<std::vector<bool>>);
+    static_assert(!is_bulk_copyable_v<std::vector<std::string>>);
+    static_assert(!is_bulk_copyable_v<std::deque<int>>);
+    static_assert(!is_bulk_copyable_v<std::map<int, int>>);
+
+    const std::vector<float> floats{ 1.0F, 2.5F, -3.0F };
+    const auto float_view = adapter<std::vector<float>>::bulk_view(floats);
+
+    REQUIRE_EQ(float_view.size(), floats.size());
+    CHECK_EQ(float_view.data(), floats.data());
+    CHECK(adapter<std::vector<float>>::bulk_view(std::vector<float>{}).empty());
+
+    std::vector<float> out_floats{ 9.0F };
+    adapter<std::vector<float>>::bulk_assign(out_floats, float_view.data(), float_view.size());
+    CHECK_EQ(out_floats, floats);
+
+    const std::array<std::uint32_t, 4> in_arr{ 7U, 0xFFFFFFFFU, 0U, 42U };
+    std::array<std::uint32_t, 4> out_arr{ 1U, 1U, 1U, 1U };
+    adapter<std::array<std::uint32_t, 4>>::bulk_assign(out_arr, in_arr.data(), in_arr.size());
+    CHECK_EQ(out_arr, in_arr);
+}
+
+namespace
+{
+template<std::size_t I>
+struct Tagged
+{
+    int value{};
+
+    template<typename S>
+    void serialize(S& ser)
+    {
+        ser.as_int("value", value);
+    }
+};
+
+template<std::size_t... Is>
+auto make_wide_variant(std::index_sequence<Is...>) -> std::variant<Tagged<Is>...>;
+
+using wide_variant = decltype(make_wide_variant(std::make_index_sequence<40>{}));
+} //namespace
+
+TEST_CASE("Variant index dispatch")
+{
+    for (std::size_t idx = 0; idx < std::variant_size_v<wide_variant>; ++idx)
+    {
+        const auto visited = detail::visit_index<wide_variant>(
+            idx, [](auto idx_constant) { return decltype(idx_constant)::value; });
+
+        CHECK_EQ(visited, idx);
+    }
+
+    const wide_variant in_val{ std::in_place_index<37>, Tagged<37>{ 1234 } };
+    const auto json = easy_serializer<json_adapter>::quick_serialize(in_val);
+
+    wide_variant out_val{};
+    easy_serializer<json_adapter>::quick_deserialize(json, out_val);
+
+    REQUIRE_EQ(out_val.index(), 37);
+    CHECK_EQ(std::get<37>(out_val).value, 1234);
+}
+
+#if defined(EXTENSER_STATS)
+namespace
+{
+std::size_t g_fake_allocs{};
+
+auto fake_alloc_probe() noexcept -> stats::alloc_totals
+{
+    return { g_fake_allocs, g_fake_allocs * 16 };
+}
+
+void count_calls(const call_stats& call, void* p_context) noexcept
+{
+    auto& calls = *static_cast<std::vector<call_stats>*>(p_context);
+    calls.push_back(call);
+}
+
+struct Team
+{
+    std::string name{};
+    std::vector<SimplePerson> members{};
+
+    template<typename S>
+    void serialize(generic_serializer<S>& ser)
+    {
+        ser.as_string("name", name);
+        ser.as_array("members", members);
+
+        // Stands in for allocations made while serializing
+        ++g_fake_allocs;
+    }
+};
+} //namespace
+
+TEST_CASE("Stats")
+{
+    const Team team{ "Platform", { { 30, "Ann" }, { 41, "Bob" } } };
+
+    std::vector<call_stats> calls{};
+    stats::set_alloc_probe(fake_alloc_probe);
+    stats::set_sink(count_calls, &calls);
+
+    easy_serializer<json_adapter> ser{};
+    ser.serialize_object(team);
+    std::ignore = ser.deserialize_object<Team>();
+
+    stats::set_sink(nullptr);
+    stats::set_alloc_probe(nullptr);
+
+    // One call each way, with nested objects counted as part of them
+    REQUIRE_EQ(calls.size(), 2);
+
+    for (const auto& call : calls)
+    {
+        // Team's two fields, then each member's two fields
+        CHECK_EQ(call.nodes_visited, 6);
+        CHECK_EQ(call.max_depth, 2);
+        CHECK_EQ(call.allocations, 1);
+        CHECK_EQ(call.bytes_allocated, 16);
+    }
+
+    CHECK_EQ(stats::last_call().nodes_visited, calls.back().nodes_visited);
+}
+#endif
+
 TEST_CASE("View")
 {
     std::vector<int> dyn_arr(100);
@@ -195,6 +416,44 @@ TEST_CASE("View")
     REQUIRE_EQ(dyn_arr[99], 0);
 }
 
+TEST_CASE("Mapped file")
+{
+    const auto path =
+        (std::filesystem::temp_directory_path() / "extenser_mapped_file.txt").string();
+    const std::string contents = R"({"name":"Mary","age":40})";
+
+    {
+        std::ofstream out{ path, std::ios::binary };
+        out << contents;
+    }
+
+    mapped_file file{ path };
+    REQUIRE_EQ(file.size(), contents.size());
+    CHECK_EQ(file.text(), contents);
+    CHECK_EQ(file.bytes().size(), contents.size());
+    CHECK_EQ(file.bytes()[0], static_cast<std::uint8_t>('{'));
+
+    // Moving hands over the mapping
+    mapped_file moved{ std::move(file) };
+    CHECK_EQ(moved.text(), contents);
+    CHECK_EQ(file.data(), nullptr);
+
+    // The mapping outlives the file's directory entry
+    std::filesystem::remove(path);
+    CHECK_EQ(moved.text(), contents);
+
+    {
+        std::ofstream out{ path, std::ios::binary };
+    }
+
+    const mapped_file empty{ path };
+    CHECK_EQ(empty.size(), 0);
+    CHECK(empty.bytes().empty());
+    std::filesystem::remove(path);
+
+    CHECK_THROWS_AS(mapped_file{ path }, deserialization_error);
+}
+
 TEST_CASE("Simple JSON serialize/deserialize")
 {
     const SimplePerson in_person{ 42, "Jake" };